@@ -0,0 +1,16 @@
+#include "CaptureFile.h"
+
+const quint32 CaptureFile::MAGIC_NUMBER = 0x20140301;
+const quint32 CaptureFile::FORMAT_VERSION = 1;
+
+// magic number, version
+const int CaptureFile::FILE_HEADER_SIZE = 4 + 4;
+
+// size, kind
+const int CaptureFile::RECORD_HEADER_SIZE = 4 + 4;
+
+// record header, channel, operator, input, name length
+const int CaptureFile::CHANNEL_RECORD_SIZE = CaptureFile::RECORD_HEADER_SIZE + 4 + 4 + 4 + 4;
+
+// record header, channel, sequence, timestamp, data kind, element type, rows, columns, row size
+const int CaptureFile::FRAME_RECORD_SIZE = CaptureFile::RECORD_HEADER_SIZE + 4 + 8 + 8 + 4 + 4 + 4 + 4 + 4;
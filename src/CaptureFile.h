@@ -0,0 +1,85 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAPTUREFILE_H
+#define CAPTUREFILE_H
+
+#include <QtGlobal>
+
+/**
+ * \brief Layout of capture files
+ * 
+ * A capture file stores the data which was observed at operator inputs. It starts
+ * with a header which consists of the magic number and the format version (each a 
+ * 32-bit unsigned integer). The header is followed by a sequence of records. Each
+ * record starts with its total size in bytes and its kind (both 32-bit unsigned
+ * integers).
+ * 
+ * A channel record defines a captured operator input. It contains the channel ID,
+ * the ID of the operator in the stream, the ID of the operator input, the length
+ * of the channel name and the UTF-8 encoded name of the channel.
+ * 
+ * A frame record contains one observed data object. It contains the channel ID,
+ * the sequence number of the data at its input, the time of the observation in
+ * microseconds after the start of the capture, the data kind (image or matrix),
+ * the pixel type of an image or the value type of a matrix, the number of rows
+ * and columns, the number of bytes per row and the rows of the data without any
+ * padding.
+ * 
+ * All numbers are stored in little endian byte order. A file which ends with an
+ * incomplete record (e.g. because the application crashed during the capture) can
+ * be read up to the last complete record.
+ */
+class CaptureFile
+{
+public:
+    /** The kinds of records in a capture file. */
+    enum RecordKind
+    {
+        CHANNEL_RECORD = 1,
+        FRAME_RECORD = 2
+    };
+    
+    /** The kinds of data stored in frame records. */
+    enum DataKind
+    {
+        IMAGE_DATA = 1,
+        MATRIX_DATA = 2
+    };
+    
+    /** Magic number which identifies the first 4 bytes of capture files. */
+    static const quint32 MAGIC_NUMBER;
+    
+    /** The version of the capture file format. */
+    static const quint32 FORMAT_VERSION;
+    
+    /** Size of the file header in bytes. */
+    static const int FILE_HEADER_SIZE;
+    
+    /** Size of the size and kind fields at the start of each record. */
+    static const int RECORD_HEADER_SIZE;
+    
+    /** Size of a channel record without its name. */
+    static const int CHANNEL_RECORD_SIZE;
+    
+    /** Size of a frame record without its data. */
+    static const int FRAME_RECORD_SIZE;
+};
+
+#endif // CAPTUREFILE_H
@@ -0,0 +1,132 @@
+#include "CapturePlayer.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <stromx/runtime/DataContainer.h>
+#include <stromx/runtime/Exception.h>
+#include <stromx/runtime/Operator.h>
+#include <stromx/runtime/ReadAccess.h>
+#include <stromx/runtime/Timeout.h>
+
+#include "event/ConnectorDataEvent.h"
+#include "model/OperatorModel.h"
+#include "model/StreamModel.h"
+
+const int CapturePlayer::MIN_OBSERVER_INTERVAL = 10;
+const int CapturePlayer::STOP_POLL_INTERVAL = 100;
+
+CapturePlayer::CapturePlayer(const QString& fileName, StreamModel* stream, QObject* parent)
+  : QThread(parent),
+    m_reader(fileName),
+    m_target(OBSERVERS),
+    m_maximalRate(false),
+    m_stop(false)
+{
+    m_reader.open();
+
+    // find the operators of the channels in the current stream
+    QMap<quint32, CaptureReader::Channel>::const_iterator iter;
+    for(iter = m_reader.channels().begin(); iter != m_reader.channels().end(); ++iter)
+    {
+        foreach(OperatorModel* op, stream->operators())
+        {
+            if(stream->operatorId(op) == int(iter.value().operatorId))
+            {
+                Destination destination;
+                destination.op = op;
+                destination.inputId = iter.value().inputId;
+                m_destinations[iter.key()] = destination;
+                break;
+            }
+        }
+    }
+}
+
+CapturePlayer::~CapturePlayer()
+{
+    stop();
+    wait();
+}
+
+void CapturePlayer::stop()
+{
+    m_stop = true;
+}
+
+void CapturePlayer::run()
+{
+    m_stop = false;
+
+    QElapsedTimer clock;
+    clock.start();
+    qint64 lastReplay = -MIN_OBSERVER_INTERVAL;
+
+    for(int i = 0; i < m_reader.numFrames() && ! m_stop; ++i)
+    {
+        QHash<quint32, Destination>::const_iterator destination = m_destinations.constFind(m_reader.channel(i));
+        if(destination == m_destinations.constEnd())
+            continue;
+
+        // wait until the frame is due
+        qint64 delay = 0;
+        if(! m_maximalRate)
+            delay = (m_reader.timestamp(i) - m_reader.timestamp(0)) / 1000 - clock.elapsed();
+        if(m_target == OBSERVERS)
+            delay = qMax(delay, lastReplay + MIN_OBSERVER_INTERVAL - clock.elapsed());
+
+        // sleep in short intervals to react if the player is stopped
+        while(delay > 0 && ! m_stop)
+        {
+            msleep(qMin(delay, qint64(STOP_POLL_INTERVAL)));
+            delay -= STOP_POLL_INTERVAL;
+        }
+
+        if(m_stop)
+            break;
+
+        stromx::runtime::Data* data = m_reader.createData(i);
+        stromx::runtime::DataContainer container(data);
+
+        if(m_target == OBSERVERS)
+        {
+            // pass the data to the operator model as if it had been observed
+            stromx::runtime::ReadAccess access(container);
+            ConnectorDataEvent* event = new ConnectorDataEvent(OperatorModel::INPUT, destination.value().inputId,
+                                                               access, m_reader.sequence(i));
+            QCoreApplication::postEvent(destination.value().op, event);
+        }
+        else
+        {
+            bool isSet = false;
+            try
+            {
+                // wait until the input is free but do not block the thread
+                // if the player is stopped in the meantime
+                while(! isSet && ! m_stop)
+                {
+                    try
+                    {
+                        destination.value().op->op()->setInputData(destination.value().inputId,
+                                                                   container, STOP_POLL_INTERVAL);
+                        isSet = true;
+                    }
+                    catch(stromx::runtime::Timeout &)
+                    {
+                    }
+                }
+            }
+            catch(stromx::runtime::Exception & e)
+            {
+                emit replayFailed(QString::fromStdString(e.what()));
+                break;
+            }
+
+            if(! isSet)
+                break;
+        }
+
+        lastReplay = clock.elapsed();
+        emit frameReplayed(i);
+    }
+}
@@ -0,0 +1,131 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAPTUREPLAYER_H
+#define CAPTUREPLAYER_H
+
+#include <QHash>
+#include <QThread>
+
+#include "CaptureReader.h"
+
+class OperatorModel;
+class StreamModel;
+
+/**
+ * \brief Replays capture files
+ * 
+ * The capture player reads the frames of a capture file and passes them to
+ * the operator inputs they were captured at. The operators are identified by
+ * their IDs in the stream. Depending on the target of the player the frames
+ * are either displayed by the observers of the inputs (the operators are not
+ * executed) or set as input data of the operators of the running stream. In the
+ * latter case the captured inputs must not be connected.
+ * 
+ * The frames are replayed in a separate thread either at the rate at which they
+ * were captured or as fast as possible.
+ */
+class CapturePlayer : public QThread
+{
+    Q_OBJECT
+    
+public:
+    /** The destination of the replayed frames. */
+    enum Target
+    {
+        /** The frames are passed to the observers of the captured inputs. */
+        OBSERVERS,
+        
+        /** The frames are set as input data of the operators. */
+        OPERATORS
+    };
+    
+    /** 
+     * The minimal interval between two frames in milliseconds if they are
+     * replayed to observers. This prevents the player from flooding the event
+     * loop of the application.
+     */
+    static const int MIN_OBSERVER_INTERVAL;
+    
+    /** 
+     * The interval in milliseconds at which the player thread checks if it
+     * has been stopped while it waits for a frame to be due or for an input
+     * of an operator to become free.
+     */
+    static const int STOP_POLL_INTERVAL;
+    
+    /** 
+     * Opens the capture file \c fileName and assigns its channels to the operators
+     * of \c stream.
+     * 
+     * \throws ReadCaptureFailed
+     */
+    CapturePlayer(const QString & fileName, StreamModel* stream, QObject* parent = 0);
+    
+    /** Stops the player and waits for the player thread to finish. */
+    virtual ~CapturePlayer();
+    
+    /** Returns the number of frames in the capture file. */
+    int numFrames() const { return m_reader.numFrames(); }
+    
+    /** Returns the number of channels which were not found in the stream. */
+    int numMissingChannels() const { return m_reader.channels().count() - m_destinations.count(); }
+    
+    /** Sets the destination of the replayed frames. */
+    void setTarget(Target target) { m_target = target; }
+    
+    /** 
+     * Replays the frames as fast as possible if \c maximalRate is true. Otherwise
+     * the frames are replayed at the rate they were captured.
+     */
+    void setMaximalRate(bool maximalRate) { m_maximalRate = maximalRate; }
+    
+public slots:
+    /** 
+     * Stops replaying before the next frame. If the player waits for the
+     * input of an operator to become free it stops waiting within
+     * STOP_POLL_INTERVAL milliseconds.
+     */
+    void stop();
+    
+signals:
+    /** The frame \c frame was replayed. */
+    void frameReplayed(int frame);
+    
+    /** Setting the data of an operator failed with \c message. */
+    void replayFailed(const QString & message);
+    
+protected:
+    virtual void run();
+    
+private:
+    struct Destination
+    {
+        OperatorModel* op;
+        unsigned int inputId;
+    };
+    
+    CaptureReader m_reader;
+    QHash<quint32, Destination> m_destinations;
+    Target m_target;
+    bool m_maximalRate;
+    volatile bool m_stop;
+};
+
+#endif // CAPTUREPLAYER_H
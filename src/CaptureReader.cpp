@@ -0,0 +1,147 @@
+#include "CaptureReader.h"
+
+#include <QImage>
+#include <QObject>
+#include <QtEndian>
+
+#include "CaptureFile.h"
+#include "Exception.h"
+#include "Image.h"
+#include "Matrix.h"
+
+CaptureReader::CaptureReader(const QString& fileName)
+  : m_file(fileName),
+    m_map(0),
+    m_size(0)
+{
+}
+
+CaptureReader::~CaptureReader()
+{
+    if(m_map)
+        m_file.unmap(m_map);
+}
+
+void CaptureReader::open()
+{
+    if(! m_file.open(QIODevice::ReadOnly))
+        throw ReadCaptureFailed(m_file.errorString());
+
+    m_size = m_file.size();
+    if(m_size < CaptureFile::FILE_HEADER_SIZE)
+        throw ReadCaptureFailed(QObject::tr("The file is not a capture file."));
+
+    m_map = m_file.map(0, m_size);
+    if(! m_map)
+        throw ReadCaptureFailed(m_file.errorString());
+
+    if(qFromLittleEndian<quint32>(m_map) != CaptureFile::MAGIC_NUMBER)
+        throw ReadCaptureFailed(QObject::tr("The file is not a capture file."));
+
+    if(qFromLittleEndian<quint32>(m_map + 4) > CaptureFile::FORMAT_VERSION)
+        throw ReadCaptureFailed(QObject::tr("The capture file was written by a newer version of stromx-studio."));
+
+    qint64 offset = CaptureFile::FILE_HEADER_SIZE;
+    while(offset + CaptureFile::RECORD_HEADER_SIZE <= m_size)
+    {
+        const uchar* record = m_map + offset;
+        quint32 size = qFromLittleEndian<quint32>(record);
+        quint32 kind = qFromLittleEndian<quint32>(record + 4);
+
+        // stop at incomplete records
+        if(size < quint32(CaptureFile::RECORD_HEADER_SIZE) || offset + size > m_size)
+            break;
+
+        if(kind == CaptureFile::CHANNEL_RECORD && size >= quint32(CaptureFile::CHANNEL_RECORD_SIZE))
+        {
+            quint32 nameSize = qFromLittleEndian<quint32>(record + 20);
+            if(CaptureFile::CHANNEL_RECORD_SIZE + nameSize > size)
+                break;
+
+            Channel channel;
+            channel.operatorId = qFromLittleEndian<quint32>(record + 12);
+            channel.inputId = qFromLittleEndian<quint32>(record + 16);
+            channel.name = QString::fromUtf8(reinterpret_cast<const char*>(record) + CaptureFile::CHANNEL_RECORD_SIZE,
+                                             nameSize);
+            m_channels[qFromLittleEndian<quint32>(record + 8)] = channel;
+        }
+        else if(kind == CaptureFile::FRAME_RECORD && size >= quint32(CaptureFile::FRAME_RECORD_SIZE))
+        {
+            quint32 rows = qFromLittleEndian<quint32>(record + 36);
+            quint32 rowSize = qFromLittleEndian<quint32>(record + 44);
+            if(CaptureFile::FRAME_RECORD_SIZE + qint64(rows) * rowSize > size)
+                break;
+
+            Frame frame;
+            frame.channel = qFromLittleEndian<quint32>(record + 8);
+            frame.sequence = qFromLittleEndian<quint64>(record + 12);
+            frame.timestamp = qFromLittleEndian<qint64>(record + 20);
+            frame.offset = offset;
+            m_frames.append(frame);
+        }
+
+        // unknown records are skipped
+        offset += size;
+    }
+}
+
+stromx::runtime::Data* CaptureReader::createData(int frame) const
+{
+    const uchar* record = m_map + m_frames[frame].offset;
+    quint32 dataKind = qFromLittleEndian<quint32>(record + 28);
+    quint32 elementType = qFromLittleEndian<quint32>(record + 32);
+    quint32 rows = qFromLittleEndian<quint32>(record + 36);
+    quint32 cols = qFromLittleEndian<quint32>(record + 40);
+    quint32 rowSize = qFromLittleEndian<quint32>(record + 44);
+    const uchar* src = record + CaptureFile::FRAME_RECORD_SIZE;
+
+    if(dataKind == CaptureFile::IMAGE_DATA)
+    {
+        QImage image;
+        switch(elementType)
+        {
+        case stromx::runtime::Image::MONO_8:
+        {
+            image = QImage(cols, rows, QImage::Format_Indexed8);
+            QVector<QRgb> colorTable;
+            for(int i = 0; i < 256; ++i)
+                colorTable.append(qRgb(i, i, i));
+            image.setColorTable(colorTable);
+            break;
+        }
+        case stromx::runtime::Image::RGB_24:
+        case stromx::runtime::Image::BGR_24:
+            image = QImage(cols, rows, QImage::Format_RGB888);
+            break;
+        default:
+            break;
+        }
+
+        if(! image.isNull())
+        {
+            for(quint32 i = 0; i < rows; ++i)
+                memcpy(image.scanLine(i), src + i * rowSize, rowSize);
+
+            if(elementType == stromx::runtime::Image::BGR_24)
+                image = image.rgbSwapped();
+
+            // the image wrapper accepts color images only in 32-bit formats
+            if(image.format() == QImage::Format_RGB888)
+                image = image.convertToFormat(QImage::Format_RGB32);
+
+            return new Image(image);
+        }
+
+        // images with other pixel types are returned as byte matrices
+        Matrix* matrix = new Matrix(rows, rowSize, stromx::runtime::Matrix::UINT_8);
+        for(quint32 i = 0; i < rows; ++i)
+            memcpy(matrix->data() + i * matrix->stride(), src + i * rowSize, rowSize);
+        return matrix;
+    }
+
+    Matrix* matrix = new Matrix(rows, cols, static_cast<stromx::runtime::Matrix::ValueType>(elementType));
+    unsigned int copySize = qMin(rowSize, cols * matrix->valueSize());
+    for(quint32 i = 0; i < rows; ++i)
+        memcpy(matrix->data() + i * matrix->stride(), src + i * rowSize, copySize);
+    return matrix;
+}
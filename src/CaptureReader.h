@@ -0,0 +1,114 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAPTUREREADER_H
+#define CAPTUREREADER_H
+
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Data;
+    }
+}
+
+/**
+ * \brief Reader of capture files
+ * 
+ * The capture reader maps a capture file as described in CaptureFile into memory
+ * and indexes its records. The data of the captured frames is only copied when it
+ * is requested by createData().
+ */
+class CaptureReader
+{
+public:
+    /** An operator input which was captured. */
+    struct Channel
+    {
+        Channel() : operatorId(0), inputId(0) {}
+        
+        unsigned int operatorId;
+        unsigned int inputId;
+        QString name;
+    };
+    
+    /** Constructs a reader for the file \c fileName. */
+    explicit CaptureReader(const QString & fileName);
+    
+    /** Closes the file. */
+    ~CaptureReader();
+    
+    /** 
+     * Maps the file into memory and reads the channels and the positions of 
+     * all frames. Reading stops at the first incomplete record.
+     * 
+     * \throws ReadCaptureFailed
+     */
+    void open();
+    
+    /** Returns the channels of the file indexed by their IDs. */
+    const QMap<quint32, Channel> & channels() const { return m_channels; }
+    
+    /** Returns the number of frames in the file. */
+    int numFrames() const { return m_frames.count(); }
+    
+    /** Returns the channel ID of \c frame. */
+    quint32 channel(int frame) const { return m_frames[frame].channel; }
+    
+    /** Returns the sequence number of \c frame at its input. */
+    quint64 sequence(int frame) const { return m_frames[frame].sequence; }
+    
+    /** 
+     * Returns the time of the observation of \c frame in microseconds after
+     * the start of the capture.
+     */
+    qint64 timestamp(int frame) const { return m_frames[frame].timestamp; }
+    
+    /** 
+     * Allocates a data object which contains the data of \c frame. The caller
+     * takes ownership of the data. Images with 8-bit gray or RGB pixels are
+     * returned as Image objects, all other data as Matrix objects.
+     */
+    stromx::runtime::Data* createData(int frame) const;
+    
+private:
+    struct Frame
+    {
+        quint32 channel;
+        quint64 sequence;
+        qint64 timestamp;
+        qint64 offset;
+    };
+    
+    CaptureReader(const CaptureReader &);
+    CaptureReader & operator=(const CaptureReader &);
+    
+    QFile m_file;
+    uchar* m_map;
+    qint64 m_size;
+    QMap<quint32, Channel> m_channels;
+    QList<Frame> m_frames;
+};
+
+#endif // CAPTUREREADER_H
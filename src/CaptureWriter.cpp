@@ -0,0 +1,316 @@
+#include "CaptureWriter.h"
+
+#include <QtEndian>
+
+#include <stromx/runtime/Image.h>
+#include <stromx/runtime/Matrix.h>
+#include <stromx/runtime/Variant.h>
+
+#include "CaptureFile.h"
+#include "Exception.h"
+
+const qint64 CaptureWriter::CHUNK_SIZE = 64 * 1024 * 1024;
+const int CaptureWriter::MAX_PENDING_FRAMES = 16;
+
+CaptureWriter::CaptureWriter(const QString& fileName, QObject* parent)
+  : QThread(parent),
+    m_file(fileName),
+    m_map(0),
+    m_mapOffset(0),
+    m_mapSize(0),
+    m_size(0),
+    m_numPendingFrames(0),
+    m_stop(true),
+    m_numChannels(0),
+    m_numWrittenFrames(0),
+    m_numDroppedFrames(0)
+{
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    close();
+}
+
+void CaptureWriter::open()
+{
+    if(! m_file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+        throw WriteCaptureFailed(m_file.errorString());
+
+    uchar header[CaptureFile::FILE_HEADER_SIZE];
+    qToLittleEndian<quint32>(CaptureFile::MAGIC_NUMBER, header);
+    qToLittleEndian<quint32>(CaptureFile::FORMAT_VERSION, header + 4);
+    if(m_file.write(reinterpret_cast<const char*>(header), CaptureFile::FILE_HEADER_SIZE)
+        != CaptureFile::FILE_HEADER_SIZE)
+    {
+        QString error = m_file.errorString();
+        m_file.close();
+        throw WriteCaptureFailed(error);
+    }
+    m_file.flush();
+    m_size = CaptureFile::FILE_HEADER_SIZE;
+
+    m_stop = false;
+    m_clock.start();
+    start();
+}
+
+void CaptureWriter::close()
+{
+    if(! m_file.isOpen())
+        return;
+
+    {
+        QMutexLocker lock(&m_mutex);
+        m_stop = true;
+        m_condition.wakeOne();
+    }
+    wait();
+
+    // cut off the unused part of the last chunk
+    unmap();
+    m_file.resize(m_size);
+    m_file.close();
+}
+
+quint32 CaptureWriter::addChannel(unsigned int operatorId, unsigned int inputId, const QString& name)
+{
+    QMutexLocker lock(&m_mutex);
+
+    Record record = Record(stromx::runtime::ReadAccess());
+    record.kind = CaptureFile::CHANNEL_RECORD;
+    record.channel = m_numChannels++;
+    record.operatorId = operatorId;
+    record.inputId = inputId;
+    record.name = name.toUtf8();
+
+    m_queue.append(record);
+    m_condition.wakeOne();
+
+    return record.channel;
+}
+
+void CaptureWriter::write(quint32 channel, quint64 sequence, const stromx::runtime::ReadAccess& access)
+{
+    QMutexLocker lock(&m_mutex);
+
+    if(m_stop || m_numPendingFrames >= MAX_PENDING_FRAMES)
+    {
+        m_numDroppedFrames++;
+        return;
+    }
+
+    Record record(access);
+    record.kind = CaptureFile::FRAME_RECORD;
+    record.channel = channel;
+    record.sequence = sequence;
+    record.timestamp = m_clock.nsecsElapsed() / 1000;
+
+    m_queue.append(record);
+    m_numPendingFrames++;
+    m_condition.wakeOne();
+}
+
+quint64 CaptureWriter::numWrittenFrames() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_numWrittenFrames;
+}
+
+bool CaptureWriter::isQueueFull() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_stop || m_numPendingFrames >= MAX_PENDING_FRAMES;
+}
+
+void CaptureWriter::dropFrame()
+{
+    QMutexLocker lock(&m_mutex);
+    m_numDroppedFrames++;
+}
+
+quint64 CaptureWriter::numDroppedFrames() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_numDroppedFrames;
+}
+
+QString CaptureWriter::errorString() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_errorString;
+}
+
+void CaptureWriter::run()
+{
+    forever
+    {
+        QList<Record> records;
+
+        // take all pending records from the queue
+        {
+            QMutexLocker lock(&m_mutex);
+            while(m_queue.isEmpty() && ! m_stop)
+                m_condition.wait(&m_mutex);
+
+            if(m_queue.isEmpty())
+                break;
+
+            records = m_queue;
+            m_queue.clear();
+            m_numPendingFrames = 0;
+        }
+
+        // write them without holding the lock
+        int numWrittenFrames = 0;
+        bool success = true;
+        foreach(const Record & record, records)
+        {
+            if(record.kind == CaptureFile::CHANNEL_RECORD)
+            {
+                success = writeChannel(record);
+            }
+            else
+            {
+                success = writeFrame(record);
+                if(success)
+                    numWrittenFrames++;
+            }
+
+            if(! success)
+                break;
+        }
+
+        QMutexLocker lock(&m_mutex);
+        m_numWrittenFrames += numWrittenFrames;
+        if(! success)
+        {
+            // stop accepting data after an error
+            m_errorString = m_file.errorString();
+            m_stop = true;
+            m_queue.clear();
+            break;
+        }
+    }
+}
+
+bool CaptureWriter::writeChannel(const Record& record)
+{
+    qint64 size = CaptureFile::CHANNEL_RECORD_SIZE + record.name.size();
+    uchar* dest = reserve(size);
+    if(! dest)
+        return false;
+
+    qToLittleEndian<quint32>(size, dest);
+    qToLittleEndian<quint32>(CaptureFile::CHANNEL_RECORD, dest + 4);
+    qToLittleEndian<quint32>(record.channel, dest + 8);
+    qToLittleEndian<quint32>(record.operatorId, dest + 12);
+    qToLittleEndian<quint32>(record.inputId, dest + 16);
+    qToLittleEndian<quint32>(record.name.size(), dest + 20);
+    memcpy(dest + CaptureFile::CHANNEL_RECORD_SIZE, record.name.constData(), record.name.size());
+
+    m_size += size;
+    return true;
+}
+
+bool CaptureWriter::writeFrame(const Record& record)
+{
+    const stromx::runtime::Data & data = record.access.get();
+
+    quint32 dataKind = 0;
+    quint32 elementType = 0;
+    quint32 rows = 0;
+    quint32 cols = 0;
+    quint32 rowSize = 0;
+    unsigned int stride = 0;
+    const uint8_t* src = 0;
+
+    if(data.isVariant(stromx::runtime::Variant::IMAGE))
+    {
+        const stromx::runtime::Image & image = stromx::runtime::data_cast<stromx::runtime::Image>(data);
+        dataKind = CaptureFile::IMAGE_DATA;
+        elementType = image.pixelType();
+        rows = image.height();
+        cols = image.width();
+        rowSize = image.width() * image.pixelSize();
+        stride = image.stride();
+        src = image.data();
+    }
+    else if(data.isVariant(stromx::runtime::Variant::MATRIX))
+    {
+        const stromx::runtime::Matrix & matrix = stromx::runtime::data_cast<stromx::runtime::Matrix>(data);
+        dataKind = CaptureFile::MATRIX_DATA;
+        elementType = matrix.valueType();
+        rows = matrix.rows();
+        cols = matrix.cols();
+        rowSize = matrix.cols() * matrix.valueSize();
+        stride = matrix.stride();
+        src = matrix.data();
+    }
+    else
+    {
+        // other data types are not captured
+        return true;
+    }
+
+    qint64 size = CaptureFile::FRAME_RECORD_SIZE + qint64(rows) * rowSize;
+    uchar* dest = reserve(size);
+    if(! dest)
+        return false;
+
+    qToLittleEndian<quint32>(size, dest);
+    qToLittleEndian<quint32>(CaptureFile::FRAME_RECORD, dest + 4);
+    qToLittleEndian<quint32>(record.channel, dest + 8);
+    qToLittleEndian<quint64>(record.sequence, dest + 12);
+    qToLittleEndian<qint64>(record.timestamp, dest + 20);
+    qToLittleEndian<quint32>(dataKind, dest + 28);
+    qToLittleEndian<quint32>(elementType, dest + 32);
+    qToLittleEndian<quint32>(rows, dest + 36);
+    qToLittleEndian<quint32>(cols, dest + 40);
+    qToLittleEndian<quint32>(rowSize, dest + 44);
+
+    // copy the rows without padding
+    uchar* destRow = dest + CaptureFile::FRAME_RECORD_SIZE;
+    for(quint32 i = 0; i < rows; ++i)
+    {
+        memcpy(destRow, src + i * stride, rowSize);
+        destRow += rowSize;
+    }
+
+    m_size += size;
+    return true;
+}
+
+uchar* CaptureWriter::reserve(qint64 size)
+{
+    // use the current chunk if the data fits
+    if(m_map && m_size + size <= m_mapOffset + m_mapSize)
+        return m_map + (m_size - m_mapOffset);
+
+    // otherwise map a new chunk at the end of the file
+    unmap();
+
+    qint64 chunkSize = qMax(CHUNK_SIZE, size);
+    if(! m_file.resize(m_size + chunkSize))
+        return 0;
+
+    m_map = m_file.map(m_size, chunkSize);
+    if(! m_map)
+        return 0;
+
+    m_mapOffset = m_size;
+    m_mapSize = chunkSize;
+
+    return m_map;
+}
+
+void CaptureWriter::unmap()
+{
+    if(m_map)
+    {
+        m_file.unmap(m_map);
+        m_map = 0;
+        m_mapOffset = 0;
+        m_mapSize = 0;
+    }
+}
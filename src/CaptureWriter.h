@@ -0,0 +1,161 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAPTUREWRITER_H
+#define CAPTUREWRITER_H
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <stromx/runtime/ReadAccess.h>
+
+/**
+ * \brief Writer of capture files
+ * 
+ * The capture writer appends the data observed at operator inputs to a capture
+ * file as described in CaptureFile. The data is passed to the writer by the
+ * connector observers of the operators and is queued. A dedicated thread writes
+ * the queued data in batches to the file which is memory-mapped in chunks of
+ * CHUNK_SIZE bytes. 
+ * 
+ * The queued data is held by read accesses until it has been written. To avoid
+ * blocking the stream the writer queues at most MAX_PENDING_FRAMES data objects.
+ * Any further data is dropped until the queue has been processed.
+ */
+class CaptureWriter : public QThread
+{
+public:
+    /** The size of the memory-mapped chunks of the file. */
+    static const qint64 CHUNK_SIZE;
+    
+    /** The maximal number of data objects which are waiting to be written. */
+    static const int MAX_PENDING_FRAMES;
+    
+    /** Constructs a writer for the file \c fileName. */
+    explicit CaptureWriter(const QString & fileName, QObject* parent = 0);
+    
+    /** Closes the file. */
+    virtual ~CaptureWriter();
+    
+    /** 
+     * Creates the file, writes the file header and starts the writer thread.
+     * 
+     * \throws WriteCaptureFailed
+     */
+    void open();
+    
+    /** 
+     * Writes all pending data, stops the writer thread and closes the file.
+     * Does nothing if the file is not open.
+     */
+    void close();
+    
+    /** 
+     * Adds a channel for the input \c inputId of the operator with the ID
+     * \c operatorId and returns its ID. The channel ID must be passed to write().
+     */
+    quint32 addChannel(unsigned int operatorId, unsigned int inputId, const QString & name);
+    
+    /** 
+     * Queues the data of \c access for writing. Images and matrices are written
+     * to the file, any other data is ignored. This function is thread-safe.
+     */
+    void write(quint32 channel, quint64 sequence, const stromx::runtime::ReadAccess & access);
+    
+    /** 
+     * Returns true if MAX_PENDING_FRAMES data objects are waiting to be written
+     * or the writer has been stopped. In this case any data passed to write() is
+     * dropped and a read access to it is not required. This function is thread-safe.
+     */
+    bool isQueueFull() const;
+    
+    /** Counts a data object which was dropped without passing it to write(). */
+    void dropFrame();
+    
+    /** Returns the number of data objects which have been written. */
+    quint64 numWrittenFrames() const;
+    
+    /** Returns the number of data objects which were dropped. */
+    quint64 numDroppedFrames() const;
+    
+    /** Returns a description of the last error or an empty string. */
+    QString errorString() const;
+    
+protected:
+    virtual void run();
+    
+private:
+    struct Record
+    {
+        Record(const stromx::runtime::ReadAccess & recordAccess)
+          : kind(0), channel(0), sequence(0), timestamp(0), 
+            operatorId(0), inputId(0), access(recordAccess) 
+        {}
+        
+        quint32 kind;
+        quint32 channel;
+        quint64 sequence;
+        qint64 timestamp;
+        quint32 operatorId;
+        quint32 inputId;
+        QByteArray name;
+        stromx::runtime::ReadAccess access;
+    };
+    
+    /** Writes a channel record to the file. Returns false if an error occurred. */
+    bool writeChannel(const Record & record);
+    
+    /** 
+     * Writes a frame record to the file. Returns false if an error occurred.
+     * Data which is neither an image nor a matrix is skipped.
+     */
+    bool writeFrame(const Record & record);
+    
+    /** 
+     * Returns a pointer to \c size bytes of mapped memory at the end of the
+     * file. Returns 0 if the file could not be mapped.
+     */
+    uchar* reserve(qint64 size);
+    
+    /** Unmaps the current chunk of the file. */
+    void unmap();
+    
+    QFile m_file;
+    uchar* m_map;
+    qint64 m_mapOffset;
+    qint64 m_mapSize;
+    qint64 m_size;
+    QElapsedTimer m_clock;
+    
+    mutable QMutex m_mutex;
+    QWaitCondition m_condition;
+    QList<Record> m_queue;
+    int m_numPendingFrames;
+    bool m_stop;
+    quint32 m_numChannels;
+    quint64 m_numWrittenFrames;
+    quint64 m_numDroppedFrames;
+    QString m_errorString;
+};
+
+#endif // CAPTUREWRITER_H
@@ -3,6 +3,8 @@
 #include <stromx/runtime/Connector.h>
 #include <stromx/runtime/DataContainer.h>
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include "CaptureWriter.h"
 #include "event/ConnectorDataEvent.h"
 #include "event/ConnectorOccupyEvent.h"
 
@@ -12,63 +14,214 @@ const int ConnectorObserver::MIN_SPAN_MILLISECONDS = 1;
 ObserverScheduler ConnectorObserver::gScheduler(ConnectorObserver::NUM_VALUES,
                                                 ConnectorObserver::MIN_SPAN_MILLISECONDS);
 
+namespace
+{
+    QElapsedTimer startClock()
+    {
+        QElapsedTimer clock;
+        clock.start();
+        return clock;
+    }
+    
+    const QElapsedTimer gClock = startClock();
+    
+    bool isSet(const QAtomicInt & flag)
+    {
+#ifdef STROMX_STUDIO_QT4
+        return int(flag) != 0;
+#else
+        return flag.load() != 0;
+#endif
+    }
+}
+
+qint64 ConnectorObserver::currentTime()
+{
+    // 0 means that there has been no change
+    return gClock.elapsed() + 1;
+}
+
 ConnectorObserver::ConnectorObserver(QObject* receiver)
   : m_receiver(receiver),
-    m_observeData(false)
+    m_captureWriter(0),
+    m_lastChange(0),
+    m_trackActivity(0),
+    m_capturing(0)
 {
 }
 
 void ConnectorObserver::observe(const stromx::runtime::Connector& connector,
                                 const stromx::runtime::DataContainer & /*oldData*/,
                                 const stromx::runtime::DataContainer & newData,
-                                const stromx::runtime::Thread* const /*thread*/) const
+                                const stromx::runtime::Thread* const thread) const
 {
-    // First check if there have been too many events recently. If this is the
+    // consider only the new (= current) connector value
+    const stromx::runtime::DataContainer & data = newData;
+    bool isInput = connector.type() == stromx::runtime::Connector::INPUT;
+    bool trackActivity = isSet(m_trackActivity);
+    bool capturing = isSet(m_capturing);
+    
+    // Record the activity for the watchdog and count the data set to the input 
+    // before any events are dropped. This way the sequence numbers of data 
+    // which is observed at different inputs during the same iteration of the
+    // stream match. The position of the thread is stored by this observer,
+    // i.e. threads which change connectors of different operators do not 
+    // share a lock.
+    quint64 sequence = 0;
+    bool captureData = false;
+    bool observeData = false;
+    if(trackActivity || (isInput && ! data.empty()))
+    {
+        qint64 time = trackActivity ? currentTime() : 0;
+        
+        QMutexLocker lock(&m_mutex);
+        if(trackActivity)
+        {
+            QSet<unsigned int> & occupied = isInput ? m_occupiedInputs : m_occupiedOutputs;
+            if(data.empty())
+                occupied.remove(connector.id());
+            else
+                occupied.insert(connector.id());
+            m_lastChange = time;
+            
+            if(thread)
+            {
+                ThreadPosition & position = m_threadPositions[thread];
+                position.receiver = m_receiver;
+                position.type = connector.type();
+                position.id = connector.id();
+                position.occupied = ! data.empty();
+                position.time = time;
+            }
+        }
+        
+        if(isInput && ! data.empty())
+        {
+            sequence = ++m_sequences[connector.id()];
+            captureData = capturing && m_captureWriter && m_captureChannels.contains(connector.id());
+            
+            // If the data router has subscribers for this input its ID is 
+            // contained in m_observedInputs.
+            observeData = m_observedInputs.contains(connector.id());
+            
+            // do not wait for a read access to data which would be dropped anyways
+            if(captureData && m_captureWriter->isQueueFull())
+            {
+                m_captureWriter->dropFrame();
+                captureData = false;
+            }
+        }
+    }
+    
+    // Captured data is passed to the capture writer before any events are dropped.
+    // The read access is obtained without holding the lock because this might take
+    // a while. Afterwards check again if the capture has been stopped meanwhile.
+    if(captureData)
+    {
+        stromx::runtime::ReadAccess access(data);
+        
+        QMutexLocker lock(&m_mutex);
+        if(m_captureWriter && m_captureChannels.contains(connector.id()))
+            m_captureWriter->write(m_captureChannels[connector.id()], sequence, access);
+    }
+    
+    // Check if there have been too many events recently. If this is the
     // case return and give the GUI the chance to handle the remaining events.
     if (! gScheduler.schedule())
         return;
         
-    // consider only the new (= current) connector value
-    const stromx::runtime::DataContainer & data = newData;
-        
     QCoreApplication* application = QCoreApplication::instance();
     OperatorModel::ConnectorType type = connector.type() == stromx::runtime::Connector::INPUT ? 
                                         OperatorModel::INPUT : OperatorModel::OUTPUT;
     ConnectorOccupyEvent* occupyEvent = new ConnectorOccupyEvent(type, connector.id(), data.empty() ? false : true);                                   
     application->postEvent(m_receiver, occupyEvent);
     
-    // Next the actual data is observed:
-    // First make sure the data is not empty.
-    if(data.empty())
-        return;
-    
-    // If receivers are connected to the respective signal of OperatorModel
-    // the member m_observeData is true. Here we obtain the flag in a thread-safe
-    // way.
-    bool observeData = false;
-    {
-        QMutexLocker lock(&m_mutex);
-        observeData = m_observeData;
-    }
-    
-    // The data must be observed only if the the flag is true and the connector
-    // is an input (observation of outputs is not supported because it can always
-    // be achieved by observing the corresponding input).
-    if(observeData && type == OperatorModel::INPUT)
+    // The data must be observed only if the the flag is true, i.e. the data is
+    // not empty and the connector is an input (observation of outputs is not
+    // supported because it can always be achieved by observing the
+    // corresponding input).
+    if(observeData)
     {
         // get a read access to the data (this might take a while)
         stromx::runtime::ReadAccess access(data);
         
         // send an event with the data and the access to the Qt GUI loop
-        ConnectorDataEvent* dataEvent = new ConnectorDataEvent(type, connector.id(), access);
+        ConnectorDataEvent* dataEvent = new ConnectorDataEvent(type, connector.id(), access, sequence);
         application->postEvent(m_receiver, dataEvent);
     }
 }
 
-void ConnectorObserver::setObserveData(bool observe)
+void ConnectorObserver::setObserveData(unsigned int id, bool observe)
+{
+    QMutexLocker lock(&m_mutex);
+    if(observe)
+        m_observedInputs.insert(id);
+    else
+        m_observedInputs.remove(id);
+}
+
+void ConnectorObserver::resetSequences()
+{
+    QMutexLocker lock(&m_mutex);
+    m_sequences.clear();
+}
+
+ConnectorObserver::Activity ConnectorObserver::activity() const
+{
+    QMutexLocker lock(&m_mutex);
+    
+    Activity activity;
+    activity.lastChange = m_lastChange;
+    activity.occupiedInputs = m_occupiedInputs.count();
+    activity.occupiedOutputs = m_occupiedOutputs.count();
+    
+    return activity;
+}
+
+void ConnectorObserver::resetActivity()
+{
+    QMutexLocker lock(&m_mutex);
+    m_occupiedInputs.clear();
+    m_occupiedOutputs.clear();
+    m_lastChange = 0;
+    m_threadPositions.clear();
+}
+
+void ConnectorObserver::restartActivity()
+{
+    QMutexLocker lock(&m_mutex);
+    m_lastChange = currentTime();
+}
+
+void ConnectorObserver::setTrackActivity(bool track)
+{
+    m_trackActivity.fetchAndStoreOrdered(track ? 1 : 0);
+}
+
+QHash<const stromx::runtime::Thread*, ConnectorObserver::ThreadPosition> ConnectorObserver::threadPositions() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_threadPositions;
+}
+
+void ConnectorObserver::setCaptureChannel(unsigned int id, CaptureWriter* writer, quint32 channel)
 {
     QMutexLocker lock(&m_mutex);
-    m_observeData = observe;
+    m_captureWriter = writer;
+    m_captureChannels[id] = channel;
+    m_capturing.fetchAndStoreOrdered(1);
 }
 
+bool ConnectorObserver::hasCaptureChannel(unsigned int id) const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_captureWriter && m_captureChannels.contains(id);
+}
 
+void ConnectorObserver::clearCaptureChannels()
+{
+    QMutexLocker lock(&m_mutex);
+    m_capturing.fetchAndStoreOrdered(0);
+    m_captureWriter = 0;
+    m_captureChannels.clear();
+}
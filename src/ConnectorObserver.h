@@ -20,7 +20,11 @@
 #ifndef CONNECTOROBSERVER_H
 #define CONNECTOROBSERVER_H
 
+#include <QAtomicInt>
+#include <QHash>
 #include <QMutex>
+#include <QSet>
+#include <stromx/runtime/Connector.h>
 #include <stromx/runtime/ConnectorObserver.h>
 
 #include "ObserverScheduler.h"
@@ -36,10 +40,43 @@ namespace stromx
 
 class QCoreApplication;
 class QObject;
+class CaptureWriter;
 
 class ConnectorObserver : public stromx::runtime::ConnectorObserver
 {
 public:
+    /** The activity at the connectors of the observed operator. */
+    struct Activity
+    {
+        /** The time of the last connector change as returned by currentTime() or 0. */
+        qint64 lastChange;
+        
+        /** The number of occupied inputs of the operator. */
+        int occupiedInputs;
+        
+        /** The number of occupied outputs of the operator. */
+        int occupiedOutputs;
+    };
+    
+    /** The last connector change which was made by a stromx thread. */
+    struct ThreadPosition
+    {
+        /** The receiver of the observer of the connector. */
+        QObject* receiver;
+        stromx::runtime::Connector::Type type;
+        unsigned int id;
+        bool occupied;
+        
+        /** The time of the change as returned by currentTime(). */
+        qint64 time;
+    };
+    
+    /** 
+     * Returns the time in milliseconds of the monotonic clock which is used
+     * to record the connector activity. The time is always greater than 0.
+     */
+    static qint64 currentTime();
+    
     ConnectorObserver(QObject* receiver);
         
     virtual void observe(const stromx::runtime::Connector &connector,
@@ -47,7 +84,57 @@ public:
                          const stromx::runtime::DataContainer &newData,
                          const stromx::runtime::Thread* const thread) const;
                          
-    void setObserveData(bool observe);
+    void setObserveData(unsigned int id, bool observe);
+    
+    /** 
+     * Resets the sequence numbers of all inputs. The sequence number of an input
+     * counts the data objects which have been set to the input. It is attached
+     * to the observed data and allows to match data which was observed at
+     * different inputs during the same iteration of the stream.
+     */
+    void resetSequences();
+    
+    /** 
+     * Passes all data set to the input \c id to \c writer. The data is written
+     * to the capture file in the channel \c channel.
+     */
+    void setCaptureChannel(unsigned int id, CaptureWriter* writer, quint32 channel);
+    
+    /** Returns true if the data set to the input \c id is passed to a capture writer. */
+    bool hasCaptureChannel(unsigned int id) const;
+    
+    /** Stops passing data to the capture writer. */
+    void clearCaptureChannels();
+    
+    /** 
+     * Starts or stops recording the activity at the connectors and the thread
+     * positions. This should only be enabled while the stream is inactive,
+     * otherwise the occupied connectors are not reliable. Activity is not
+     * recorded by default.
+     */
+    void setTrackActivity(bool track);
+    
+    /** Returns the activity at the connectors since the last reset. */
+    Activity activity() const;
+    
+    /** 
+     * Marks all connectors as empty, resets the time of the last change and
+     * forgets the thread positions.
+     */
+    void resetActivity();
+    
+    /** 
+     * Sets the time of the last change to the current time but keeps the
+     * occupied connectors. This way the time while the stream was paused
+     * is not mistaken for a lack of progress.
+     */
+    void restartActivity();
+    
+    /** 
+     * Returns the most recent change at the connectors of the observed operator
+     * for each thread which changed any of them.
+     */
+    QHash<const stromx::runtime::Thread*, ThreadPosition> threadPositions() const;
                          
 private:
     const static int NUM_VALUES;
@@ -56,7 +143,16 @@ private:
     static ObserverScheduler gScheduler;
     
     QObject* m_receiver;
-    bool m_observeData;
+    QSet<unsigned int> m_observedInputs;
+    mutable QHash<unsigned int, quint64> m_sequences;
+    CaptureWriter* m_captureWriter;
+    QHash<unsigned int, quint32> m_captureChannels;
+    QAtomicInt m_capturing;
+    mutable QSet<unsigned int> m_occupiedInputs;
+    mutable QSet<unsigned int> m_occupiedOutputs;
+    mutable qint64 m_lastChange;
+    mutable QHash<const stromx::runtime::Thread*, ThreadPosition> m_threadPositions;
+    QAtomicInt m_trackActivity;
     mutable QMutex m_mutex;
 };
 
@@ -33,6 +33,7 @@
 #include "Common.h"
 #include "Image.h"
 #include "Matrix.h"
+#include "VariantTable.h"
 
 namespace
 {
@@ -48,222 +49,162 @@ namespace
             return false;
         }
     }
-}
-
-QVariant DataConverter::toQVariant(const stromx::runtime::Data& data, const stromx::runtime::Parameter& param, int role)
-{
-    try
+    
+    QVariant noneToQVariant(const stromx::runtime::Data & /*data*/, const stromx::runtime::Parameter & /*param*/, int role)
     {
-        QString dataString;
+        if(role == Qt::DisplayRole)
+            return QString("None");
         
-        if (data.isVariant(stromx::runtime::Variant::NONE))
-        {
-            if(role == Qt::DisplayRole)
-                return QString("None");
-        }
-        
-        if (data.isVariant(stromx::runtime::Variant::TRIGGER))
-        {
-            if(role == Qt::DisplayRole)
-                return QString("Trigger");
-            
-            if(role == TriggerRole)
-                return QString("Trigger");
-        }
+        return QVariant();
+    }
+    
+    QVariant triggerToQVariant(const stromx::runtime::Data & /*data*/, const stromx::runtime::Parameter & /*param*/, int role)
+    {
+        if(role == Qt::DisplayRole)
+            return QString("Trigger");
         
-        if (data.isVariant(stromx::runtime::Variant::BOOL))
-        {
-            const stromx::runtime::Bool & boolData = stromx::runtime::data_cast<stromx::runtime::Bool>(data);
-                
-            if(role == Qt::DisplayRole)
-            {
-                return bool(boolData) ? QApplication::tr("True") : QApplication::tr("False");
-            }
-            else if(role == Qt::EditRole)
-            {
-                return boolData ? 1 : 0;
-            } 
-            else if(role == ChoicesRole)
-            {
-                QStringList choices;
-                
-                choices.append(QApplication::tr("False"));
-                choices.append(QApplication::tr("True"));
-                
-                return choices;
-            }
-        }
+        if(role == TriggerRole)
+            return QString("Trigger");
         
-        if (data.isVariant(stromx::runtime::Variant::ENUM))
-        {
-            const stromx::runtime::Enum& value = stromx::runtime::data_cast<stromx::runtime::Enum>(data);
-            unsigned int intValue = (unsigned int)(value);
-            const std::vector<stromx::runtime::EnumDescription> & vectorEnumDesc = param.descriptions();
+        return QVariant();
+    }
+    
+    QVariant boolToQVariant(const stromx::runtime::Data & data, const stromx::runtime::Parameter & /*param*/, int role)
+    {
+        const stromx::runtime::Bool & boolData = stromx::runtime::data_cast<stromx::runtime::Bool>(data);
             
-            if(role == Qt::DisplayRole)
-            {
-                for(std::vector<stromx::runtime::EnumDescription>::const_iterator iter_enumDesc = vectorEnumDesc.begin();
-                    iter_enumDesc != vectorEnumDesc.end();
-                    ++iter_enumDesc)
-                {
-                    if (intValue == iter_enumDesc->value())
-                        return fromStromxTitle(iter_enumDesc->title());
-                }
-                return QString(QObject::tr("<Unknown ENUM>"));
-            }
-            else if(role == Qt::EditRole)
-            {
-                int choice = 0;
-                for(std::vector<stromx::runtime::EnumDescription>::const_iterator iter_enumDesc = vectorEnumDesc.begin();
-                    iter_enumDesc != vectorEnumDesc.end();
-                    ++iter_enumDesc)
-                {
-                    if (intValue == iter_enumDesc->value())
-                        return choice;
-                    ++choice;
-                }
-                return -1;
-            } 
-            else if(role == ChoicesRole)
-            {
-                QStringList choices;
-                for(std::vector<stromx::runtime::EnumDescription>::const_iterator iter_enumDesc = vectorEnumDesc.begin();
-                    iter_enumDesc != vectorEnumDesc.end();
-                    ++iter_enumDesc)
-                {
-                    choices.append(fromStromxTitle(iter_enumDesc->title()));
-                }
-                return choices;
-            }
-        }
-        
-        if (data.isVariant(stromx::runtime::Variant::INT_8))
+        if(role == Qt::DisplayRole)
         {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
-            {
-                const stromx::runtime::Int8 & int8Data = stromx::runtime::data_cast<stromx::runtime::Int8>(data);
-                return int(int8Data);
-            }
+            return bool(boolData) ? QApplication::tr("True") : QApplication::tr("False");
         }
-        
-        if (data.isVariant(stromx::runtime::Variant::UINT_8))
+        else if(role == Qt::EditRole)
         {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
-            {
-                const stromx::runtime::UInt8 & uint8Data = stromx::runtime::data_cast<stromx::runtime::UInt8>(data);
-                return uint(uint8Data);
-            }
-        }
-        
-        if (data.isVariant(stromx::runtime::Variant::INT_16))
+            return boolData ? 1 : 0;
+        } 
+        else if(role == ChoicesRole)
         {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
-            {
-                const stromx::runtime::Int16 & int16Data = stromx::runtime::data_cast<stromx::runtime::Int16>(data);
-                return int(int16Data);
-            }
+            QStringList choices;
+            
+            choices.append(QApplication::tr("False"));
+            choices.append(QApplication::tr("True"));
+            
+            return choices;
         }
         
-        if (data.isVariant(stromx::runtime::Variant::UINT_16))
-        {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
-            {
-                const stromx::runtime::UInt16 & uint16Data = stromx::runtime::data_cast<stromx::runtime::UInt16>(data);
-                return uint(uint16Data);
-            }
-        }
+        return QVariant();
+    }
+    
+    QVariant enumToQVariant(const stromx::runtime::Data & data, const stromx::runtime::Parameter & param, int role)
+    {
+        const stromx::runtime::Enum& value = stromx::runtime::data_cast<stromx::runtime::Enum>(data);
+        unsigned int intValue = (unsigned int)(value);
+        const std::vector<stromx::runtime::EnumDescription> & vectorEnumDesc = param.descriptions();
         
-        if (data.isVariant(stromx::runtime::Variant::INT_32))
+        if(role == Qt::DisplayRole)
         {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
+            for(std::vector<stromx::runtime::EnumDescription>::const_iterator iter_enumDesc = vectorEnumDesc.begin();
+                iter_enumDesc != vectorEnumDesc.end();
+                ++iter_enumDesc)
             {
-                const stromx::runtime::Int32 & int32Data = stromx::runtime::data_cast<stromx::runtime::Int32>(data);
-                return int(int32Data);
+                if (intValue == iter_enumDesc->value())
+                    return fromStromxTitle(iter_enumDesc->title());
             }
+            return QString(QObject::tr("<Unknown ENUM>"));
         }
-        
-        if (data.isVariant(stromx::runtime::Variant::UINT_32))
+        else if(role == Qt::EditRole)
         {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
+            int choice = 0;
+            for(std::vector<stromx::runtime::EnumDescription>::const_iterator iter_enumDesc = vectorEnumDesc.begin();
+                iter_enumDesc != vectorEnumDesc.end();
+                ++iter_enumDesc)
             {
-                const stromx::runtime::UInt32 & uint32Data = stromx::runtime::data_cast<stromx::runtime::UInt32>(data);
-                return uint(uint32Data);
+                if (intValue == iter_enumDesc->value())
+                    return choice;
+                ++choice;
             }
-        }
-        
-        if (data.isVariant(stromx::runtime::Variant::FLOAT_32))
+            return -1;
+        } 
+        else if(role == ChoicesRole)
         {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
+            QStringList choices;
+            for(std::vector<stromx::runtime::EnumDescription>::const_iterator iter_enumDesc = vectorEnumDesc.begin();
+                iter_enumDesc != vectorEnumDesc.end();
+                ++iter_enumDesc)
             {
-                const stromx::runtime::Float32 & floatData = stromx::runtime::data_cast<stromx::runtime::Float32>(data);
-                return double(floatData);
+                choices.append(fromStromxTitle(iter_enumDesc->title()));
             }
+            return choices;
         }
         
-        if (data.isVariant(stromx::runtime::Variant::FLOAT_64))
+        return QVariant();
+    }
+    
+    template<class data_t, class value_t>
+    QVariant primitiveToQVariant(const stromx::runtime::Data & data, const stromx::runtime::Parameter & /*param*/, int role)
+    {
+        if(role == Qt::DisplayRole || role == Qt::EditRole)
         {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
-            {
-                const stromx::runtime::Float64 & doubleData = stromx::runtime::data_cast<stromx::runtime::Float64>(data);
-                return double(doubleData);
-            }
+            const data_t & primitiveData = stromx::runtime::data_cast<data_t>(data);
+            return value_t(primitiveData);
         }
         
-        if (data.isVariant(stromx::runtime::Variant::STRING))
+        return QVariant();
+    }
+    
+    QVariant stringToQVariant(const stromx::runtime::Data & data, const stromx::runtime::Parameter & /*param*/, int role)
+    {
+        if(role == Qt::DisplayRole || role == Qt::EditRole)
         {
-            if(role == Qt::DisplayRole || role == Qt::EditRole)
-            {
-                const stromx::runtime::String & stringData = stromx::runtime::data_cast<stromx::runtime::String>(data);
-                return QString::fromStdString(std::string(stringData));
-            }
+            const stromx::runtime::String & stringData = stromx::runtime::data_cast<stromx::runtime::String>(data);
+            return QString::fromStdString(std::string(stringData));
         }
         
-        if (data.isVariant(stromx::runtime::Variant::IMAGE))
+        return QVariant();
+    }
+    
+    QVariant matrixToQVariant(const stromx::runtime::Data & data, const stromx::runtime::Parameter & /*param*/, int role)
+    {
+        if(role == Qt::DisplayRole)
         {
-            if(role == Qt::DisplayRole || role == ImageRole)
-            {
-                const stromx::runtime::Image & imageData = stromx::runtime::data_cast<stromx::runtime::Image>(data);
-                return QString(QObject::tr("Width: %1 | Height: %2"))
-                    .arg(imageData.width()).arg(imageData.height());
-            }
+            const stromx::runtime::Matrix & matrixData = stromx::runtime::data_cast<stromx::runtime::Matrix>(data);
+            return QString(QObject::tr("Rows: %1 | Columns: %2"))
+                .arg(matrixData.rows()).arg(matrixData.cols());
         }
         
-        if (data.isVariant(stromx::runtime::Variant::MATRIX))
+        if(role == MatrixRole)
         {
-            if(role == Qt::DisplayRole)
-            {
-                const stromx::runtime::Matrix & matrixData = stromx::runtime::data_cast<stromx::runtime::Matrix>(data);
-                return QString(QObject::tr("Rows: %1 | Columns: %2"))
-                    .arg(matrixData.rows()).arg(matrixData.cols());
-            }
-            
-            if(role == MatrixRole)
-            {
-                const stromx::runtime::Matrix & matrixData = stromx::runtime::data_cast<stromx::runtime::Matrix>(data);
-                const Matrix matrix(matrixData);
-                QVariant variantData;
-                variantData.setValue<Matrix>(matrix);
-                return variantData;
-            }
+            const stromx::runtime::Matrix & matrixData = stromx::runtime::data_cast<stromx::runtime::Matrix>(data);
+            const Matrix matrix(matrixData);
+            QVariant variantData;
+            variantData.setValue<Matrix>(matrix);
+            return variantData;
         }
         
         return QVariant();
     }
-    catch(stromx::runtime::BadCast&)
+    
+    QVariant imageToQVariant(const stromx::runtime::Data & data, const stromx::runtime::Parameter & param, int role)
     {
-        return QVariant();
-    }  
-}
-
-stromx::runtime::DataRef DataConverter::toStromxData(const QVariant& variant, const stromx::runtime::Parameter& param)
-{
-    if(param.variant().isVariant(stromx::runtime::Variant::TRIGGER))
+        if(role == Qt::DisplayRole || role == ImageRole)
+        {
+            const stromx::runtime::Image & imageData = stromx::runtime::data_cast<stromx::runtime::Image>(data);
+            return QString(QObject::tr("Width: %1 | Height: %2"))
+                .arg(imageData.width()).arg(imageData.height());
+        }
+        
+        // images are matrices as well
+        return matrixToQVariant(data, param, role);
+    }
+    
+    stromx::runtime::DataRef triggerToStromxData(const QVariant & variant, const stromx::runtime::Parameter & /*param*/)
     {
         if(variant.type() == QVariant::Bool && variant.toBool())
             return stromx::runtime::DataRef(new stromx::runtime::TriggerData());
+        
+        return stromx::runtime::DataRef();
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::ENUM))
+    stromx::runtime::DataRef enumToStromxData(const QVariant & variant, const stromx::runtime::Parameter & param)
     {
         if(variant.type() == QVariant::Int)
         {  
@@ -275,83 +216,163 @@ stromx::runtime::DataRef DataConverter::toStromxData(const QVariant& variant, co
                 return stromx::runtime::DataRef(new stromx::runtime::Enum(value));
             }
         }
+        
+        return stromx::runtime::DataRef();
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::BOOL))
-    {
-        if(variant.type() == QVariant::Int)
-            return stromx::runtime::DataRef(new stromx::runtime::Bool(variant.toInt()));
-    }
-    
-    if(param.variant().isVariant(stromx::runtime::Variant::INT_8))
-    {
-        if(variant.type() == QVariant::Int)
-            return stromx::runtime::DataRef(new stromx::runtime::Int8(variant.toInt()));
-    }
-    
-    if(param.variant().isVariant(stromx::runtime::Variant::UINT_8))
+    template<class data_t>
+    stromx::runtime::DataRef intToStromxData(const QVariant & variant, const stromx::runtime::Parameter & /*param*/)
     {
         if(variant.type() == QVariant::Int)
-            return stromx::runtime::DataRef(new stromx::runtime::UInt8(variant.toInt()));
+            return stromx::runtime::DataRef(new data_t(variant.toInt()));
+        
+        return stromx::runtime::DataRef();
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::INT_16))
+    stromx::runtime::DataRef float32ToStromxData(const QVariant & variant, const stromx::runtime::Parameter & /*param*/)
     {
-        if(variant.type() == QVariant::Int)
-            return stromx::runtime::DataRef(new stromx::runtime::Int16(variant.toInt()));
+        if(variant.type() == QVariant::Double)
+            return stromx::runtime::DataRef(new stromx::runtime::Float32(variant.toFloat()));
+        
+        return stromx::runtime::DataRef();
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::UINT_16))
+    stromx::runtime::DataRef float64ToStromxData(const QVariant & variant, const stromx::runtime::Parameter & /*param*/)
     {
-        if(variant.type() == QVariant::Int)
-            return stromx::runtime::DataRef(new stromx::runtime::UInt16(variant.toInt()));
+        if(variant.type() == QVariant::Double)
+            return stromx::runtime::DataRef(new stromx::runtime::Float64(variant.toDouble()));
+        
+        return stromx::runtime::DataRef();
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::INT_32))
+    stromx::runtime::DataRef stringToStromxData(const QVariant & variant, const stromx::runtime::Parameter & /*param*/)
     {
-        if(variant.type() == QVariant::Int)
-            return stromx::runtime::DataRef(new stromx::runtime::Int32(variant.toInt()));
+        if(variant.type() == QVariant::String)
+            return stromx::runtime::DataRef(new stromx::runtime::String(variant.toString().toStdString()));
+        
+        return stromx::runtime::DataRef();
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::UINT_32))
+    stromx::runtime::DataRef matrixToStromxData(const QVariant & variant, const stromx::runtime::Parameter & /*param*/)
     {
-        if(variant.type() == QVariant::Int)
-            return stromx::runtime::DataRef(new stromx::runtime::UInt32(variant.toInt()));
+        if(variant.canConvert<Matrix>())
+            return stromx::runtime::DataRef(new Matrix(variant.value<Matrix>()));
+        
+        return stromx::runtime::DataRef();
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::FLOAT_32))
+    stromx::runtime::DataRef imageToStromxData(const QVariant & variant, const stromx::runtime::Parameter & param)
     {
-        if(variant.type() == QVariant::Double)
-            return stromx::runtime::DataRef(new stromx::runtime::Float32(variant.toFloat()));
+        if(variant.type() == QVariant::Image)
+            return stromx::runtime::DataRef(new Image(variant.value<QImage>()));
+        
+        // images are matrices as well
+        return matrixToStromxData(variant, param);
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::FLOAT_64))
+    const VariantTable<DataConverter::ToQVariantFunction> & toQVariantTable()
     {
-        if(variant.type() == QVariant::Double)
-            return stromx::runtime::DataRef(new stromx::runtime::Float64(variant.toDouble()));
+        using namespace stromx::runtime;
+        
+        // the order of the entries defines which function is chosen if
+        // several of them match
+        static const VariantTable<DataConverter::ToQVariantFunction> TABLE = 
+            VariantTable<DataConverter::ToQVariantFunction>()
+            .add(Variant::NONE, &noneToQVariant)
+            .add(Variant::TRIGGER, &triggerToQVariant)
+            .add(Variant::BOOL, &boolToQVariant)
+            .add(Variant::ENUM, &enumToQVariant)
+            .add(Variant::INT_8, &primitiveToQVariant<Int8, int>)
+            .add(Variant::UINT_8, &primitiveToQVariant<UInt8, uint>)
+            .add(Variant::INT_16, &primitiveToQVariant<Int16, int>)
+            .add(Variant::UINT_16, &primitiveToQVariant<UInt16, uint>)
+            .add(Variant::INT_32, &primitiveToQVariant<Int32, int>)
+            .add(Variant::UINT_32, &primitiveToQVariant<UInt32, uint>)
+            .add(Variant::FLOAT_32, &primitiveToQVariant<Float32, double>)
+            .add(Variant::FLOAT_64, &primitiveToQVariant<Float64, double>)
+            .add(Variant::STRING, &stringToQVariant)
+            .add(Variant::IMAGE, &imageToQVariant)
+            .add(Variant::MATRIX, &matrixToQVariant);
+            
+        return TABLE;
     }
     
-    if(param.variant().isVariant(stromx::runtime::Variant::STRING))
+    const VariantTable<DataConverter::ToStromxDataFunction> & toStromxDataTable()
     {
-        if(variant.type() == QVariant::String)
-            return stromx::runtime::DataRef(new stromx::runtime::String(variant.toString().toStdString()));
+        using namespace stromx::runtime;
+        
+        static const VariantTable<DataConverter::ToStromxDataFunction> TABLE = 
+            VariantTable<DataConverter::ToStromxDataFunction>()
+            .add(Variant::TRIGGER, &triggerToStromxData)
+            .add(Variant::ENUM, &enumToStromxData)
+            .add(Variant::BOOL, &intToStromxData<Bool>)
+            .add(Variant::INT_8, &intToStromxData<Int8>)
+            .add(Variant::UINT_8, &intToStromxData<UInt8>)
+            .add(Variant::INT_16, &intToStromxData<Int16>)
+            .add(Variant::UINT_16, &intToStromxData<UInt16>)
+            .add(Variant::INT_32, &intToStromxData<Int32>)
+            .add(Variant::UINT_32, &intToStromxData<UInt32>)
+            .add(Variant::FLOAT_32, &float32ToStromxData)
+            .add(Variant::FLOAT_64, &float64ToStromxData)
+            .add(Variant::STRING, &stringToStromxData)
+            .add(Variant::IMAGE, &imageToStromxData)
+            .add(Variant::MATRIX, &matrixToStromxData);
+            
+        return TABLE;
     }
+}
+
+QVariant DataConverter::toQVariant(const stromx::runtime::Data& data, const stromx::runtime::Parameter& param, int role)
+{
+    return toQVariant(toQVariantFunction(data), data, param, role);
+}
+
+QVariant DataConverter::toQVariant(ToQVariantFunction function, const stromx::runtime::Data& data,
+                                   const stromx::runtime::Parameter& param, int role)
+{
+    if(! function)
+        return QVariant();
     
-    if(param.variant().isVariant(stromx::runtime::Variant::IMAGE))
+    try
     {
-        if(variant.type() == QVariant::Image)
-            return stromx::runtime::DataRef(new Image(variant.value<QImage>()));
+        return function(data, param, role);
     }
-    
-    if(param.variant().isVariant(stromx::runtime::Variant::MATRIX))
+    catch(stromx::runtime::BadCast&)
     {
-        if(variant.canConvert<Matrix>())
-            return stromx::runtime::DataRef(new Matrix(variant.value<Matrix>()));
-    }
+        return QVariant();
+    }  
+}
+
+DataConverter::ToQVariantFunction DataConverter::toQVariantFunction(const stromx::runtime::Data& data)
+{
+    return toQVariantTable().lookup(data);
+}
+
+DataConverter::ToQVariantFunction DataConverter::toQVariantFunction(const stromx::runtime::VariantHandle& variant)
+{
+    return toQVariantTable().lookupUnique(variant);
+}
+
+stromx::runtime::DataRef DataConverter::toStromxData(const QVariant& variant, const stromx::runtime::Parameter& param)
+{
+    return toStromxData(toStromxDataFunction(param.variant()), variant, param);
+}
+
+stromx::runtime::DataRef DataConverter::toStromxData(ToStromxDataFunction function, const QVariant& variant,
+                                                     const stromx::runtime::Parameter& param)
+{
+    if(! function)
+        return stromx::runtime::DataRef();
     
-    return stromx::runtime::DataRef();
+    return function(variant, param);
 }
 
+DataConverter::ToStromxDataFunction DataConverter::toStromxDataFunction(const stromx::runtime::VariantHandle& variant)
+{
+    return toStromxDataTable().lookup(variant);
+}
+
+
 bool DataConverter::stromxDataEqualsTarget(const stromx::runtime::Data& newValue, const stromx::runtime::Data& targetValue)
 {
     if(! newValue.isVariant(targetValue.variant()))
@@ -31,6 +31,7 @@ namespace stromx
         class Data;
         class DataRef;
         class Parameter;
+        class VariantHandle;
     }
 }
 
@@ -38,18 +39,57 @@ namespace stromx
 class DataConverter
 {   
 public:
+    /** Function which converts stromx data of a specific variant to a QVariant object. */
+    typedef QVariant (*ToQVariantFunction)(const stromx::runtime::Data & data,
+                                           const stromx::runtime::Parameter & param, int role);
+    
+    /** Function which converts a QVariant object to stromx data of a specific variant. */
+    typedef stromx::runtime::DataRef (*ToStromxDataFunction)(const QVariant & variant,
+                                                             const stromx::runtime::Parameter & param);
+    
     /** 
      * Converts the stromx data object \c data of the parameter \c param to a QVariant object.
      * The type of the returned QVariant depends on \c role.
      */
     static QVariant toQVariant(const stromx::runtime::Data & data, const stromx::runtime::Parameter & param, int role);
     
+    /** 
+     * Converts \c data by calling \c function which has been obtained by toQVariantFunction().
+     * Returns an invalid QVariant if \c function is 0.
+     */
+    static QVariant toQVariant(ToQVariantFunction function, const stromx::runtime::Data & data,
+                               const stromx::runtime::Parameter & param, int role);
+    
+    /** Returns the function which converts \c data to a QVariant object or 0 if there is none. */
+    static ToQVariantFunction toQVariantFunction(const stromx::runtime::Data & data);
+    
+    /** 
+     * Returns the function which converts data of the variant \c variant to a QVariant object 
+     * or 0 if there is none. The function can be stored and reused for data of this variant.
+     * Returns 0 for general and composite variants (e.g. matrices which might be images)
+     * because the function must be obtained from the data in this case.
+     */
+    static ToQVariantFunction toQVariantFunction(const stromx::runtime::VariantHandle & variant);
+    
     /**
      * Converts the input \c variant to the type defined by the parameter \c param and writes the
      * result to a new object of the correct stromx data type.
      */
     static stromx::runtime::DataRef toStromxData(const QVariant & variant, const stromx::runtime::Parameter & param);
     
+    /** 
+     * Converts \c variant by calling \c function which has been obtained by toStromxDataFunction().
+     * Returns a null reference if \c function is 0.
+     */
+    static stromx::runtime::DataRef toStromxData(ToStromxDataFunction function, const QVariant & variant,
+                                                 const stromx::runtime::Parameter & param);
+    
+    /** 
+     * Returns the function which converts QVariant objects to data of the variant \c variant
+     * or 0 if there is none. The function can be stored and reused for parameters of this variant.
+     */
+    static ToStromxDataFunction toStromxDataFunction(const stromx::runtime::VariantHandle & variant);
+    
     /**
      * Returns true if the data if \c newValue is of a type derived from \c targetValue and
      * \c newValue equals \c targetValue .
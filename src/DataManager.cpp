@@ -1,26 +1,40 @@
 #include "DataManager.h"
 
+#include <QTimer>
 #include <stromx/runtime/ReadAccess.h>
 
 #include "AbstractDataVisualizer.h"
+#include "DataRouter.h"
+#include "FrameHistory.h"
 #include "model/InputModel.h"
 #include "model/ObserverModel.h"
+#include "model/ObserverTreeModel.h"
 #include "model/OperatorModel.h"
+#include "model/StreamModel.h"
+
+const int DataManager::MAX_BUFFERED_DATA = 8;
 
 DataManager::DataManager(ObserverModel* observer, AbstractDataVisualizer* visualizer, QObject* parent)
   : QObject(parent),
     m_observer(observer),
-    m_visualizer(visualizer)
+    m_router(observer->parentModel()->streamModel()->dataRouter()),
+    m_visualizer(visualizer),
+    m_latencyTimer(new QTimer(this)),
+    m_live(true)
 {
+    m_latencyTimer->setSingleShot(true);
+    connect(m_latencyTimer, SIGNAL(timeout()), this, SLOT(displayBufferedData()));
+    
     connect(m_observer, SIGNAL(inputAdded(InputModel*,int)), this, SLOT(addInputLayer(InputModel*,int)));
     connect(m_observer, SIGNAL(inputMoved(InputModel*,int,int)), this, SLOT(moveInputLayer(InputModel*,int,int)));
     connect(m_observer, SIGNAL(inputRemoved(InputModel*,int)), this, SLOT(removeInputLayer(InputModel*,int)));
+    connect(m_observer, SIGNAL(synchronizedChanged(bool)), this, SLOT(handleSynchronizedChanged(bool)));
     
     int i = 0;
     foreach(InputModel* input, observer->inputs())
     {
         m_inputs.append(input);
-        connectInput(input);
+        m_router->subscribe(input, this);
         visualizer->addLayer(i);
         i++;
     }
@@ -35,9 +49,9 @@ void DataManager::addInputLayer(InputModel* input, int pos)
     // add a new layer in the front
     m_visualizer->addLayer(pos);
     
-    // remember the input and connect to it
+    // remember the input and subscribe to its data
     m_inputs.insert(pos, input);
-    connectInput(input);
+    m_router->subscribe(input, this);
 }
 
 void DataManager::moveInputLayer(InputModel* /*input*/, int srcPos, int destPos)
@@ -79,9 +93,11 @@ void DataManager::moveInputLayer(InputModel* /*input*/, int srcPos, int destPos)
 
 void DataManager::removeInputLayer(InputModel* input, int pos)
 {
-    // remove the input and disconnect from it
+    // remove the input and unsubscribe from its data
     m_inputs.removeAt(pos);
-    disconnectInput(input);
+    m_buffers.remove(input);
+    m_router->unsubscribe(input, this);
+    m_observer->history()->removeInput(input);
     
     // move all layer behind pos to the front
     for(int i = pos; i < m_inputs.count(); ++i)
@@ -91,44 +107,170 @@ void DataManager::removeInputLayer(InputModel* input, int pos)
     m_visualizer->removeLayer(m_inputs.count());
 }
 
-void DataManager::updateLayerData(OperatorModel::ConnectorType /*type*/, unsigned int id,
-                                  stromx::runtime::ReadAccess access)
+void DataManager::setInputData(InputModel* input, const stromx::runtime::ReadAccess & access,
+                               quint64 sequence)
 {
-    if(access.empty())
+    if(access.empty() || ! m_live)
         return;
     
-    QObject* source = sender();
-    if(OperatorModel* op = qobject_cast<OperatorModel*>(source))
+    m_observer->history()->record(input, access.get());
+    
+    if(! m_observer->isSynchronized())
     {
-        for(int layer = 0; layer < m_inputs.count(); ++layer)
-        {
-            InputModel* input = m_inputs[layer];
-            if(input->op() == op && input->id() == id)
-                m_visualizer->setData(layer, access.get(), input->visualizationState());
-        }
+        displayData(input, access.get());
+        return;
     }
+    
+    // buffer the data and drop the oldest data if the buffer is full
+    QList<BufferedData> & buffer = m_buffers[input];
+    buffer.append(BufferedData(access.get(), sequence));
+    while(buffer.count() > MAX_BUFFERED_DATA)
+        buffer.removeFirst();
+    
+    displayBufferedData();
 }
 
-void DataManager::connectInput(InputModel* input)
+void DataManager::handleSynchronizedChanged(bool synchronized)
 {
-    // connect only if no connection to this operator exists
-    connect(input->op(), SIGNAL(connectorDataChanged(OperatorModel::ConnectorType,uint,stromx::runtime::ReadAccess)),
-            this, SLOT(updateLayerData(OperatorModel::ConnectorType,uint,stromx::runtime::ReadAccess)), Qt::UniqueConnection);
+    if(synchronized)
+        return;
+    
+    // display the newest data of each input
+    QHash<InputModel*, QList<BufferedData> >::const_iterator iter;
+    for(iter = m_buffers.constBegin(); iter != m_buffers.constEnd(); ++iter)
+    {
+        if(! iter.value().isEmpty())
+            displayData(iter.key(), *iter.value().last().data);
+    }
+    
+    clearBuffers();
 }
 
-void DataManager::disconnectInput(InputModel* input)
+void DataManager::setLive(bool live)
 {
-    OperatorModel* op = input->op();
+    if(live == m_live)
+        return;
     
-    // look if any other input requires a connection to op
-    // in this case the connections must not be disconnected
-    foreach(InputModel* input, m_inputs)
+    m_live = live;
+    clearBuffers();
+    
+    // continue with the newest recorded data
+    if(m_live)
+        displayHistory(m_observer->history()->numFrames() - 1);
+}
+
+void DataManager::showHistory(int position)
+{
+    m_live = false;
+    clearBuffers();
+    displayHistory(position);
+}
+
+void DataManager::displayHistory(int position)
+{
+    for(int i = 0; i < m_inputs.count(); ++i)
     {
-        if(input->op() == op)
-            return;
+        InputModel* input = m_inputs[i];
+        const stromx::runtime::Data* data = m_observer->history()->data(input, position);
+        if(data)
+            m_visualizer->setData(i, *data, input->visualizationState());
     }
+}
+
+void DataManager::clearBuffers()
+{
+    m_buffers.clear();
+    m_latencyTimer->stop();
+}
+
+void DataManager::displayBufferedData()
+{
+    quint64 sequence = 0;
+    if(findMatchingSequence(sequence))
+    {
+        // display the matching data and forget all older data
+        QHash<InputModel*, QList<BufferedData> >::iterator iter;
+        for(iter = m_buffers.begin(); iter != m_buffers.end(); ++iter)
+        {
+            QList<BufferedData> & buffer = iter.value();
+            while(! buffer.isEmpty() && buffer.first().sequence <= sequence)
+            {
+                if(buffer.first().sequence == sequence)
+                    displayData(iter.key(), *buffer.first().data);
+                buffer.removeFirst();
+            }
+        }
+    }
+    
+    // display the data of inputs which waited too long for the other inputs
+    const int maxLatency = m_observer->maxLatency();
+    int remainingLatency = -1;
+    QHash<InputModel*, QList<BufferedData> >::iterator iter;
+    for(iter = m_buffers.begin(); iter != m_buffers.end(); ++iter)
+    {
+        QList<BufferedData> & buffer = iter.value();
+        if(buffer.isEmpty())
+            continue;
+        
+        int elapsed = buffer.first().arrival.elapsed();
+        if(elapsed >= maxLatency)
+        {
+            displayData(iter.key(), *buffer.last().data);
+            buffer.clear();
+        }
+        else if(remainingLatency < 0 || maxLatency - elapsed < remainingLatency)
+        {
+            remainingLatency = maxLatency - elapsed;
+        }
+    }
+    
+    // check again when the oldest remaining data exceeds the latency
+    if(remainingLatency >= 0)
+        m_latencyTimer->start(remainingLatency);
+    else
+        m_latencyTimer->stop();
+}
+
+bool DataManager::findMatchingSequence(quint64 & sequence) const
+{
+    if(m_buffers.isEmpty())
+        return false;
     
-    // this was the only input connected to op
-    input->op()->disconnect(this);
+    // Only inputs which have received data since the synchronization was activated
+    // have a buffer. Go through the data of the first buffer starting from the
+    // newest one and check if it is contained in all other buffers.
+    const QList<BufferedData> & first = m_buffers.constBegin().value();
+    for(int i = first.count() - 1; i >= 0; --i)
+    {
+        bool isMatch = true;
+        QHash<InputModel*, QList<BufferedData> >::const_iterator iter;
+        for(iter = m_buffers.constBegin(); iter != m_buffers.constEnd() && isMatch; ++iter)
+        {
+            isMatch = false;
+            foreach(const BufferedData & data, iter.value())
+            {
+                if(data.sequence == first[i].sequence)
+                {
+                    isMatch = true;
+                    break;
+                }
+            }
+        }
+        
+        if(isMatch)
+        {
+            sequence = first[i].sequence;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void DataManager::displayData(InputModel* input, const stromx::runtime::Data & data)
+{
+    int layer = m_inputs.indexOf(input);
+    if(layer >= 0)
+        m_visualizer->setData(layer, data, input->visualizationState());
 }
 
@@ -20,14 +20,20 @@
 #ifndef DATAMANAGER_H
 #define DATAMANAGER_H
 
+#include <QHash>
 #include <QObject>
+#include <QSharedPointer>
+#include <QTime>
 
+#include <stromx/runtime/Data.h>
 #include <stromx/runtime/ReadAccess.h>
 #include "model/OperatorModel.h"
 
 class AbstractDataVisualizer;
+class DataRouter;
 class InputModel;
 class ObserverModel;
+class QTimer;
 
 
 /** 
@@ -42,6 +48,21 @@ class ObserverModel;
  * of an input change the respective commands of the data visualizer are called.
  * In particular if data is observed by an input model the data manager updates
  * it in the visualizer.
+ * 
+ * The data manager does not connect to the operator models directly. Instead it
+ * subscribes its inputs at the data router of the stream which passes the
+ * observed data only to the layers which display it.
+ * 
+ * If the observer is synchronized the data of each input is buffered until
+ * data with the same sequence number (i.e. from the same iteration of the stream)
+ * has arrived at all other inputs. Then the matching data is displayed in all 
+ * layers at once. Data which has been buffered longer than the maximal latency
+ * of the observer is displayed without waiting for the other inputs.
+ * 
+ * All data which arrives while the data manager is live is recorded in the
+ * frame history of the observer. If the data manager is not live it ignores
+ * any new data and displays the frames at a selected position of the history
+ * instead.
  */
 class DataManager : public QObject
 {
@@ -53,6 +74,29 @@ public:
      * \c observer to \c visualizer.
      */
     DataManager(ObserverModel* observer, AbstractDataVisualizer* visualizer, QObject* parent);
+    
+    /**
+     * Updates the data of the layer which corresponds to \c input. This function
+     * is called by the data router.
+     */
+    void setInputData(InputModel* input, const stromx::runtime::ReadAccess & access,
+                      quint64 sequence);
+    
+    /** Returns true if the data manager displays the observed data as it arrives. */
+    bool isLive() const { return m_live; }
+    
+public slots:
+    /** 
+     * Starts or stops displaying the observed data as it arrives. When the data
+     * manager becomes live it displays the newest frames in the history.
+     */
+    void setLive(bool live);
+    
+    /** 
+     * Stops displaying the observed data and displays the data at \c position
+     * of the frame history instead.
+     */
+    void showHistory(int position);
   
 signals:
     /** An operation accessing stromx data timed out. */
@@ -61,9 +105,8 @@ signals:
 private slots:
     
     /** 
-     * Removes the input layer from the visualizer and disconnects all connections from the input.
-     * Moreover, the connection from the operator of the input are disconnected if no
-     * other input requires them.
+     * Removes the input layer from the visualizer and unsubscribes the input
+     * from the data router.
      */
     void removeInputLayer(InputModel* input, int pos);
     
@@ -71,35 +114,67 @@ private slots:
     void moveInputLayer(InputModel* input, int srcPos, int destPos);
     
     /**
-     * Connects to the input model and adds an input layer to the visualizer.
-     * Moveover, if necessary a connection from the operator to the data manager
-     * is established.
+     * Adds an input layer to the visualizer and subscribes the input at the
+     * data router.
      */
     void addInputLayer(InputModel* input, int pos);
     
-    /**
-     * Updates the data of all layers which correspond to this input.
-     * The input is specified by its type, ID and operator (the sender of the signal).
+    /** 
+     * Displays all buffered data if the synchronization is deactivated and
+     * clears the buffers.
      */
-    void updateLayerData(OperatorModel::ConnectorType type, unsigned int id,
-                         stromx::runtime::ReadAccess access);
+    void handleSynchronizedChanged(bool synchronized);
+    
+    /** 
+     * Displays the newest buffered data which has arrived at all inputs. Displays
+     * the data of inputs which has been buffered for longer than the maximal latency.
+     */
+    void displayBufferedData();
     
 private:
     /** 
-     * Connects to the operator of the input if the connections has not yet been established
-     * because of another input of the same operator.
+     * The maximal number of data objects which are buffered per input. This
+     * limits the memory which is used by a synchronized observer.
      */
-    void connectInput(InputModel* input);
+    static const int MAX_BUFFERED_DATA;
     
-    /**
-     * Disconnects from the operator of the input if the connection is not required
-     * by another input of the same operator.
+    /** 
+     * A copy of data which was observed at an input and is waiting to be
+     * displayed. The observed data itself is not accessed while it is buffered,
+     * i.e. it can be written by the stream again.
+     */
+    struct BufferedData
+    {
+        BufferedData(const stromx::runtime::Data & observedData, quint64 dataSequence)
+          : data(observedData.clone()), sequence(dataSequence) { arrival.start(); }
+        
+        QSharedPointer<stromx::runtime::Data> data;
+        quint64 sequence;
+        QTime arrival;
+    };
+    
+    /** Sets the data of the layer of \c input to \c data. */
+    void displayData(InputModel* input, const stromx::runtime::Data & data);
+    
+    /** Sets the data of each layer to the data of its input at \c position of the history. */
+    void displayHistory(int position);
+    
+    /** Clears the synchronization buffers. */
+    void clearBuffers();
+    
+    /** 
+     * Returns the newest sequence number which is buffered for all inputs.
+     * Returns false if no such sequence number exists.
      */
-    void disconnectInput(InputModel* input);
+    bool findMatchingSequence(quint64 & sequence) const;
     
     ObserverModel* m_observer;
+    DataRouter* m_router;
     AbstractDataVisualizer* m_visualizer;
     QList<InputModel*> m_inputs;
+    QHash<InputModel*, QList<BufferedData> > m_buffers;
+    QTimer* m_latencyTimer;
+    bool m_live;
 };
 
 #endif // DATAMANAGER_H
@@ -0,0 +1,92 @@
+#include "DataRouter.h"
+
+#include <stromx/runtime/ReadAccess.h>
+
+#include "DataManager.h"
+#include "model/InputModel.h"
+#include "model/OperatorModel.h"
+
+DataRouter::DataRouter(QObject* parent)
+  : QObject(parent)
+{
+}
+
+void DataRouter::subscribe(InputModel* input, DataManager* manager)
+{
+    Key key(input->op(), input->id());
+    QList<Subscription> & subscriptions = m_subscriptions[key];
+
+    // the first subscription of an input starts the observation of its data
+    if(subscriptions.isEmpty())
+        input->op()->setObserveData(input->id(), true);
+
+    subscriptions.append(Subscription(manager, input));
+
+    connect(manager, SIGNAL(destroyed(QObject*)), this, SLOT(removeManager(QObject*)), Qt::UniqueConnection);
+}
+
+void DataRouter::unsubscribe(InputModel* input, DataManager* manager)
+{
+    Key key(input->op(), input->id());
+    QHash<Key, QList<Subscription> >::iterator iter = m_subscriptions.find(key);
+    if(iter == m_subscriptions.end())
+        return;
+
+    iter.value().removeOne(Subscription(manager, input));
+
+    // the last subscription of an input stops the observation of its data
+    if(iter.value().isEmpty())
+    {
+        m_subscriptions.erase(iter);
+        input->op()->setObserveData(input->id(), false);
+    }
+}
+
+int DataRouter::numSubscriptions(OperatorModel* op, unsigned int id) const
+{
+    return m_subscriptions.value(Key(op, id)).count();
+}
+
+void DataRouter::route(OperatorModel* op, unsigned int id, const stromx::runtime::ReadAccess& access,
+                       quint64 sequence)
+{
+    QHash<Key, QList<Subscription> >::const_iterator iter = m_subscriptions.constFind(Key(op, id));
+    if(iter == m_subscriptions.constEnd())
+        return;
+    
+    if(access.empty())
+        return;
+    
+    // cache the items rendered from the data while it is delivered and forget
+    // them before the access is released
+    m_renderCache.setFrame(op, id, access.get());
+
+    foreach(const Subscription & subscription, iter.value())
+        subscription.first->setInputData(subscription.second, access, sequence);
+    
+    m_renderCache.removeFrame(op, id);
+}
+
+void DataRouter::removeManager(QObject* manager)
+{
+    QHash<Key, QList<Subscription> >::iterator iter = m_subscriptions.begin();
+    while(iter != m_subscriptions.end())
+    {
+        QList<Subscription> & subscriptions = iter.value();
+        for(int i = subscriptions.count() - 1; i >= 0; --i)
+        {
+            if(static_cast<QObject*>(subscriptions[i].first) == manager)
+                subscriptions.removeAt(i);
+        }
+
+        if(subscriptions.isEmpty())
+        {
+            iter.key().first->setObserveData(iter.key().second, false);
+            iter = m_subscriptions.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DATAROUTER_H
+#define DATAROUTER_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+
+#include "visualization/RenderCache.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class ReadAccess;
+    }
+}
+
+class DataManager;
+class InputModel;
+class OperatorModel;
+
+/**
+ * \brief Router of observed connector data
+ *
+ * The data router delivers the data observed at operator inputs to the data
+ * managers which display it. Each data manager subscribes the input models of
+ * its layers at the router. The subscriptions are indexed by operator and input
+ * ID such that each data object is only passed to the layers which actually
+ * display it.
+ *
+ * The router counts the subscriptions per operator input. Data observation is
+ * enabled at an operator input when the first subscription is added and
+ * disabled when the last subscription is removed.
+ * 
+ * While the data is passed to the subscribers it is set as the current frame
+ * of its input in the render cache of the router. This way data which is
+ * displayed by several layers is converted to graphics items only once. The
+ * router does not keep any access to the data after it has been routed.
+ */
+class DataRouter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** Constructs an empty data router. */
+    explicit DataRouter(QObject* parent = 0);
+
+    /**
+     * Routes the data at the input of \c input to \c manager. Data observation
+     * is enabled if this is the first subscription of the operator input.
+     */
+    void subscribe(InputModel* input, DataManager* manager);
+
+    /**
+     * Stops routing the data at the input of \c input to \c manager. Data
+     * observation is disabled if this was the last subscription of the operator
+     * input.
+     */
+    void unsubscribe(InputModel* input, DataManager* manager);
+
+    /** Returns the number of subscriptions of the input \c id of \c op. */
+    int numSubscriptions(OperatorModel* op, unsigned int id) const;
+
+    /**
+     * Passes \c access to all subscribers of the input \c id of \c op.
+     * This function is called by the operator model whenever new data
+     * was observed. The \c sequence is the number of data objects which
+     * were set to the input since the stream was started.
+     */
+    void route(OperatorModel* op, unsigned int id, const stromx::runtime::ReadAccess & access,
+               quint64 sequence);
+    
+    /** Returns the cache of the graphics items created from the routed data. */
+    RenderCache* renderCache() { return &m_renderCache; }
+
+private slots:
+    /** Removes all subscriptions of a data manager which is being destroyed. */
+    void removeManager(QObject* manager);
+
+private:
+    typedef QPair<OperatorModel*, unsigned int> Key;
+    typedef QPair<DataManager*, InputModel*> Subscription;
+
+    QHash<Key, QList<Subscription> > m_subscriptions;
+    RenderCache m_renderCache;
+};
+
+#endif // DATAROUTER_H
@@ -0,0 +1,463 @@
+#include "DeferredParameters.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <QtDebug>
+#include <memory>
+#include <stromx/runtime/Data.h>
+#include <stromx/runtime/DataRef.h>
+#include <stromx/runtime/DirectoryFileInput.h>
+#include <stromx/runtime/Exception.h>
+#include <stromx/runtime/Factory.h>
+#include <stromx/runtime/Operator.h>
+#include <stromx/runtime/Stream.h>
+#include <stromx/runtime/Version.h>
+#include <stromx/runtime/ZipFileInput.h>
+#include "MemoryFileOutput.h"
+#include "model/OperatorLibraryModel.h"
+
+namespace
+{
+    stromx::runtime::Version toVersion(const QString & version)
+    {
+        QStringList numbers = version.split('.');
+        while(numbers.count() < 3)
+            numbers.append("0");
+        
+        return stromx::runtime::Version(numbers[0].toUInt(), numbers[1].toUInt(), numbers[2].toUInt());
+    }
+    
+    QString toElement(const DeferredParameters::Parameter & parameter)
+    {
+        QString element;
+        QXmlStreamWriter writer(&element);
+        writer.writeStartElement("Parameter");
+        writer.writeAttribute("id", QString::number(parameter.parameterId));
+        writer.writeStartElement("Data");
+        writer.writeAttribute("file", parameter.file);
+        writer.writeAttribute("package", parameter.package);
+        writer.writeAttribute("type", parameter.type);
+        writer.writeAttribute("version", parameter.version);
+        writer.writeCharacters(parameter.text);
+        writer.writeEndElement();
+        writer.writeEndElement();
+        
+        return element;
+    }
+    
+    QString targetFilename(const QString & file, const QString & basename)
+    {
+        // files of other streams in the same directory must not be replaced
+        QString prefix = basename + "_";
+        return file.startsWith(prefix) ? file : prefix + file;
+    }
+    
+    void splitFilename(const QString & filename, QString & basename, QString & extension)
+    {
+        int dot = filename.lastIndexOf('.');
+        basename = dot < 0 ? filename : filename.left(dot);
+        extension = dot < 0 ? QString() : filename.mid(dot);
+    }
+    
+    struct Replacement
+    {
+        qint64 start;
+        qint64 end;
+        QString text;
+    };
+}
+
+QByteArray DeferredParameters::extract(const QByteArray& streamXml, QList<Parameter>& parameters)
+{
+    QString xml = QString::fromUtf8(streamXml);
+    QXmlStreamReader reader(xml);
+    
+    QList<Parameter> extracted;
+    QList<QPair<qint64, qint64> > removedRanges;
+    bool isInitializedOperator = false;
+    unsigned int operatorId = 0;
+    
+    while(! reader.atEnd())
+    {
+        qint64 tokenStart = reader.characterOffset();
+        reader.readNext();
+        
+        // the modified description is encoded as UTF-8 and must not declare another encoding
+        if(reader.isStartDocument() && ! reader.documentEncoding().isEmpty()
+           && reader.documentEncoding().toString().toUpper() != "UTF-8")
+        {
+            return streamXml;
+        }
+        
+        if(reader.isStartElement() && reader.name() == QLatin1String("Operator"))
+        {
+            operatorId = reader.attributes().value("id").toString().toUInt();
+            isInitializedOperator = reader.attributes().value("isInitialized") == QLatin1String("true");
+        }
+        else if(reader.isEndElement() && reader.name() == QLatin1String("Operator"))
+        {
+            isInitializedOperator = false;
+        }
+        else if(reader.isStartElement() && reader.name() == QLatin1String("Parameter") && isInitializedOperator)
+        {
+            Parameter parameter;
+            parameter.operatorId = operatorId;
+            parameter.parameterId = reader.attributes().value("id").toString().toUInt();
+            
+            // only parameters with exactly one data element are deferred
+            int numElements = 0;
+            while(! reader.atEnd())
+            {
+                reader.readNext();
+                if(reader.isEndElement() && reader.name() == QLatin1String("Parameter"))
+                    break;
+                
+                if(! reader.isStartElement())
+                    continue;
+                
+                numElements++;
+                if(reader.name() == QLatin1String("Data"))
+                {
+                    QXmlStreamAttributes attributes = reader.attributes();
+                    parameter.package = attributes.value("package").toString();
+                    parameter.type = attributes.value("type").toString();
+                    parameter.version = attributes.value("version").toString();
+                    parameter.file = attributes.value("file").toString();
+                    parameter.text = reader.readElementText();
+                }
+                else
+                {
+                    reader.skipCurrentElement();
+                }
+            }
+            
+            if(numElements == 1 && ! parameter.file.isEmpty() && ! reader.hasError())
+            {
+                extracted.append(parameter);
+                removedRanges.append(qMakePair(tokenStart, reader.characterOffset()));
+            }
+        }
+    }
+    
+    if(reader.hasError())
+    {
+        qWarning() << "Failed to parse stream description:" << reader.errorString();
+        return streamXml;
+    }
+    
+    if(extracted.isEmpty())
+        return streamXml;
+    
+    QString result;
+    result.reserve(xml.size());
+    qint64 position = 0;
+    for(int i = 0; i < removedRanges.count(); ++i)
+    {
+        result.append(xml.mid(position, removedRanges[i].first - position));
+        position = removedRanges[i].second;
+    }
+    result.append(xml.mid(position));
+    
+    parameters.append(extracted);
+    return result.toUtf8();
+}
+
+DeferredParameters::DeferredParameters(const QString& filepath, const QList<Parameter>& parameters,
+                                       stromx::runtime::Stream* stream, OperatorLibraryModel* operatorLibrary)
+  : m_filepath(filepath),
+    m_operatorLibrary(operatorLibrary)
+{
+    const std::vector<stromx::runtime::Operator*> & operators = stream->operators();
+    foreach(const Parameter & parameter, parameters)
+    {
+        if(parameter.operatorId < operators.size())
+            m_parameters[operators[parameter.operatorId]][parameter.parameterId] = parameter;
+    }
+}
+
+bool DeferredParameters::contains(const stromx::runtime::Operator* op, unsigned int id) const
+{
+    QHash<const stromx::runtime::Operator*, QMap<unsigned int, Parameter> >::const_iterator iter 
+        = m_parameters.find(op);
+    
+    return iter != m_parameters.end() && iter.value().contains(id);
+}
+
+bool DeferredParameters::load(stromx::runtime::Operator* op, unsigned int id, stromx::runtime::DataRef& value,
+                              QString & error)
+{
+    if(! contains(op, id))
+        return false;
+    
+    const Parameter parameter = m_parameters[op][id];
+    
+    std::auto_ptr<stromx::runtime::FileInput> input(openFile(error));
+    if(! input.get())
+        return false;
+    
+    try
+    {
+        input->initialize(parameter.text.toStdString(), parameter.file.toStdString());
+        stromx::runtime::Data* data = m_operatorLibrary->factory()->newData(parameter.package.toStdString(),
+                                                                            parameter.type.toStdString());
+        value = stromx::runtime::DataRef(data);
+        data->deserialize(*input, toVersion(parameter.version));
+        op->setParameter(id, *data);
+    }
+    catch(stromx::runtime::Exception & e)
+    {
+        // the parameter remains deferred such that its actual value is not
+        // replaced by the default value when the stream is written
+        qWarning() << "Failed to load parameter" << id << "from" << parameter.file << ":" << e.what();
+        error = QObject::tr("Failed to load the value from %1: %2").arg(parameter.file, QString::fromStdString(e.what()));
+        value = stromx::runtime::DataRef();
+        return false;
+    }
+    
+    remove(op, id);
+    return true;
+}
+
+void DeferredParameters::remove(const stromx::runtime::Operator* op, unsigned int id)
+{
+    QHash<const stromx::runtime::Operator*, QMap<unsigned int, Parameter> >::iterator iter 
+        = m_parameters.find(op);
+    if(iter == m_parameters.end())
+        return;
+    
+    iter.value().remove(id);
+    if(iter.value().isEmpty())
+        m_parameters.erase(iter);
+}
+
+void DeferredParameters::remove(const stromx::runtime::Operator* op)
+{
+    m_parameters.remove(op);
+}
+
+void DeferredParameters::setFilepath(const QString& filepath, const QString& basename)
+{
+    m_filepath = filepath;
+    
+    // the files have been renamed by writeThrough()
+    typedef QHash<const stromx::runtime::Operator*, QMap<unsigned int, Parameter> >::iterator OperatorIterator;
+    for(OperatorIterator opIter = m_parameters.begin(); opIter != m_parameters.end(); ++opIter)
+    {
+        for(QMap<unsigned int, Parameter>::iterator iter = opIter.value().begin(); iter != opIter.value().end(); ++iter)
+            iter.value().file = targetFilename(iter.value().file, basename);
+    }
+}
+
+bool DeferredParameters::writeThrough(MemoryFileOutput& output, const QString& basename,
+                                      const stromx::runtime::Stream& stream, QString& error) const
+{
+    output.close();
+    
+    // the deferred parameters of the operators which are written and the names
+    // of their files in the output
+    const std::vector<stromx::runtime::Operator*> & operators = stream.operators();
+    QList<Parameter> parameters;
+    QList<Parameter> targetParameters;
+    QSet<QString> deferredFiles;
+    for(std::vector<stromx::runtime::Operator*>::const_iterator iter = operators.begin();
+        iter != operators.end(); ++iter)
+    {
+        QMap<unsigned int, Parameter> opParameters = m_parameters.value(*iter);
+        for(QMap<unsigned int, Parameter>::iterator paramIter = opParameters.begin();
+            paramIter != opParameters.end(); ++paramIter)
+        {
+            parameters.append(paramIter.value());
+            paramIter.value().file = targetFilename(paramIter.value().file, basename);
+            targetParameters.append(paramIter.value());
+            deferredFiles.insert(paramIter.value().file);
+        }
+    }
+    
+    if(parameters.isEmpty())
+        return true;
+    
+    std::string xmlFile = (basename + ".xml").toStdString();
+    if(! output.hasFile(xmlFile))
+    {
+        error = QObject::tr("The stream description %1 was not written.").arg(QString::fromStdString(xmlFile));
+        return false;
+    }
+    
+    std::string xmlContent = output.content(xmlFile);
+    QString xml = QString::fromUtf8(xmlContent.data(), int(xmlContent.size()));
+    QXmlStreamReader reader(xml);
+    
+    QList<Replacement> replacements;
+    QStringList removedFiles;
+    QMap<QString, QString> renamedFiles;
+    const QMap<unsigned int, Parameter>* operatorParameters = 0;
+    
+    while(! reader.atEnd())
+    {
+        qint64 tokenStart = reader.characterOffset();
+        reader.readNext();
+        
+        if(reader.isStartDocument() && ! reader.documentEncoding().isEmpty()
+           && reader.documentEncoding().toString().toUpper() != "UTF-8")
+        {
+            error = QObject::tr("The stream description is not encoded as UTF-8.");
+            return false;
+        }
+        
+        if(reader.isStartElement() && reader.name() == QLatin1String("Operator"))
+        {
+            unsigned int operatorId = reader.attributes().value("id").toString().toUInt();
+            operatorParameters = 0;
+            if(operatorId < operators.size())
+            {
+                QHash<const stromx::runtime::Operator*, QMap<unsigned int, Parameter> >::const_iterator iter
+                    = m_parameters.find(operators[operatorId]);
+                if(iter != m_parameters.end())
+                    operatorParameters = &iter.value();
+            }
+        }
+        else if(reader.isEndElement() && reader.name() == QLatin1String("Operator"))
+        {
+            operatorParameters = 0;
+        }
+        else if(reader.isStartElement() && reader.name() == QLatin1String("Parameter") && operatorParameters)
+        {
+            unsigned int parameterId = reader.attributes().value("id").toString().toUInt();
+            if(! operatorParameters->contains(parameterId))
+                continue;
+            
+            // the files of the default value are replaced by the files of the actual value
+            while(! reader.atEnd())
+            {
+                reader.readNext();
+                if(reader.isEndElement() && reader.name() == QLatin1String("Parameter"))
+                    break;
+                
+                if(reader.isStartElement() && ! reader.attributes().value("file").isEmpty())
+                    removedFiles.append(reader.attributes().value("file").toString());
+            }
+            
+            Parameter parameter = operatorParameters->value(parameterId);
+            parameter.file = targetFilename(parameter.file, basename);
+            
+            Replacement replacement;
+            replacement.start = tokenStart;
+            replacement.end = reader.characterOffset();
+            replacement.text = toElement(parameter);
+            replacements.append(replacement);
+        }
+        else if(reader.isStartElement() && reader.name() == QLatin1String("Data"))
+        {
+            QString file = reader.attributes().value("file").toString();
+            if(! deferredFiles.contains(file))
+                continue;
+            
+            // another parameter was written to a file of a deferred parameter
+            QString fileBasename;
+            QString extension;
+            splitFilename(file, fileBasename, extension);
+            
+            QString renamedFile;
+            int index = 1;
+            do
+            {
+                renamedFile = QString("%1_%2%3").arg(fileBasename).arg(index++).arg(extension);
+            }
+            while(output.hasFile(renamedFile.toStdString()) || deferredFiles.contains(renamedFile)
+                  || renamedFiles.values().contains(renamedFile));
+            
+            Replacement replacement;
+            replacement.start = tokenStart;
+            replacement.end = reader.characterOffset();
+            replacement.text = xml.mid(tokenStart, replacement.end - tokenStart);
+            
+            QString quotedFile = QString("\"%1\"").arg(file);
+            if(! replacement.text.contains(quotedFile))
+            {
+                error = QObject::tr("The file %1 can not be renamed.").arg(file);
+                return false;
+            }
+            replacement.text.replace(quotedFile, QString("\"%1\"").arg(renamedFile));
+            
+            renamedFiles[file] = renamedFile;
+            replacements.append(replacement);
+        }
+    }
+    
+    if(reader.hasError())
+    {
+        qWarning() << "Failed to parse stream description:" << reader.errorString();
+        error = QObject::tr("Failed to parse the stream description: %1").arg(reader.errorString());
+        return false;
+    }
+    
+    // the files are copied when the output is written but the stream file must
+    // be readable now
+    std::auto_ptr<stromx::runtime::FileInput> input(openFile(error));
+    if(! input.get())
+        return false;
+    
+    QString result;
+    result.reserve(xml.size());
+    qint64 position = 0;
+    foreach(const Replacement & replacement, replacements)
+    {
+        result.append(xml.mid(position, replacement.start - position));
+        result.append(replacement.text);
+        position = replacement.end;
+    }
+    result.append(xml.mid(position));
+    
+    QByteArray resultData = result.toUtf8();
+    output.setContent(xmlFile, std::string(resultData.constData(), resultData.size()));
+    
+    foreach(const QString & file, removedFiles)
+        output.removeFile(file.toStdString());
+    
+    for(QMap<QString, QString>::const_iterator iter = renamedFiles.begin(); iter != renamedFiles.end(); ++iter)
+    {
+        QString fileBasename;
+        QString extension;
+        splitFilename(iter.value(), fileBasename, extension);
+        output.renameFile(iter.key().toStdString(), fileBasename.toStdString(), extension.toStdString());
+    }
+    
+    for(int i = 0; i < targetParameters.count(); ++i)
+    {
+        QString fileBasename;
+        QString extension;
+        splitFilename(targetParameters[i].file, fileBasename, extension);
+        
+        output.removeFile(targetParameters[i].file.toStdString());
+        output.copyFile(fileBasename.toStdString(), extension.toStdString(),
+                        m_filepath.toStdString(), parameters[i].file.toStdString());
+    }
+    
+    return true;
+}
+
+stromx::runtime::FileInput* DeferredParameters::openFile(QString & error) const
+{
+    try
+    {
+        if(QFileInfo(m_filepath).suffix() == "xml")
+        {
+            QString location = QFileInfo(m_filepath).absoluteDir().absolutePath();
+            return new stromx::runtime::DirectoryFileInput(location.toStdString());
+        }
+        
+        return new stromx::runtime::ZipFileInput(m_filepath.toStdString());
+    }
+    catch(stromx::runtime::FileAccessFailed & e)
+    {
+        qWarning() << e.what();
+        error = QObject::tr("The file %1 could not be opened.").arg(m_filepath);
+        return 0;
+    }
+}
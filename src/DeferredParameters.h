@@ -0,0 +1,158 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef DEFERREDPARAMETERS_H
+#define DEFERREDPARAMETERS_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class DataRef;
+        class FileInput;
+        class Operator;
+        class Stream;
+    }
+}
+
+class MemoryFileOutput;
+class OperatorLibraryModel;
+
+/**
+ * \brief Parameters of a stream which are loaded on demand
+ * 
+ * Large parameter values such as images are stored in separate files of a
+ * stream file and referenced by the stream description. Usually all of them
+ * are deserialized when the stream is read. To speed up the opening of large
+ * streams the file references of initialized operators are removed from the
+ * stream description by extract() before it is passed to stromx. The removed
+ * parameters are described by a list of parameters which is passed to an object
+ * of this class.
+ * 
+ * Such a deferred parameter keeps the default value of the operator until it is
+ * loaded from the stream file by load(). This happens when its value is accessed
+ * for the first time or when the complete stream is required, i.e. before it is 
+ * started. Afterwards it is not deferred anymore. If the loading fails the
+ * parameter remains deferred, i.e. the default value of the operator is never
+ * mistaken for its actual value. When the stream is written the deferred
+ * parameters are copied from the stream file by writeThrough() without loading
+ * them. The names of the copied files only depend on their original names and
+ * the basename of the written stream. I.e. a stream which is repeatedly written
+ * to the same file keeps the names of its files and the parameters can still be
+ * loaded after the stream file has been replaced by the written stream.
+ */
+class DeferredParameters
+{
+public:
+    /** Description of a parameter which was removed from the stream. */
+    struct Parameter
+    {
+        unsigned int operatorId;
+        unsigned int parameterId;
+        QString package;
+        QString type;
+        QString version;
+        QString text;
+        QString file;
+    };
+    
+    /**
+     * Removes the file-backed parameters of initialized operators from the stream
+     * description \c streamXml and appends them to \c parameters. Returns the
+     * modified stream description. If the description can not be parsed it is 
+     * returned unchanged and no parameters are appended. This function can be
+     * called from any thread.
+     */
+    static QByteArray extract(const QByteArray & streamXml, QList<Parameter> & parameters);
+    
+    /** 
+     * Constructs deferred parameters for the operators of \c stream. The values
+     * are read from the stream file at \c filepath and deserialized by the factory
+     * of \c operatorLibrary.
+     */
+    DeferredParameters(const QString & filepath, const QList<Parameter> & parameters, 
+                       stromx::runtime::Stream* stream, OperatorLibraryModel* operatorLibrary);
+    
+    /** Returns true if no parameter is deferred. */
+    bool isEmpty() const { return m_parameters.isEmpty(); }
+    
+    /** Returns true if the parameter \c id of \c op has not been loaded yet. */
+    bool contains(const stromx::runtime::Operator* op, unsigned int id) const;
+    
+    /** 
+     * Loads the parameter \c id of \c op from the stream file, sets it at the 
+     * operator and stores it in \c value. The parameter is not deferred anymore
+     * afterwards. Returns false and describes the reason in \c error if the
+     * parameter could not be loaded. In this case it remains deferred.
+     */
+    bool load(stromx::runtime::Operator* op, unsigned int id, stromx::runtime::DataRef & value,
+              QString & error);
+    
+    /** 
+     * Removes the parameter \c id of \c op without loading it. This function is
+     * called if the value of the parameter is replaced.
+     */
+    void remove(const stromx::runtime::Operator* op, unsigned int id);
+    
+    /** Removes all parameters of \c op without loading them. */
+    void remove(const stromx::runtime::Operator* op);
+    
+    /** 
+     * Replaces the deferred parameters of \c stream in the stream description 
+     * \c basename.xml of \c output by their descriptions in the stream file and
+     * adds copies of the files which contain their values to \c output. These
+     * are only read from the stream file when \c output is written to another 
+     * output. The copied files are prefixed by \c basename unless their
+     * names already start with it. The files which were written for the default
+     * values of the parameters are removed from \c output. Files of other
+     * parameters which have the same name as a copied file are renamed. Returns
+     * false and describes the reason in \c error if the stream description can
+     * not be parsed or the stream file can not be read. In this case \c output
+     * is not changed.
+     */
+    bool writeThrough(MemoryFileOutput & output, const QString & basename,
+                      const stromx::runtime::Stream & stream, QString & error) const;
+    
+    /** 
+     * Reads the deferred parameters from the file at \c filepath from now on.
+     * Call this function after the stream has been written to \c filepath by
+     * passing \c basename to writeThrough().
+     */
+    void setFilepath(const QString & filepath, const QString & basename);
+    
+private:
+    /** 
+     * Opens the stream file. Returns 0 and describes the reason in \c error if
+     * it can not be opened.
+     */
+    stromx::runtime::FileInput* openFile(QString & error) const;
+    
+    QString m_filepath;
+    OperatorLibraryModel* m_operatorLibrary;
+    QHash<const stromx::runtime::Operator*, QMap<unsigned int, Parameter> > m_parameters;
+};
+
+#endif // DEFERREDPARAMETERS_H
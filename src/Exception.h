@@ -65,4 +65,16 @@ public:
     WriteStreamFailed(const QString & message = "") : Exception(message) {}
 };
 
+class ReadCaptureFailed : public Exception
+{
+public:
+    ReadCaptureFailed(const QString & message = "") : Exception(message) {}
+};
+
+class WriteCaptureFailed : public Exception
+{
+public:
+    WriteCaptureFailed(const QString & message = "") : Exception(message) {}
+};
+
 #endif // EXCEPTION_H
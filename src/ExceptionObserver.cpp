@@ -2,7 +2,8 @@
 
 #include <QCoreApplication>
 #include "event/ErrorEvent.h"
-#include "data/ErrorData.h"
+
+const int ExceptionObserver::MAX_PENDING_ERRORS = 100;
 
 ExceptionObserver::ExceptionObserver(QObject* receiver)
   : m_receiver(receiver)
@@ -20,6 +21,34 @@ void ExceptionObserver::observe(const stromx::runtime::ExceptionObserver::Phase
 
 void ExceptionObserver::sendErrorData(const ErrorData& data) const
 {
-    QEvent* event = new ErrorEvent(data);
-    QCoreApplication::instance()->postEvent(m_receiver, event);
+    QMutexLocker lock(&m_mutex);
+    
+    // the receiver has been notified if there are pending errors
+    bool notify = m_pendingErrors.isEmpty();
+    
+    for(QList<ErrorData>::iterator iter = m_pendingErrors.begin(); iter != m_pendingErrors.end(); ++iter)
+    {
+        if(iter->isSameError(data))
+        {
+            iter->merge(data);
+            return;
+        }
+    }
+    
+    m_pendingErrors.append(data);
+    if(m_pendingErrors.count() > MAX_PENDING_ERRORS)
+        m_pendingErrors.removeFirst();
+    
+    if(notify)
+        QCoreApplication::instance()->postEvent(m_receiver, new ErrorEvent);
+}
+
+QList<ErrorData> ExceptionObserver::takeErrors()
+{
+    QMutexLocker lock(&m_mutex);
+    
+    QList<ErrorData> errors = m_pendingErrors;
+    m_pendingErrors.clear();
+    
+    return errors;
 }
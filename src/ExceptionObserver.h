@@ -20,26 +20,49 @@
 #ifndef EXCEPTIONOBSERVER_H
 #define EXCEPTIONOBSERVER_H
 
+#include <QList>
 #include <QMutex>
 #include <stromx/runtime/ExceptionObserver.h>
 
+#include "data/ErrorData.h"
+
 class QObject;
-class ErrorData;
 
+/** 
+ * \brief Observer which collects the errors of a stream.
+ * 
+ * The observer buffers the errors it receives from the stromx threads and
+ * merges repeated occurrences of the same error. Whenever the first error
+ * is added to the empty buffer an ErrorEvent is posted to the receiver which
+ * is expected to collect the errors by calling takeErrors(). This way an
+ * operator which fails at a high rate does not flood the event loop of the
+ * receiver.
+ */
 class ExceptionObserver : public stromx::runtime::ExceptionObserver
 {
 public:
+    /** 
+     * The maximal number of different errors which are buffered. If it is
+     * exceeded the oldest errors are dropped.
+     */
+    static const int MAX_PENDING_ERRORS;
+    
     ExceptionObserver(QObject* receiver);
     
     virtual void observe(const stromx::runtime::ExceptionObserver::Phase phase,
                          const stromx::runtime::OperatorError & ex,
                          const stromx::runtime::Thread* const thread) const;
                          
+    /** Adds \c data to the buffered errors and notifies the receiver if necessary. */
     void sendErrorData(const ErrorData &data) const;
+    
+    /** Returns the buffered errors and clears the buffer. */
+    QList<ErrorData> takeErrors();
                          
 private:
     mutable QMutex m_mutex;
     QObject* m_receiver;
+    mutable QList<ErrorData> m_pendingErrors;
 };
 
 #endif // EXCEPTIONOBSERVER_H
@@ -0,0 +1,176 @@
+#include "FrameHistory.h"
+
+#include <stromx/runtime/Data.h>
+#include <stromx/runtime/Matrix.h>
+#include <stromx/runtime/String.h>
+#include <stromx/runtime/Variant.h>
+
+const int FrameHistory::DEFAULT_MAX_FRAMES_PER_INPUT = 100;
+const qint64 FrameHistory::DEFAULT_MEMORY_BUDGET = 256 * 1024 * 1024;
+
+namespace
+{
+    // rough estimate of the memory allocated by a data object without buffer
+    const qint64 DATA_OVERHEAD = 64;
+}
+
+FrameHistory::FrameHistory(QObject* parent)
+  : QObject(parent),
+    m_recording(false),
+    m_maxFramesPerInput(DEFAULT_MAX_FRAMES_PER_INPUT),
+    m_memoryBudget(DEFAULT_MEMORY_BUDGET),
+    m_memoryUsage(0)
+{
+}
+
+void FrameHistory::setRecording(bool recording)
+{
+    m_recording = recording;
+}
+
+void FrameHistory::setMaxFramesPerInput(int maxFrames)
+{
+    m_maxFramesPerInput = maxFrames >= 0 ? maxFrames : 0;
+
+    int numFrames = m_frames.count();
+    enforceLimits();
+    if(numFrames != m_frames.count())
+        emit numFramesChanged(m_frames.count());
+}
+
+void FrameHistory::setMemoryBudget(qint64 bytes)
+{
+    m_memoryBudget = bytes >= 0 ? bytes : 0;
+
+    int numFrames = m_frames.count();
+    enforceLimits();
+    if(numFrames != m_frames.count())
+        emit numFramesChanged(m_frames.count());
+}
+
+InputModel* FrameHistory::input(int position) const
+{
+    if(position < 0 || position >= m_frames.count())
+        return 0;
+
+    return m_frames[position].input;
+}
+
+const stromx::runtime::Data* FrameHistory::data(InputModel* input, int position) const
+{
+    if(position >= m_frames.count())
+        position = m_frames.count() - 1;
+
+    for(int i = position; i >= 0; --i)
+    {
+        if(m_frames[i].input == input)
+            return m_frames[i].data.data();
+    }
+
+    return 0;
+}
+
+void FrameHistory::record(InputModel* input, const stromx::runtime::Data& data)
+{
+    if(! m_recording || m_maxFramesPerInput == 0)
+        return;
+
+    qint64 size = dataSize(data);
+    if(size > m_memoryBudget)
+        return;
+
+    Frame frame;
+    frame.input = input;
+    frame.data = QSharedPointer<stromx::runtime::Data>(data.clone());
+    frame.size = size;
+
+    m_frames.append(frame);
+    m_numFramesPerInput[input]++;
+    m_memoryUsage += size;
+
+    enforceLimits();
+    emit numFramesChanged(m_frames.count());
+}
+
+void FrameHistory::removeInput(InputModel* input)
+{
+    if(! m_numFramesPerInput.contains(input))
+        return;
+
+    for(int i = m_frames.count() - 1; i >= 0; --i)
+    {
+        if(m_frames[i].input == input)
+            removeFrame(i);
+    }
+
+    emit numFramesChanged(m_frames.count());
+}
+
+void FrameHistory::clear()
+{
+    m_frames.clear();
+    m_numFramesPerInput.clear();
+    m_memoryUsage = 0;
+
+    emit numFramesChanged(0);
+}
+
+qint64 FrameHistory::dataSize(const stromx::runtime::Data& data)
+{
+    // images are matrices as well
+    if(data.isVariant(stromx::runtime::Variant::MATRIX))
+    {
+        const stromx::runtime::Matrix & matrix = stromx::runtime::data_cast<stromx::runtime::Matrix>(data);
+        return DATA_OVERHEAD + matrix.bufferSize();
+    }
+
+    if(data.isVariant(stromx::runtime::Variant::STRING))
+    {
+        const stromx::runtime::String & string = stromx::runtime::data_cast<stromx::runtime::String>(data);
+        return DATA_OVERHEAD + string.size();
+    }
+
+    return DATA_OVERHEAD;
+}
+
+void FrameHistory::removeFrame(int position)
+{
+    const Frame & frame = m_frames[position];
+
+    m_memoryUsage -= frame.size;
+    if(--m_numFramesPerInput[frame.input] == 0)
+        m_numFramesPerInput.remove(frame.input);
+
+    m_frames.removeAt(position);
+}
+
+void FrameHistory::enforceLimits()
+{
+    // drop the oldest frames of inputs with too many frames
+    QHash<InputModel*, int> exceedingFrames;
+    QHash<InputModel*, int>::const_iterator iter;
+    for(iter = m_numFramesPerInput.constBegin(); iter != m_numFramesPerInput.constEnd(); ++iter)
+    {
+        if(iter.value() > m_maxFramesPerInput)
+            exceedingFrames[iter.key()] = iter.value() - m_maxFramesPerInput;
+    }
+
+    for(int i = 0; i < m_frames.count() && ! exceedingFrames.isEmpty();)
+    {
+        InputModel* input = m_frames[i].input;
+        if(exceedingFrames.contains(input))
+        {
+            removeFrame(i);
+            if(--exceedingFrames[input] == 0)
+                exceedingFrames.remove(input);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // drop the oldest frames until the memory budget is met
+    while(m_memoryUsage > m_memoryBudget && ! m_frames.isEmpty())
+        removeFrame(0);
+}
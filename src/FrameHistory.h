@@ -0,0 +1,153 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMEHISTORY_H
+#define FRAMEHISTORY_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Data;
+    }
+}
+
+class InputModel;
+
+/**
+ * \brief History of the data displayed by an observer
+ *
+ * The frame history stores copies of the most recent data objects which were
+ * observed at the inputs of an observer. The frames of all inputs are kept in
+ * a common timeline in the order of their arrival. Each frame in the timeline
+ * is identified by its position, i.e. the oldest frame has the position 0.
+ *
+ * The history is a ring buffer: It keeps at most maxFramesPerInput() frames
+ * per input and at most memoryBudget() bytes of data in total. If any of these
+ * limits is exceeded the oldest frames are dropped.
+ *
+ * The history stores copies of the data instead of read accesses. This way
+ * operators which write to the observed data are never blocked by the history.
+ * Because each recorded frame is copied on the GUI thread recording must be
+ * explicitly started by setRecording().
+ */
+class FrameHistory : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** The default number of frames which are stored per input. */
+    static const int DEFAULT_MAX_FRAMES_PER_INPUT;
+
+    /** The default memory budget in bytes. */
+    static const qint64 DEFAULT_MEMORY_BUDGET;
+
+    /** Constructs an empty history which does not record. */
+    explicit FrameHistory(QObject* parent = 0);
+
+    /** Returns true if new frames are recorded. */
+    bool isRecording() const { return m_recording; }
+
+    /** Returns the maximal number of frames which are stored for each input. */
+    int maxFramesPerInput() const { return m_maxFramesPerInput; }
+
+    /**
+     * Sets the maximal number of frames which are stored for each input.
+     * Exceeding frames are dropped.
+     */
+    void setMaxFramesPerInput(int maxFrames);
+
+    /** Returns the maximal number of bytes stored by the history. */
+    qint64 memoryBudget() const { return m_memoryBudget; }
+
+    /**
+     * Sets the maximal number of bytes stored by the history. Exceeding frames
+     * are dropped.
+     */
+    void setMemoryBudget(qint64 bytes);
+
+    /** Returns the number of bytes which are currently stored by the history. */
+    qint64 memoryUsage() const { return m_memoryUsage; }
+
+    /** Returns the number of frames in the timeline. */
+    int numFrames() const { return m_frames.count(); }
+
+    /**
+     * Returns the input of the frame at \c position in the timeline or 0
+     * if no such frame exists.
+     */
+    InputModel* input(int position) const;
+
+    /**
+     * Returns the newest data which arrived at \c input before or at \c position
+     * of the timeline. Returns 0 if no such data exists.
+     */
+    const stromx::runtime::Data* data(InputModel* input, int position) const;
+
+    /**
+     * Appends a copy of \c data to the timeline. Does nothing if the history
+     * is not recording or if the data exceeds the memory budget.
+     */
+    void record(InputModel* input, const stromx::runtime::Data & data);
+
+    /** Removes all frames of \c input from the history. */
+    void removeInput(InputModel* input);
+
+    /** Returns an estimate of the number of bytes which are allocated by \c data. */
+    static qint64 dataSize(const stromx::runtime::Data & data);
+
+public slots:
+    /** Starts or stops recording new frames. */
+    void setRecording(bool recording);
+
+    /** Removes all frames from the history. */
+    void clear();
+
+signals:
+    /** The number of frames in the timeline changed. */
+    void numFramesChanged(int numFrames);
+
+private:
+    struct Frame
+    {
+        InputModel* input;
+        QSharedPointer<stromx::runtime::Data> data;
+        qint64 size;
+    };
+
+    /** Removes the frame at \c position from the timeline. */
+    void removeFrame(int position);
+
+    /** Drops the oldest frames until the history fits into its limits. */
+    void enforceLimits();
+
+    bool m_recording;
+    int m_maxFramesPerInput;
+    qint64 m_memoryBudget;
+    qint64 m_memoryUsage;
+    QList<Frame> m_frames;
+    QHash<InputModel*, int> m_numFramesPerInput;
+};
+
+#endif // FRAMEHISTORY_H
@@ -52,9 +52,59 @@ stromx::runtime::Data* Image::clone() const
     return new Image(*this);
 }
 
-void Image::allocate(const unsigned int, const unsigned int, const Image::PixelType)
+uint8_t* Image::data()
 {
-    throw stromx::runtime::NotImplemented("Image allocation is not implemented.");
+    // the data is about to be modified
+    detach();
+    
+    return ImageWrapper::data();
+}
+
+uint8_t* Image::buffer()
+{
+    // the data is about to be modified
+    detach();
+    
+    return ImageWrapper::buffer();
+}
+
+void Image::resize(const unsigned int width, const unsigned int height, const PixelType pixelType)
+{
+    // never reuse the data because it might be shared
+    allocate(width, height, pixelType);
+}
+
+void Image::allocate(const unsigned int width, const unsigned int height, const Image::PixelType pixelType)
+{
+    switch(pixelType)
+    {
+    case stromx::runtime::Image::MONO_8:
+    {
+        QVector<QRgb> colorTable;
+        for(int i = 0; i < 256; ++i)
+            colorTable.append(qRgb(i, i, i));
+        
+        m_image = QImage(width, height, QImage::Format_Indexed8);
+        m_image.setColorTable(colorTable);
+        break;
+    }
+    case stromx::runtime::Image::RGB_24:
+        m_image = QImage(width, height, QImage::Format_RGB888);
+        break;
+    default:
+        throw stromx::runtime::NotImplemented("Image allocation is only implemented for mono and RGB images.");
+    }
+    
+    initializeParent();
+}
+
+void Image::detach()
+{
+    if(! m_image.isNull() && ! m_image.isDetached())
+    {
+        m_image.detach();
+        initializeParent();
+    }
 }
 
 
@@ -74,8 +124,10 @@ void Image::initializeParent()
         m_image = QImage();
     }
     
-    setBuffer(reinterpret_cast<uint8_t*>(m_image.bits()), m_image.byteCount());
+    // the const access does not detach the data of a shared image
+    uint8_t* bits = const_cast<uint8_t*>(m_image.constBits());
+    setBuffer(bits, m_image.byteCount());
     
     initializeImage(m_image.width(), m_image.height(), m_image.bytesPerLine(),
-                    m_image.bits(), pixelType);
+                    bits, pixelType);
 }
@@ -25,7 +25,13 @@
 #include <stromx/runtime/ImageWrapper.h>
 #include <stromx/runtime/Version.h>
 
-/** \brief Stromx image wrapper for QImage objects. */
+/** 
+ * \brief Stromx image wrapper for QImage objects.
+ *
+ * Copies of an image share their pixel data like QImage objects do. The data
+ * is copied as soon as non-const access to the data or the buffer of a shared
+ * image is requested. Resizing an image always allocates new pixel data.
+ */
 class Image : public stromx::runtime::ImageWrapper
 {
 public:
@@ -44,6 +50,20 @@ public:
     
     virtual Data* clone() const;
     
+    using stromx::runtime::ImageWrapper::data;
+    
+    /** Returns the data of the image. The data is detached if it is shared. */
+    virtual uint8_t* data();
+    
+    /** Returns the buffer of the image. The data is detached if it is shared. */
+    virtual uint8_t* buffer();
+    
+    /** 
+     * Allocates new pixel data for the image. The data of copies of the image
+     * is not changed. Only the pixel types \c MONO_8 and \c RGB_24 are supported.
+     */
+    virtual void resize(const unsigned int width, const unsigned int height, const PixelType pixelType);
+    
 private:
     static const std::string TYPE;
     static const std::string PACKAGE;
@@ -58,6 +78,9 @@ private:
      */
     void initializeParent();
     
+    /** Copies the pixel data if it is shared with another image. */
+    void detach();
+    
     /** 
      * Helper function for the constructors which initializes the object 
      * from a QImage object.
@@ -1,11 +1,17 @@
 #include "LimitUndoStack.h"
 
+#include "FrameHistory.h"
 #include "UndoStackAction.h"
+#include "cmd/SetParameterCmd.h"
 
+const qint64 LimitUndoStack::DEFAULT_MEMORY_BUDGET = 256 * 1024 * 1024;
 
 LimitUndoStack::LimitUndoStack(QObject* parent)
   : QUndoStack(parent),
-    m_currentUndoLimit(0)
+    m_currentUndoLimit(0),
+    m_releaseLimit(0),
+    m_memoryBudget(DEFAULT_MEMORY_BUDGET),
+    m_memoryUsage(0)
 {
     connect(this, SIGNAL(canUndoChanged(bool)), this, SLOT(handleCanUndoChanged(bool)));
     connect(this, SIGNAL(indexChanged(int)), this, SLOT(handleUndoIndexChanged(int)));
@@ -25,7 +31,7 @@ QAction* LimitUndoStack::createLimitUndoAction(QObject* parent, const QString& p
 void LimitUndoStack::handleCanUndoChanged(bool canUndo)
 {
     // disable undo stack for any undo actions beyond the limit
-    if(index() == m_currentUndoLimit)
+    if(index() == undoLimit())
         emit undoActionEnabledChanged(false);
     else
         emit undoActionEnabledChanged(canUndo);
@@ -33,8 +39,15 @@ void LimitUndoStack::handleCanUndoChanged(bool canUndo)
 
 void LimitUndoStack::handleUndoIndexChanged(int /*index*/)
 {
+    // the stack has been cleared
+    if(count() == 0)
+        m_releaseLimit = 0;
+    
+    // commands might have been pushed or discarded
+    enforceMemoryBudget();
+    
     // disable undo stack for any undo actions beyond the limit
-    if(QUndoStack::index() == m_currentUndoLimit)
+    if(QUndoStack::index() == undoLimit())
         undoActionEnabledChanged(false);
 }
 
@@ -47,3 +60,69 @@ void LimitUndoStack::deactivateLimit()
 {
     m_currentUndoLimit = 0;
 }
+
+void LimitUndoStack::setMemoryBudget(qint64 bytes)
+{
+    m_memoryBudget = bytes >= 0 ? bytes : 0;
+    
+    enforceMemoryBudget();
+    if(index() == undoLimit())
+        emit undoActionEnabledChanged(false);
+}
+
+void LimitUndoStack::collectData(const QUndoCommand* command, QHash<const stromx::runtime::Data*, qint64>& data)
+{
+    const SetParameterCmd* setParameterCmd = dynamic_cast<const SetParameterCmd*>(command);
+    if(setParameterCmd)
+    {
+        if(! setParameterCmd->oldValue().isNull())
+        {
+            const stromx::runtime::Data & value = setParameterCmd->oldValue();
+            data[&value] = FrameHistory::dataSize(value);
+        }
+        
+        if(! setParameterCmd->newValue().isNull())
+        {
+            const stromx::runtime::Data & value = setParameterCmd->newValue();
+            data[&value] = FrameHistory::dataSize(value);
+        }
+    }
+    
+    for(int i = 0; i < command->childCount(); ++i)
+        collectData(command->child(i), data);
+}
+
+void LimitUndoStack::releaseData(QUndoCommand* command)
+{
+    SetParameterCmd* setParameterCmd = dynamic_cast<SetParameterCmd*>(command);
+    if(setParameterCmd)
+        setParameterCmd->releaseValues();
+    
+    for(int i = 0; i < command->childCount(); ++i)
+        releaseData(const_cast<QUndoCommand*>(command->child(i)));
+}
+
+void LimitUndoStack::updateMemoryUsage()
+{
+    QHash<const stromx::runtime::Data*, qint64> data;
+    for(int i = 0; i < count(); ++i)
+        collectData(command(i), data);
+    
+    m_memoryUsage = 0;
+    foreach(qint64 size, data)
+        m_memoryUsage += size;
+}
+
+void LimitUndoStack::enforceMemoryBudget()
+{
+    updateMemoryUsage();
+    
+    // only commands which have been done are released, i.e. the memory
+    // of commands which can be redone is released when they are discarded
+    while(m_memoryUsage > m_memoryBudget && m_releaseLimit < index())
+    {
+        releaseData(const_cast<QUndoCommand*>(command(m_releaseLimit)));
+        m_releaseLimit++;
+        updateMemoryUsage();
+    }
+}
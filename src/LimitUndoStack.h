@@ -20,8 +20,17 @@
 #ifndef LIMITUNDOSTACK_H
 #define LIMITUNDOSTACK_H
 
+#include <QHash>
 #include <QUndoStack>
 
+namespace stromx
+{
+    namespace runtime
+    {
+        class Data;
+    }
+}
+
 /** 
  * \brief Undo stack with a limit of undoable actions.
  *
@@ -32,12 +41,21 @@
  * activation no changes which happened before the start of the stream can 
  * be undone. This prevents e.g. the removal of an previously added operator
  * while the stream is active.
+ *
+ * In addition the stack keeps track of the approximate memory which is held
+ * by the parameter values of its commands. Data which is shared by several
+ * commands is counted only once. If the memory exceeds the memory budget the
+ * values of the oldest commands are released and these commands can not be
+ * undone anymore.
  */
 class LimitUndoStack : public QUndoStack
 {
     Q_OBJECT
     
 public:
+    /** The default memory budget in bytes. */
+    static const qint64 DEFAULT_MEMORY_BUDGET;
+    
     LimitUndoStack(QObject* parent = 0);
     
     QAction* createLimitUndoAction(QObject* parent, const QString & prefix = QString());
@@ -48,9 +66,24 @@ public:
      */ 
     void activateLimit();
     
-    /** Deactivates the limit, i.e. all undos are allowed. */
+    /** 
+     * Deactivates the limit, i.e. all undos are allowed except the ones of 
+     * commands whose values have been released.
+     */
     void deactivateLimit();
     
+    /** Returns the maximal number of bytes held by the commands on the stack. */
+    qint64 memoryBudget() const { return m_memoryBudget; }
+    
+    /** 
+     * Sets the maximal number of bytes held by the commands on the stack. The
+     * values of the oldest commands are released until the budget is met.
+     */
+    void setMemoryBudget(qint64 bytes);
+    
+    /** Returns the number of bytes which are currently held by the commands on the stack. */
+    qint64 memoryUsage() const { return m_memoryUsage; }
+    
 signals:
     void undoActionEnabledChanged(bool enabled);
     
@@ -59,7 +92,28 @@ private slots:
     void handleUndoIndexChanged(int index);
    
 private:
+    /** Returns the index below which no commands can be undone. */
+    int undoLimit() const { return qMax(m_currentUndoLimit, m_releaseLimit); }
+    
+    /** 
+     * Adds the data referenced by \c command and its children to \c data.
+     * Each data object is mapped to its size.
+     */
+    static void collectData(const QUndoCommand* command, QHash<const stromx::runtime::Data*, qint64> & data);
+    
+    /** Releases the data referenced by \c command and its children. */
+    static void releaseData(QUndoCommand* command);
+    
+    /** Recomputes the memory usage of the commands on the stack. */
+    void updateMemoryUsage();
+    
+    /** Releases the values of the oldest commands until the memory budget is met. */
+    void enforceMemoryBudget();
+    
     int m_currentUndoLimit;
+    int m_releaseLimit;
+    qint64 m_memoryBudget;
+    qint64 m_memoryUsage;
 };
 
 #endif // LIMITUNDOSTACK_H
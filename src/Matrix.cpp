@@ -13,8 +13,7 @@ Matrix::Matrix(const Matrix& matrix)
   : MatrixWrapper(),
     m_data(0)
 {
-    allocate(matrix.rows(), matrix.cols(), matrix.valueType());
-    memcpy(m_data, matrix.m_data, bufferSize());
+    share(matrix);
 }
 
 Matrix::Matrix(const unsigned int rows, const unsigned int cols, const Matrix::ValueType valueType)
@@ -30,29 +29,18 @@ stromx::runtime::Data* Matrix::clone() const
 
 Matrix::~Matrix()
 {
-    delete [] m_data;
-    m_data = 0;
 }
 
 const Matrix & Matrix::operator=(const Matrix& matrix)
 {
-    allocate(matrix.rows(), matrix.cols(), matrix.valueType());
-    memcpy(m_data, matrix.m_data, bufferSize());
+    share(matrix);
     
     return *this;
 }
 
 const Matrix& Matrix::operator=(const stromx::runtime::Matrix& matrix)
 {
-    allocate(matrix.rows(), matrix.cols(), matrix.valueType());
-    
-    for (unsigned int i = 0; i < rows(); ++i)
-    {
-        const uint8_t* srcRowPtr = matrix.data() + i * matrix.stride();
-        uint8_t* dstRowPtr = data() + i * stride();
-        unsigned int rowBytes = cols() * valueSize();
-        memcpy(dstRowPtr, srcRowPtr, rowBytes);
-    }
+    copy(matrix);
     
     return *this;
 }
@@ -60,29 +48,91 @@ const Matrix& Matrix::operator=(const stromx::runtime::Matrix& matrix)
 Matrix::Matrix(const stromx::runtime::Matrix& matrix)
   : m_data(0)
 {
+    copy(matrix);
+}
+
+uint8_t* Matrix::data()
+{
+    // the buffer is about to be modified
+    detach();
+    
+    return m_data;
+}
+
+uint8_t* Matrix::buffer()
+{
+    // the buffer is about to be modified
+    detach();
+    
+    return m_data;
+}
+
+void Matrix::resize(const unsigned int rows, const unsigned int cols, const ValueType valueType)
+{
+    // never reuse the buffer because it might be shared
+    allocate(rows, cols, valueType);
+}
+
+void Matrix::deserialize(stromx::runtime::InputProvider& input, const stromx::runtime::Version& version)
+{
+    // the data is read into the current buffer if it has the right size, make 
+    // sure it is not shared without copying data which is overwritten anyways
+    if(! m_buffer.isDetached())
+        allocate(rows(), cols(), valueType());
+    
+    MatrixWrapper::deserialize(input, version);
+}
+
+void Matrix::detach()
+{
+    if(! m_buffer.isDetached())
+    {
+        m_buffer.detach();
+        initializeParent(rows(), cols(), valueType());
+    }
+}
+
+void Matrix::allocate(const unsigned int rows, const unsigned int cols, const ValueType valueType)
+{
+    unsigned int valueSize = Matrix::valueSize(valueType);
+    unsigned int bufferSize = rows * cols * valueSize;
+    m_buffer = QByteArray(bufferSize, Qt::Uninitialized);
+    
+    initializeParent(rows, cols, valueType);
+}
+
+void Matrix::share(const Matrix& matrix)
+{
+    m_buffer = matrix.m_buffer;
+    initializeParent(matrix.rows(), matrix.cols(), matrix.valueType());
+}
+
+void Matrix::copy(const stromx::runtime::Matrix& matrix)
+{
+    // studio matrices can be shared
+    const Matrix* studioMatrix = dynamic_cast<const Matrix*>(&matrix);
+    if(studioMatrix)
+    {
+        share(*studioMatrix);
+        return;
+    }
+    
     allocate(matrix.rows(), matrix.cols(), matrix.valueType());
     
     for (unsigned int i = 0; i < rows(); ++i)
     {
         const uint8_t* srcRowPtr = matrix.data() + i * matrix.stride();
-        uint8_t* dstRowPtr = data() + i * stride();
+        uint8_t* dstRowPtr = m_data + i * stride();
         unsigned int rowBytes = cols() * valueSize();
         memcpy(dstRowPtr, srcRowPtr, rowBytes);
     }
 }
 
-void Matrix::allocate(const unsigned int rows, const unsigned int cols, const ValueType valueType)
+void Matrix::initializeParent(const unsigned int rows, const unsigned int cols, const ValueType valueType)
 {
-    if(m_data)
-    {
-        delete [] m_data;
-        m_data = 0;
-    }
-    
-    unsigned int valueSize = Matrix::valueSize(valueType);
-    unsigned int bufferSize = rows * cols * valueSize;
-    m_data = new uint8_t[bufferSize];
+    // the const access does not detach the buffer
+    m_data = reinterpret_cast<uint8_t*>(const_cast<char*>(m_buffer.constData()));
     
-    setBuffer(m_data, bufferSize);
-    initializeMatrix(rows, cols, cols * valueSize, m_data, valueType);
+    setBuffer(m_data, m_buffer.size());
+    initializeMatrix(rows, cols, cols * Matrix::valueSize(valueType), m_data, valueType);
 }
@@ -20,12 +20,20 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <QByteArray>
 #include <QVariant>
 
 #include <stromx/runtime/MatrixWrapper.h>
 #include <stromx/runtime/Version.h>
 
-/** \brief Concrete stromx matrix class. */
+/** 
+ * \brief Concrete stromx matrix class. 
+ *
+ * Copies of a matrix share their buffer until one of them is modified, i.e.
+ * copying a matrix is cheap. The buffer is copied as soon as non-const access
+ * to the data or the buffer of a shared matrix is requested. Resizing and
+ * deserializing a matrix always allocate a new buffer.
+ */
 class Matrix : public stromx::runtime::MatrixWrapper
 {
 public:
@@ -46,13 +54,43 @@ public:
     const Matrix & operator=(const Matrix & matrix);
     const Matrix & operator=(const stromx::runtime::Matrix & matrix);
     
+    using stromx::runtime::MatrixWrapper::data;
+    
+    /** Returns the data of the matrix. The buffer is detached if it is shared. */
+    virtual uint8_t* data();
+    
+    /** Returns the buffer of the matrix. The buffer is detached if it is shared. */
+    virtual uint8_t* buffer();
+    
+    /** Allocates a new buffer for the matrix. The buffer of copies of the matrix is not changed. */
+    virtual void resize(const unsigned int rows, const unsigned int cols, const ValueType valueType);
+    
+    /** Reads the matrix into a new buffer. The buffer of copies of the matrix is not changed. */
+    virtual void deserialize(stromx::runtime::InputProvider & input, const stromx::runtime::Version & version);
+    
+    /** Returns true if the buffer of the matrix is shared with another matrix. */
+    bool isShared() const { return ! m_buffer.isDetached(); }
+    
 protected:
     void allocate(const unsigned int rows, const unsigned int cols, const ValueType valueType);
     
 private:
+    /** Copies the buffer if it is shared with another matrix. */
+    void detach();
+    
+    /** Shares the buffer of \c matrix. */
+    void share(const Matrix & matrix);
+    
+    /** Copies the data of \c matrix. */
+    void copy(const stromx::runtime::Matrix & matrix);
+    
+    /** Initializes the parent class from the current buffer. */
+    void initializeParent(const unsigned int rows, const unsigned int cols, const ValueType valueType);
+    
     static const std::string TYPE;
     static const std::string PACKAGE;
     static const stromx::runtime::Version VERSION;
+    QByteArray m_buffer;
     uint8_t* m_data;
 };
 
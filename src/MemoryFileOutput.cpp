@@ -0,0 +1,227 @@
+#include "MemoryFileOutput.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QString>
+#include <memory>
+#include <stromx/runtime/DirectoryFileInput.h>
+#include <stromx/runtime/Exception.h>
+#include <stromx/runtime/ZipFileInput.h>
+
+namespace
+{
+    stromx::runtime::FileInput* openStreamFile(const std::string & filepath)
+    {
+        QFileInfo info(QString::fromStdString(filepath));
+        if(info.suffix() == "xml")
+            return new stromx::runtime::DirectoryFileInput(info.absoluteDir().absolutePath().toStdString());
+        
+        return new stromx::runtime::ZipFileInput(filepath);
+    }
+}
+
+MemoryFileOutput::MemoryFileOutput()
+  : m_mode(stromx::runtime::OutputProvider::BINARY),
+    m_fileIsOpen(false)
+{
+}
+
+void MemoryFileOutput::initialize(const std::string& filename)
+{
+    finishFile();
+    
+    m_basename = filename;
+    m_filename = "";
+    m_text.str("");
+}
+
+const std::string& MemoryFileOutput::getFilename() const
+{
+    return m_filename;
+}
+
+const std::string MemoryFileOutput::getText() const
+{
+    return m_text.str();
+}
+
+std::ostream& MemoryFileOutput::text()
+{
+    return m_text;
+}
+
+std::ostream& MemoryFileOutput::openFile(const std::string& ext, const OpenMode mode)
+{
+    if(m_fileIsOpen)
+        throw stromx::runtime::WrongState("File has already been opened.");
+    
+    // the stromx file outputs simply append the extension to the basename
+    m_extension = ext;
+    m_filename = m_basename + ext;
+    m_mode = mode;
+    m_file.str("");
+    m_fileIsOpen = true;
+    
+    return m_file;
+}
+
+std::ostream& MemoryFileOutput::file()
+{
+    if(! m_fileIsOpen)
+        throw stromx::runtime::WrongState("No file has been opened.");
+    
+    return m_file;
+}
+
+void MemoryFileOutput::close()
+{
+    finishFile();
+}
+
+std::size_t MemoryFileOutput::size() const
+{
+    std::size_t size = 0;
+    for(std::vector<File>::const_iterator iter = m_files.begin(); iter != m_files.end(); ++iter)
+        size += iter->content.size();
+    
+    return size;
+}
+
+void MemoryFileOutput::copyFile(const std::string& basename, const std::string& extension,
+                                const std::string& sourceFilepath, const std::string& sourceFilename)
+{
+    finishFile();
+    
+    File file;
+    file.basename = basename;
+    file.extension = extension;
+    file.mode = stromx::runtime::OutputProvider::BINARY;
+    file.sourceFilepath = sourceFilepath;
+    file.sourceFilename = sourceFilename;
+    m_files.push_back(file);
+}
+
+bool MemoryFileOutput::hasFile(const std::string& filename) const
+{
+    return findFile(filename) != 0;
+}
+
+std::string MemoryFileOutput::content(const std::string& filename) const
+{
+    const File* file = findFile(filename);
+    return file ? file->content : std::string();
+}
+
+void MemoryFileOutput::setContent(const std::string& filename, const std::string& content)
+{
+    finishFile();
+    
+    if(File* file = findFile(filename))
+        file->content = content;
+}
+
+void MemoryFileOutput::removeFile(const std::string& filename)
+{
+    finishFile();
+    
+    for(std::vector<File>::iterator iter = m_files.begin(); iter != m_files.end(); ++iter)
+    {
+        if(iter->basename + iter->extension == filename)
+        {
+            m_files.erase(iter);
+            return;
+        }
+    }
+}
+
+void MemoryFileOutput::renameFile(const std::string& filename, const std::string& basename,
+                                  const std::string& extension)
+{
+    finishFile();
+    
+    if(File* file = findFile(filename))
+    {
+        file->basename = basename;
+        file->extension = extension;
+    }
+}
+
+void MemoryFileOutput::writeTo(stromx::runtime::FileOutput& output)
+{
+    finishFile();
+    
+    if(MemoryFileOutput* memoryOutput = dynamic_cast<MemoryFileOutput*>(&output))
+    {
+        memoryOutput->finishFile();
+        memoryOutput->m_files.insert(memoryOutput->m_files.end(), m_files.begin(), m_files.end());
+        return;
+    }
+    
+    std::auto_ptr<stromx::runtime::FileInput> input;
+    std::string inputFilepath;
+    for(std::vector<File>::const_iterator iter = m_files.begin(); iter != m_files.end(); ++iter)
+    {
+        if(iter->sourceFilepath.empty())
+        {
+            output.initialize(iter->basename);
+            output.openFile(iter->extension, iter->mode);
+            output.file().write(iter->content.data(), iter->content.size());
+            continue;
+        }
+        
+        if(! input.get() || inputFilepath != iter->sourceFilepath)
+        {
+            input.reset(openStreamFile(iter->sourceFilepath));
+            inputFilepath = iter->sourceFilepath;
+        }
+        
+        // the copied file is completely read before the output is opened because
+        // it might be written to the same location
+        input->initialize("", iter->sourceFilename);
+        std::ostringstream content;
+        content << input->openFile(stromx::runtime::InputProvider::BINARY).rdbuf();
+        
+        std::string data = content.str();
+        output.initialize(iter->basename);
+        output.openFile(iter->extension, iter->mode);
+        output.file().write(data.data(), data.size());
+    }
+}
+
+void MemoryFileOutput::finishFile()
+{
+    if(! m_fileIsOpen)
+        return;
+    
+    File file;
+    file.basename = m_basename;
+    file.extension = m_extension;
+    file.mode = m_mode;
+    file.content = m_file.str();
+    m_files.push_back(file);
+    
+    m_file.str("");
+    m_fileIsOpen = false;
+}
+
+MemoryFileOutput::File* MemoryFileOutput::findFile(const std::string& filename)
+{
+    for(std::vector<File>::iterator iter = m_files.begin(); iter != m_files.end(); ++iter)
+    {
+        if(iter->basename + iter->extension == filename)
+            return &(*iter);
+    }
+    
+    return 0;
+}
+
+const MemoryFileOutput::File* MemoryFileOutput::findFile(const std::string& filename) const
+{
+    for(std::vector<File>::const_iterator iter = m_files.begin(); iter != m_files.end(); ++iter)
+    {
+        if(iter->basename + iter->extension == filename)
+            return &(*iter);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,131 @@
+/* 
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MEMORYFILEOUTPUT_H
+#define MEMORYFILEOUTPUT_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stromx/runtime/FileOutput.h>
+
+/** 
+ * \brief File output which keeps all files in memory
+ * 
+ * This class records all files which are written to it. Afterwards the files
+ * can be written to another file output by calling writeTo(). The names of 
+ * the files are constructed in the same way as by the file outputs of stromx,
+ * i.e. the files referenced by a stream which was written to a memory file
+ * output can be found after they have been passed to the final output.
+ * 
+ * Memory file outputs are used to take snapshots of a stream on the GUI thread
+ * which are written to the disk by a worker thread. Files which are copied from
+ * a stream file by copyFile() are only read by writeTo(), i.e. usually on the
+ * worker thread.
+ */
+class MemoryFileOutput : public stromx::runtime::FileOutput
+{
+public:
+    /** Constructs an empty output. */
+    MemoryFileOutput();
+    
+    virtual void initialize(const std::string & filename);
+    virtual const std::string & getFilename() const;
+    virtual const std::string getText() const;
+    virtual std::ostream & text();
+    virtual std::ostream & openFile(const std::string & ext, const OpenMode mode);
+    virtual std::ostream & file();
+    virtual void close();
+    
+    /** 
+     * Returns the total number of bytes of all files in the output. The size
+     * of copied files is not included.
+     */
+    std::size_t size() const;
+    
+    /** 
+     * Adds the file \c sourceFilename of the stream file at \c sourceFilepath
+     * to the output. It is written as \c basename with the extension \c extension.
+     * The file is not read before writeTo() is called.
+     */
+    void copyFile(const std::string & basename, const std::string & extension,
+                  const std::string & sourceFilepath, const std::string & sourceFilename);
+    
+    /** Returns true if the output contains a file with the name \c filename. */
+    bool hasFile(const std::string & filename) const;
+    
+    /** 
+     * Returns the content of the file \c filename. An empty string is returned
+     * if there is no such file or if the file is copied from a stream file.
+     */
+    std::string content(const std::string & filename) const;
+    
+    /** Replaces the content of the file \c filename. */
+    void setContent(const std::string & filename, const std::string & content);
+    
+    /** Removes the file \c filename from the output. */
+    void removeFile(const std::string & filename);
+    
+    /** 
+     * Renames the file \c filename such that it is written as \c basename with
+     * the extension \c extension.
+     */
+    void renameFile(const std::string & filename, const std::string & basename,
+                    const std::string & extension);
+    
+    /** 
+     * Writes all files of the output to \c output. Files which are currently
+     * open are finished first. Copied files are read from their stream files
+     * unless \c output is a memory file output which receives the copies as
+     * they are.
+     * 
+     * \throws stromx::runtime::Exception
+     */
+    void writeTo(stromx::runtime::FileOutput & output);
+    
+private:
+    struct File
+    {
+        std::string basename;
+        std::string extension;
+        OpenMode mode;
+        std::string content;
+        std::string sourceFilepath;
+        std::string sourceFilename;
+    };
+    
+    /** Moves the currently open file to the list of files. */
+    void finishFile();
+    
+    /** Returns the file \c filename or 0 if there is no such file. */
+    File* findFile(const std::string & filename);
+    const File* findFile(const std::string & filename) const;
+    
+    std::vector<File> m_files;
+    std::string m_basename;
+    std::string m_extension;
+    std::string m_filename;
+    OpenMode m_mode;
+    bool m_fileIsOpen;
+    std::ostringstream m_text;
+    std::ostringstream m_file;
+};
+
+#endif // MEMORYFILEOUTPUT_H
@@ -0,0 +1,114 @@
+#include "OperatorWatchdog.h"
+
+#include <QTimer>
+#include <stromx/runtime/Operator.h>
+#include <stromx/runtime/OperatorInfo.h>
+
+#include "model/OperatorModel.h"
+#include "model/StreamModel.h"
+
+const int OperatorWatchdog::DEFAULT_THRESHOLD = 5000;
+const int OperatorWatchdog::CHECK_INTERVAL = 1000;
+
+OperatorWatchdog::OperatorWatchdog(StreamModel* stream)
+  : QObject(stream),
+    m_stream(stream),
+    m_timer(new QTimer(this)),
+    m_threshold(DEFAULT_THRESHOLD),
+    m_enabled(true)
+{
+    m_timer->setInterval(CHECK_INTERVAL);
+    connect(m_timer, SIGNAL(timeout()), this, SLOT(check()));
+}
+
+void OperatorWatchdog::setThreshold(int threshold)
+{
+    m_threshold = threshold >= 0 ? threshold : 0;
+}
+
+void OperatorWatchdog::setEnabled(bool enabled)
+{
+    if(enabled == m_enabled)
+        return;
+    
+    m_enabled = enabled;
+    if(! m_enabled)
+    {
+        foreach(OperatorModel* op, m_stream->operators())
+            op->setTrackActivity(false);
+        m_threadPositions.clear();
+        stop();
+    }
+}
+
+void OperatorWatchdog::trackActivity()
+{
+    foreach(OperatorModel* op, m_stream->operators())
+        op->setTrackActivity(m_enabled);
+}
+
+void OperatorWatchdog::start()
+{
+    if(! m_enabled)
+        return;
+    
+    // the time while the stream was paused does not count
+    foreach(OperatorModel* op, m_stream->operators())
+        op->restartActivity();
+    
+    m_timer->start();
+}
+
+void OperatorWatchdog::stop()
+{
+    m_timer->stop();
+    
+    foreach(OperatorModel* op, m_stream->operators())
+        op->setHung(false);
+    
+    emit checked();
+}
+
+void OperatorWatchdog::check()
+{
+    qint64 now = ConnectorObserver::currentTime();
+    
+    m_threadPositions.clear();
+    foreach(OperatorModel* op, m_stream->operators())
+    {
+        ConnectorObserver::Activity activity = op->connectorActivity();
+        const stromx::runtime::OperatorInfo & info = op->op()->info();
+        
+        bool executing = activity.occupiedInputs == int(info.inputs().size())
+                         && activity.occupiedOutputs == 0;
+        bool stalled = executing && activity.lastChange > 0 && now - activity.lastChange > m_threshold;
+        bool timedOut = op->lastAccessTimeout() > activity.lastChange;
+        
+        op->setHung(stalled || timedOut);
+        
+        // remember the newest change of each thread
+        QHash<const stromx::runtime::Thread*, ConnectorObserver::ThreadPosition> positions = op->threadPositions();
+        QHash<const stromx::runtime::Thread*, ConnectorObserver::ThreadPosition>::const_iterator iter;
+        for(iter = positions.constBegin(); iter != positions.constEnd(); ++iter)
+        {
+            QHash<const stromx::runtime::Thread*, ConnectorObserver::ThreadPosition>::const_iterator current
+                = m_threadPositions.constFind(iter.key());
+            if(current == m_threadPositions.constEnd() || current.value().time < iter.value().time)
+                m_threadPositions[iter.key()] = iter.value();
+        }
+    }
+    
+    emit checked();
+}
+
+ConnectorObserver::ThreadPosition OperatorWatchdog::threadPosition(const stromx::runtime::Thread* thread) const
+{
+    ConnectorObserver::ThreadPosition position;
+    position.receiver = 0;
+    position.type = stromx::runtime::Connector::INPUT;
+    position.id = 0;
+    position.occupied = false;
+    position.time = 0;
+    
+    return m_threadPositions.value(thread, position);
+}
@@ -0,0 +1,120 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPERATORWATCHDOG_H
+#define OPERATORWATCHDOG_H
+
+#include <QHash>
+#include <QObject>
+
+#include "ConnectorObserver.h"
+
+class QTimer;
+class StreamModel;
+
+/** 
+ * \brief Watchdog which detects operators which stopped making progress
+ * 
+ * While the stream is active the watchdog periodically checks the connector
+ * activity of all operators. An operator is considered as hung if it executes
+ * without any connector change for longer than threshold() milliseconds. An
+ * operator executes if all of its inputs are occupied and all of its outputs
+ * are free. Operators which wait for input data or for their output data to be
+ * consumed are not flagged, i.e. only the operator which actually stalls is
+ * reported and not the operators up- or downstream of it. An operator is
+ * considered as hung as well if an access to its parameters timed out and
+ * none of its connectors changed since.
+ * 
+ * The watchdog sets the hung state of the operator models accordingly and
+ * collects the most recent connector change of each thread. To do so the
+ * operators record each connector change while the watchdog is enabled. If it
+ * is disabled this bookkeeping is skipped and no operator is reported.
+ */
+class OperatorWatchdog : public QObject
+{
+    Q_OBJECT
+    
+public:
+    /** The default threshold in milliseconds. */
+    static const int DEFAULT_THRESHOLD;
+    
+    /** The time between two checks in milliseconds. */
+    static const int CHECK_INTERVAL;
+    
+    /** Constructs a watchdog for the operators of \c stream. */
+    explicit OperatorWatchdog(StreamModel* stream);
+    
+    /** Returns the time in milliseconds after which an operator without progress is considered as hung. */
+    int threshold() const { return m_threshold; }
+    
+    /** Sets the threshold in milliseconds. */
+    void setThreshold(int threshold);
+    
+    /** Returns true if the watchdog checks the operators. The watchdog is enabled by default. */
+    bool isEnabled() const { return m_enabled; }
+    
+    /** 
+     * Enables or disables the watchdog. Disabling stops the checks and the
+     * recording of the connector activity immediately. Enabling takes effect
+     * the next time the stream is started.
+     */
+    void setEnabled(bool enabled);
+    
+    /** 
+     * Makes the operators record their connector activity if the watchdog is
+     * enabled. This function is called by the class StreamModel before the
+     * stream is started.
+     */
+    void trackActivity();
+    
+    /** 
+     * Returns the most recent connector change of \c thread at the time of
+     * the last check. The receiver of the returned position is 0 if the thread
+     * did not change any connector.
+     */
+    ConnectorObserver::ThreadPosition threadPosition(const stromx::runtime::Thread* thread) const;
+    
+public slots:
+    /** 
+     * Starts to check the operators periodically if the watchdog is enabled.
+     * The time since the last connector change of each operator is measured
+     * from now on.
+     */
+    void start();
+    
+    /** Stops checking the operators and resets their hung state. */
+    void stop();
+    
+    /** Checks all operators and updates their hung state. */
+    void check();
+    
+signals:
+    /** The operators have been checked. */
+    void checked();
+    
+private:
+    StreamModel* m_stream;
+    QTimer* m_timer;
+    int m_threshold;
+    bool m_enabled;
+    QHash<const stromx::runtime::Thread*, ConnectorObserver::ThreadPosition> m_threadPositions;
+};
+
+#endif // OPERATORWATCHDOG_H
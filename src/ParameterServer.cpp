@@ -1,20 +1,35 @@
 #include "ParameterServer.h"
 
+#include "Common.h"
 #include "DataConverter.h"
+#include "DeferredParameters.h"
+#include "Matrix.h"
 #include "cmd/SetParameterCmd.h"
+#include "data/ErrorData.h"
 #include "task/GetParameterTask.h"
 #include "task/SetParameterTask.h"
 #include <stromx/runtime/Operator.h>
 #include <stromx/runtime/TriggerData.h>
+#include <stromx/runtime/Variant.h>
 #include <stromx/runtime/OperatorException.h>
 
+namespace
+{
+    bool isMatrix(const stromx::runtime::Data & data)
+    {
+        return data.isVariant(stromx::runtime::Variant::MATRIX) && ! data.isVariant(stromx::runtime::Variant::IMAGE);
+    }
+}
+
 ParameterServer::ParameterServer(stromx::runtime::Operator* op, QUndoStack* undoStack, QObject* parent)
   : QObject(parent),
     m_op(op),
     m_undoStack(undoStack),
+    m_deferredParameters(0),
     m_accessTimeout(0)
 {
-
+    // the converted values are valid until the parameter changes
+    connect(this, SIGNAL(parameterChanged(unsigned int)), this, SLOT(invalidateVariants(unsigned int)));
 }
 
 const QVariant ParameterServer::getParameter(unsigned int id, int role)
@@ -26,10 +41,36 @@ const QVariant ParameterServer::getParameter(unsigned int id, int role)
     
     ParameterValue & value = m_cache[id];
     
+    // the choices do not depend on the value of the parameter
+    if(role == ChoicesRole)
+    {
+        QHash<unsigned int, QVariant>::const_iterator choices = m_choices.constFind(id);
+        if(choices != m_choices.constEnd())
+            return choices.value();
+    }
+    
+    // deferred parameters are loaded as soon as their actual value is required
+    if(value.state == DEFERRED && role != Qt::DisplayRole)
+    {
+        if(role != Qt::EditRole && role != ImageRole && role != MatrixRole)
+            return QVariant();
+        
+        loadDeferredParameter(id);
+    }
+    
     if(value.state == CURRENT)
     {
         // if the value is up-to-date return it
-        return DataConverter::toQVariant(m_cache[id].value, param, role);
+        QHash<int, QVariant>::const_iterator cached = value.variants.constFind(role);
+        if(cached != value.variants.constEnd())
+            return cached.value();
+        
+        QVariant variant = toQVariant(value.value, param, role);
+        value.variants.insert(role, variant);
+        if(role == ChoicesRole)
+            m_choices.insert(id, variant);
+        
+        return variant;
     }
     else
     {
@@ -47,6 +88,8 @@ const QVariant ParameterServer::getParameter(unsigned int id, int role)
                     return tr("Time out");
                 case ERROR:
                     return tr("N/A");
+                case DEFERRED:
+                    return tr("Not loaded");
                 default:
                     Q_ASSERT(false);
             }
@@ -58,7 +101,7 @@ const QVariant ParameterServer::getParameter(unsigned int id, int role)
             // is opened. Here we simply return the most recently cached value.
             stromx::runtime::DataRef value = m_cache[id].value;
             if (! value.isNull())
-                return DataConverter::toQVariant(value, param, role);
+                return toQVariant(value, param, role);
         }
     }
     
@@ -71,7 +114,7 @@ bool ParameterServer::setParameter(unsigned int id, const QVariant& value)
     
     if(parameterIsWriteAccessible(param))
     {
-        stromx::runtime::DataRef stromxData = DataConverter::toStromxData(value, param);
+        stromx::runtime::DataRef stromxData = DataConverter::toStromxData(converters(param).toStromxData, value, param);
         
         if(stromxData.isNull())
             return false;
@@ -99,6 +142,9 @@ bool ParameterServer::setParameter(unsigned int id, const QVariant& value)
             
         // any other parameters are set via an undo stack command
         // first obtain the current parameter value
+        if(m_cache[id].state == DEFERRED)
+            loadDeferredParameter(id);
+        
         stromx::runtime::DataRef currentValue = m_cache[id].value;
         
         // if the new value is different from the old one
@@ -121,6 +167,8 @@ void ParameterServer::refresh()
     using namespace stromx::runtime;
     
     m_cache.clear();
+    m_choices.clear();
+    m_converters.clear();
     
     for(std::vector<const Parameter*>::const_iterator iter = m_op->info().parameters().begin();
         iter != m_op->info().parameters().end();
@@ -132,9 +180,102 @@ void ParameterServer::refresh()
     }
 }
 
+void ParameterServer::setDeferredParameters(DeferredParameters* parameters)
+{
+    using namespace stromx::runtime;
+    
+    m_deferredParameters = parameters;
+    
+    for(std::vector<const Parameter*>::const_iterator iter = m_op->info().parameters().begin();
+        iter != m_op->info().parameters().end();
+        ++iter)
+    {
+        unsigned int id = (*iter)->id();
+        if(m_deferredParameters && m_deferredParameters->contains(m_op, id))
+        {
+            m_cache[id].state = DEFERRED;
+            emit parameterChanged(id);
+        }
+    }
+}
+
+bool ParameterServer::loadDeferredParameters()
+{
+    if(! m_deferredParameters)
+        return true;
+    
+    // parameters which failed to load before are tried again
+    bool success = true;
+    QList<unsigned int> ids = m_cache.keys();
+    foreach(unsigned int id, ids)
+    {
+        if(m_deferredParameters->contains(m_op, id) && ! loadDeferredParameter(id))
+            success = false;
+    }
+    
+    return success;
+}
+
+bool ParameterServer::loadDeferredParameter(unsigned int id)
+{
+    ParameterValue & value = m_cache[id];
+    
+    QString error;
+    if(m_deferredParameters->load(m_op, id, value.value, error))
+    {
+        value.state = CURRENT;
+        emit parameterChanged(id);
+        return true;
+    }
+    else
+    {
+        value.state = ERROR;
+        emit parameterChanged(id);
+        
+        QString message = tr("Failed to load parameter %1: %2")
+                          .arg(QString::fromStdString(m_op->info().parameter(id).title()), error);
+        stromx::runtime::OperatorError exception(m_op->info(), message.toStdString());
+        emit parameterErrorOccurred(ErrorData(exception, ErrorData::PARAMETER_ACCESS, m_op));
+        return false;
+    }
+}
+
+const ParameterServer::Converters & ParameterServer::converters(const stromx::runtime::Parameter& param)
+{
+    QHash<unsigned int, Converters>::iterator iter = m_converters.find(param.id());
+    if(iter == m_converters.end())
+    {
+        // the variant of a parameter is fixed, i.e. its conversion functions
+        // are looked up only once (parameters of general or composite variants
+        // resolve the conversion to a QVariant from each data object)
+        Converters converters;
+        converters.toQVariant = DataConverter::toQVariantFunction(param.variant());
+        converters.toStromxData = DataConverter::toStromxDataFunction(param.variant());
+        iter = m_converters.insert(param.id(), converters);
+    }
+    
+    return iter.value();
+}
+
+QVariant ParameterServer::toQVariant(const stromx::runtime::Data& data, const stromx::runtime::Parameter& param, int role)
+{
+    DataConverter::ToQVariantFunction function = converters(param).toQVariant;
+    
+    // parameters of general or composite variants accept data of different variants
+    if(! function)
+        return DataConverter::toQVariant(data, param, role);
+    
+    return DataConverter::toQVariant(function, data, param, role);
+}
+
 void ParameterServer::refreshParameter(const stromx::runtime::Parameter & param)
 {
-    if(parameterIsReadAccessible(param))
+    if(m_deferredParameters && m_deferredParameters->contains(m_op, param.id()))
+    {
+        m_cache[param.id()].state = DEFERRED;
+        emit parameterChanged(param.id());
+    }
+    else if(parameterIsReadAccessible(param))
     {
         GetParameterTask* task = new GetParameterTask(m_op, param.id(), m_accessTimeout, this);
         connect(task, SIGNAL(finished()), this, SLOT(handleGetParameterTaskFinished()));
@@ -146,13 +287,25 @@ void ParameterServer::refreshParameter(const stromx::runtime::Parameter & param)
 
 void ParameterServer::doSetParameter(unsigned int paramId, const stromx::runtime::DataRef& newValue)
 {
+    // the value in the stream file is replaced by the new value
+    if(m_deferredParameters)
+        m_deferredParameters->remove(m_op, paramId);
+    
     SetParameterTask* task = new SetParameterTask(m_op, paramId, newValue, m_accessTimeout, this);
     connect(task, SIGNAL(finished()), this, SLOT(handleSetParameterTaskFinished()));
     task->start();
     m_cache[paramId].state = SETTING;
+    m_cache[paramId].pendingValue = newValue;
     emit parameterChanged(paramId);
 }
 
+void ParameterServer::invalidateVariants(unsigned int id)
+{
+    QMap<unsigned int, ParameterValue>::iterator value = m_cache.find(id);
+    if(value != m_cache.end())
+        value.value().variants.clear();
+}
+
 void ParameterServer::handleSetParameterTaskFinished()
 {
     SetParameterTask* task = qobject_cast<SetParameterTask*>(sender());
@@ -252,11 +405,28 @@ void ParameterServer::handleGetParameterTaskFinished()
 
     if(task)
     {
+        // the operator does not know the value of deferred parameters yet
+        if(m_deferredParameters && m_deferredParameters->contains(m_op, task->id()))
+            return;
+        
         ParameterValue & value = m_cache[task->id()];
+        stromx::runtime::DataRef pendingValue = value.pendingValue;
+        value.pendingValue = stromx::runtime::DataRef();
+        
         switch(task->error())
         {
         case GetParameterTask::NO_ERROR:
-            value.value = task->value();
+            // Share the value which has been set with the command which set it
+            // instead of storing a copy. This way the undo stack does not hold
+            // a second copy of the value when the parameter is set again.
+            if(! pendingValue.isNull() && DataConverter::stromxDataEqualsTarget(task->value(), pendingValue))
+                value.value = pendingValue;
+            // matrices are stored as studio matrices which are displayed and
+            // edited without copying their data
+            else if(isMatrix(task->value()))
+                value.value = stromx::runtime::DataRef(new Matrix(stromx::runtime::data_cast<stromx::runtime::Matrix>(task->value())));
+            else
+                value.value = task->value();
             value.state = CURRENT;
             emit parameterChanged(task->id());
             break;
@@ -20,10 +20,13 @@
 #ifndef PARAMETERSERVER_H
 #define PARAMETERSERVER_H
 
+#include <QHash>
 #include <QObject>
 #include <QVariant>
 #include <stromx/runtime/DataRef.h>
 
+#include "DataConverter.h"
+
 class QUndoStack;
 class QVariant;
 
@@ -37,6 +40,7 @@ namespace stromx
     }
 }
 
+class DeferredParameters;
 class ErrorData;
 
 class ParameterServer : public QObject
@@ -67,6 +71,18 @@ public:
     /** Returns the maximal time to wait when accessing the stromx operator in milliseconds. */
     int accessTimeout() const { return m_accessTimeout; }
     
+    /** 
+     * Sets the parameters of the operator which are loaded on demand. Their values
+     * are not obtained from the operator until they are accessed for the first time.
+     */
+    void setDeferredParameters(DeferredParameters* parameters);
+    
+    /** 
+     * Loads the values of all deferred parameters of the operator. Returns false
+     * if any of them could not be loaded.
+     */
+    bool loadDeferredParameters();
+    
 public slots:
     /** Sets the maximal time to wait when accessing the stromx operator in milliseconds. */
     void setAccessTimeout(int timeout);
@@ -94,6 +110,9 @@ private slots:
      */
     void handleSetParameterTaskFinished();
     
+    /** Discards the converted values of the parameter \c id. */
+    void invalidateVariants(unsigned int id);
+    
 private:
     enum ParameterState
     {
@@ -101,13 +120,27 @@ private:
         SETTING,
         GETTING,
         TIMED_OUT,
-        ERROR
+        ERROR,
+        DEFERRED
     };
     
     struct ParameterValue
     {
         ParameterState state;
         stromx::runtime::DataRef value;
+        
+        /** The value which is currently being set. */
+        stromx::runtime::DataRef pendingValue;
+        
+        /** The current value converted for each role which has been requested. */
+        QHash<int, QVariant> variants;
+    };
+    
+    /** The conversion functions of a parameter which are resolved once from its variant. */
+    struct Converters
+    {
+        DataConverter::ToQVariantFunction toQVariant;
+        DataConverter::ToStromxDataFunction toStromxData;
     };
     
     /** Returns the stromx operator whose parameters are served. */
@@ -125,9 +158,21 @@ private:
     /** Refreshes the cached value for the parameter \c param. */
     void refreshParameter(const stromx::runtime::Parameter & param);
     
+    /** Loads the deferred parameter \c id and updates the cache. */
+    bool loadDeferredParameter(unsigned int id);
+    
+    /** Returns the conversion functions of \c param and resolves them if necessary. */
+    const Converters & converters(const stromx::runtime::Parameter & param);
+    
+    /** Converts the value \c data of \c param to a QVariant object. */
+    QVariant toQVariant(const stromx::runtime::Data & data, const stromx::runtime::Parameter & param, int role);
+    
     stromx::runtime::Operator* m_op;
     QUndoStack* m_undoStack;
+    DeferredParameters* m_deferredParameters;
     QMap<unsigned int, ParameterValue> m_cache;
+    QHash<unsigned int, QVariant> m_choices;
+    QHash<unsigned int, Converters> m_converters;
     int m_accessTimeout;
 };
 
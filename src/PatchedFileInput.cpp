@@ -0,0 +1,72 @@
+#include "PatchedFileInput.h"
+
+#include <stromx/runtime/Exception.h>
+
+PatchedFileInput::PatchedFileInput(stromx::runtime::FileInput& input, const std::string& filename,
+                                   const std::string& content)
+  : m_input(input),
+    m_filename(filename),
+    m_content(content),
+    m_isPatched(false),
+    m_fileIsOpen(false)
+{
+}
+
+void PatchedFileInput::initialize(const std::string& text, const std::string& filename)
+{
+    m_isPatched = filename == m_filename;
+    m_fileIsOpen = false;
+    
+    if(m_isPatched)
+    {
+        m_text.clear();
+        m_text.str(text);
+    }
+    else
+    {
+        m_input.initialize(text, filename);
+    }
+}
+
+std::istream& PatchedFileInput::text()
+{
+    return m_isPatched ? m_text : m_input.text();
+}
+
+std::istream& PatchedFileInput::openFile(const OpenMode mode)
+{
+    if(! m_isPatched)
+        return m_input.openFile(mode);
+    
+    if(m_fileIsOpen)
+        throw stromx::runtime::WrongState("File has already been opened.");
+    
+    m_file.clear();
+    m_file.str(m_content);
+    m_fileIsOpen = true;
+    
+    return m_file;
+}
+
+std::istream& PatchedFileInput::file()
+{
+    if(! m_isPatched)
+        return m_input.file();
+    
+    if(! m_fileIsOpen)
+        throw stromx::runtime::WrongState("No file has been opened.");
+    
+    return m_file;
+}
+
+bool PatchedFileInput::hasFile() const
+{
+    return m_isPatched ? true : m_input.hasFile();
+}
+
+void PatchedFileInput::close()
+{
+    m_isPatched = false;
+    m_fileIsOpen = false;
+    m_input.close();
+}
@@ -0,0 +1,65 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef PATCHEDFILEINPUT_H
+#define PATCHEDFILEINPUT_H
+
+#include <sstream>
+#include <string>
+#include <stromx/runtime/FileInput.h>
+
+/** 
+ * \brief File input which replaces the content of a single file
+ * 
+ * This class forwards all calls to another file input. Only if the file
+ * \c filename is opened the content passed to the constructor is returned
+ * instead of the content of the original file. This allows to pass a modified
+ * stream description to stromx::runtime::XmlReader while all other files are
+ * still read from the original input.
+ */
+class PatchedFileInput : public stromx::runtime::FileInput
+{
+public:
+    /** 
+     * Constructs a file input which forwards to \c input and replaces the
+     * content of \c filename by \c content. The input must exist as long as
+     * the patched input is used.
+     */
+    PatchedFileInput(stromx::runtime::FileInput & input, const std::string & filename,
+                     const std::string & content);
+    
+    virtual void initialize(const std::string & text, const std::string & filename);
+    virtual std::istream & text();
+    virtual std::istream & openFile(const OpenMode mode);
+    virtual std::istream & file();
+    virtual bool hasFile() const;
+    virtual void close();
+    
+private:
+    stromx::runtime::FileInput & m_input;
+    std::string m_filename;
+    std::string m_content;
+    std::istringstream m_text;
+    std::istringstream m_file;
+    bool m_isPatched;
+    bool m_fileIsOpen;
+};
+
+#endif // PATCHEDFILEINPUT_H
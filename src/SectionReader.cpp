@@ -0,0 +1,41 @@
+#include "SectionReader.h"
+
+#include <QIODevice>
+
+namespace
+{
+    // the size of the tag and the size field
+    const qint64 SECTION_HEADER_SIZE = 2 * sizeof(quint32);
+}
+
+SectionReader::SectionReader(QIODevice* device)
+  : m_device(device),
+    m_stream(device),
+    m_tag(0),
+    m_sectionEnd(-1)
+{
+    m_stream.setVersion(QDataStream::Qt_4_7);
+}
+
+bool SectionReader::nextSection()
+{
+    // skip the rest of the current section
+    if(m_sectionEnd >= 0 && ! m_device->seek(m_sectionEnd))
+        return false;
+    
+    if(m_device->bytesAvailable() < SECTION_HEADER_SIZE)
+        return false;
+    
+    quint32 size = 0;
+    m_stream.resetStatus();
+    m_stream >> m_tag;
+    m_stream >> size;
+    
+    m_sectionEnd = m_device->pos() + size;
+    return m_stream.status() == QDataStream::Ok && m_sectionEnd <= m_device->size();
+}
+
+bool SectionReader::sectionIsValid() const
+{
+    return m_stream.status() == QDataStream::Ok && m_device->pos() <= m_sectionEnd;
+}
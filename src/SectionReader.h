@@ -0,0 +1,68 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SECTIONREADER_H
+#define SECTIONREADER_H
+
+#include <QDataStream>
+
+class QIODevice;
+
+/**
+ * \brief Reads data which was written by SectionWriter
+ * 
+ * The reader iterates over the sections of a device by calling nextSection().
+ * The content of the current section is read from stream(). It is not necessary
+ * to read a section completely, the rest of the section is skipped when the next
+ * section is entered. In particular sections with unknown tags can simply be 
+ * skipped by calling nextSection() again.
+ */
+class SectionReader
+{
+public:
+    /** Constructs a reader for the sections which start at the current position of \c device. */
+    explicit SectionReader(QIODevice* device);
+    
+    /** Returns the stream the content of the current section is read from. */
+    QDataStream & stream() { return m_stream; }
+    
+    /** 
+     * Enters the next section. Returns false if there are no more sections
+     * or if the next section is incomplete.
+     */
+    bool nextSection();
+    
+    /** Returns the tag of the current section. */
+    quint32 tag() const { return m_tag; }
+    
+    /** 
+     * Returns true if the content of the current section was read without errors
+     * and without reading beyond the end of the section.
+     */
+    bool sectionIsValid() const;
+    
+private:
+    QIODevice* m_device;
+    QDataStream m_stream;
+    quint32 m_tag;
+    qint64 m_sectionEnd;
+};
+
+#endif // SECTIONREADER_H
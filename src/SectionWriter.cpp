@@ -0,0 +1,36 @@
+#include "SectionWriter.h"
+
+#include <QIODevice>
+
+SectionWriter::SectionWriter(QIODevice* device)
+  : m_device(device),
+    m_stream(device),
+    m_sectionStart(-1)
+{
+    m_stream.setVersion(QDataStream::Qt_4_7);
+}
+
+void SectionWriter::beginSection(quint32 tag)
+{
+    Q_ASSERT(m_sectionStart < 0);
+    
+    m_stream << tag;
+    m_sectionStart = m_device->pos();
+    
+    // the size of the section is set by endSection()
+    m_stream << quint32(0);
+}
+
+void SectionWriter::endSection()
+{
+    Q_ASSERT(m_sectionStart >= 0);
+    
+    qint64 sectionEnd = m_device->pos();
+    quint32 size = quint32(sectionEnd - m_sectionStart - sizeof(quint32));
+    
+    m_device->seek(m_sectionStart);
+    m_stream << size;
+    m_device->seek(sectionEnd);
+    
+    m_sectionStart = -1;
+}
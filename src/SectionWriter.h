@@ -0,0 +1,63 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SECTIONWRITER_H
+#define SECTIONWRITER_H
+
+#include <QDataStream>
+
+class QIODevice;
+
+/**
+ * \brief Writes data in length-prefixed sections
+ * 
+ * A section starts with a tag which identifies its content and the size of the
+ * content in bytes (both 32-bit unsigned integers). The content of a section is 
+ * written to stream() between the calls of beginSection() and endSection(). The
+ * size of a section is not known in advance. Therefore the writer writes a 
+ * placeholder and replaces it when the section is finished, i.e. the device must
+ * be random-access.
+ * 
+ * Sections can be read by SectionReader, which skips sections with unknown tags.
+ * This allows newer versions of a file format to add sections which are ignored
+ * by older readers. The data stream always uses the version QDataStream::Qt_4_7.
+ */
+class SectionWriter
+{
+public:
+    /** Constructs a writer which appends sections to \c device. */
+    explicit SectionWriter(QIODevice* device);
+    
+    /** Returns the stream the content of the sections is written to. */
+    QDataStream & stream() { return m_stream; }
+    
+    /** Starts a section with the tag \c tag. */
+    void beginSection(quint32 tag);
+    
+    /** Finishes the current section. */
+    void endSection();
+    
+private:
+    QIODevice* m_device;
+    QDataStream m_stream;
+    qint64 m_sectionStart;
+};
+
+#endif // SECTIONWRITER_H
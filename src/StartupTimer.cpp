@@ -0,0 +1,54 @@
+#include "StartupTimer.h"
+
+#include <QDebug>
+#include <QEvent>
+#include <QWidget>
+
+StartupTimer::StartupTimer(QObject* parent)
+  : QObject(parent),
+    m_lastMark(0),
+    m_firstPaint(-1)
+{
+    m_timer.start();
+}
+
+void StartupTimer::mark(const QString& name)
+{
+    qint64 now = m_timer.elapsed();
+    
+    Phase phase;
+    phase.name = name;
+    phase.duration = now - m_lastMark;
+    phase.end = now;
+    m_phases.append(phase);
+    
+    m_lastMark = now;
+}
+
+void StartupTimer::observeFirstPaint(QWidget* widget)
+{
+    widget->installEventFilter(this);
+}
+
+void StartupTimer::print() const
+{
+    foreach(const Phase & phase, m_phases)
+    {
+        qDebug() << "Startup phase" << phase.name << "took" << phase.duration 
+                 << "ms (finished after" << phase.end << "ms)";
+    }
+}
+
+bool StartupTimer::eventFilter(QObject* watched, QEvent* event)
+{
+    if(event->type() == QEvent::Paint && m_firstPaint < 0)
+    {
+        // only the first paint event is of interest
+        watched->removeEventFilter(this);
+        mark("first paint");
+        m_firstPaint = m_phases.last().end;
+        emit firstPaint();
+    }
+    
+    return QObject::eventFilter(watched, event);
+}
@@ -0,0 +1,103 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef STARTUPTIMER_H
+#define STARTUPTIMER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+class QWidget;
+
+/**
+ * \brief Measures the duration of the startup phases of the application
+ *
+ * The timer starts when it is constructed. Each call to mark() records the
+ * time which passed since the previous mark as the duration of the phase
+ * with the given name. The first paint event of the widget passed to
+ * observeFirstPaint() is recorded as the phase "first paint".
+ */
+class StartupTimer : public QObject
+{
+    Q_OBJECT
+    
+public:
+    /** A phase of the startup. */
+    struct Phase
+    {
+        /** The name of the phase. */
+        QString name;
+        
+        /** The duration of the phase in milliseconds. */
+        qint64 duration;
+        
+        /** The time in milliseconds between the start of the timer and the end of the phase. */
+        qint64 end;
+    };
+    
+    /** Constructs and starts a startup timer. */
+    explicit StartupTimer(QObject* parent = 0);
+    
+    /** Ends the current phase and records it as \c name. */
+    void mark(const QString & name);
+    
+    /** 
+     * Records the first paint event of \c widget as the end of the phase
+     * "first paint".
+     */
+    void observeFirstPaint(QWidget* widget);
+    
+    /** Returns true if the first paint event of the observed widget was recorded. */
+    bool hasFirstPaint() const { return m_firstPaint >= 0; }
+    
+    /** 
+     * Returns the time in milliseconds between the start of the timer and the
+     * first paint event of the observed widget or -1 if no paint event was
+     * recorded yet.
+     */
+    qint64 timeToFirstPaint() const { return m_firstPaint; }
+    
+    /** Returns the time in milliseconds since the start of the timer. */
+    qint64 elapsed() const { return m_timer.elapsed(); }
+    
+    /** Returns the recorded phases in the order of their completion. */
+    const QList<Phase> & phases() const { return m_phases; }
+    
+public slots:
+    /** Prints the recorded phases to the debug output. */
+    void print() const;
+    
+signals:
+    /** The observed widget was painted for the first time. */
+    void firstPaint();
+    
+protected:
+    bool eventFilter(QObject* watched, QEvent* event);
+    
+private:
+    QElapsedTimer m_timer;
+    qint64 m_lastMark;
+    qint64 m_firstPaint;
+    QList<Phase> m_phases;
+};
+
+#endif // STARTUPTIMER_H
@@ -13,11 +13,14 @@
 #include "model/SelectionModel.h"
 #include "model/StreamModel.h"
 
+const qreal StreamEditorScene::DETAIL_SCALE = 0.5;
+
 StreamEditorScene::StreamEditorScene(QObject* parent)
   : QGraphicsScene(parent),
     m_model(0),
     m_selectionModel(0),
-    m_numOperators(0)
+    m_numOperators(0),
+    m_detailed(true)
 {
     m_selectionModel = new SelectionModel(this);
     
@@ -38,6 +41,7 @@ void StreamEditorScene::setModel(StreamModel* model)
         connect(m_model, SIGNAL(operatorRemoved(OperatorModel*)), this, SLOT(removeOperator(OperatorModel*)));
         connect(m_model, SIGNAL(connectionAdded(ConnectionModel*)), this, SLOT(addConnection(ConnectionModel*)));
         connect(m_model, SIGNAL(connectionRemoved(ConnectionModel*)), this, SLOT(removeConnection(ConnectionModel*)));
+        connect(m_model, SIGNAL(streamStarting()), this, SLOT(updateSelection()));
         connect(m_model, SIGNAL(streamStarted()), this, SLOT(updateSelection()));
         connect(m_model, SIGNAL(streamJoined()), this, SLOT(updateSelection()));
     }
@@ -121,12 +125,9 @@ QAction* StreamEditorScene::createRemoveAction(QObject* parent)
 
 void StreamEditorScene::reset()
 {
-    QList<QGraphicsItem*> itemList = items();
-    foreach(QGraphicsItem* item, itemList)
-    {
-        if(items().count(item))
-            delete item;
-    }
+    clear();
+    m_operatorItems.clear();
+    m_connectionItems.clear();
     
     if(m_model)
     {
@@ -138,9 +139,25 @@ void StreamEditorScene::reset()
     }
 }
 
+void StreamEditorScene::setScale(qreal scale)
+{
+    bool detailed = scale >= DETAIL_SCALE;
+    if(detailed == m_detailed)
+        return;
+    
+    m_detailed = detailed;
+    
+    foreach(OperatorItem* opItem, m_operatorItems)
+        opItem->setDetailed(m_detailed);
+    
+    foreach(ConnectionItem* connectionItem, m_connectionItems)
+        connectionItem->setDetailed(m_detailed);
+}
+
 void StreamEditorScene::addOperator(OperatorModel* op)
 {
     OperatorItem* opItem = new OperatorItem(op);
+    opItem->setDetailed(m_detailed);
     
     // the new operator is the front-most
     opItem->setZValue(m_numOperators);
@@ -148,12 +165,15 @@ void StreamEditorScene::addOperator(OperatorModel* op)
     
     // add it to the scene
     addItem(opItem);
+    m_operatorItems[op] = opItem;
 }
 
 void StreamEditorScene::addConnection(ConnectionModel* connection)
 {
     ConnectionItem* connectionItem = new ConnectionItem(connection);
+    connectionItem->setDetailed(m_detailed);
     addItem(connectionItem);
+    m_connectionItems[connection] = connectionItem;
     
     OperatorItem* sourceOp = findOperatorItem(connection->sourceOp());
     OperatorItem* targetOp = findOperatorItem(connection->targetOp());
@@ -171,13 +191,15 @@ void StreamEditorScene::addConnection(ConnectionModel* connection)
 
 void StreamEditorScene::initialize()
 {
-    m_model->undoStack()->beginMacro("initialize operators");
+    QList<OperatorModel*> operators;
     foreach(QGraphicsItem* item, selectedItems())
     {
         if(OperatorItem* opItem = qgraphicsitem_cast<OperatorItem*>(item))
-            m_model->initializeOperator(opItem->model());
+            operators.append(opItem->model());
     }
-    m_model->undoStack()->endMacro();
+    
+    // the operators are initialized in the background
+    m_model->initializeOperators(operators);
 }
 
 void StreamEditorScene::deinitialize()
@@ -274,36 +296,12 @@ bool StreamEditorScene::isOperatorSelection() const
 
 OperatorItem* StreamEditorScene::findOperatorItem(OperatorModel* opModel) const
 {
-    if(! opModel)
-        return 0;
-    
-    foreach(QGraphicsItem* item, items())
-    {
-        if(OperatorItem* opItem = qgraphicsitem_cast<OperatorItem*>(item))
-        {
-            if(opItem->model() == opModel)
-                return opItem;
-        }
-    }
-    
-    return 0;
+    return m_operatorItems.value(opModel, 0);
 }
 
 ConnectionItem* StreamEditorScene::findConnectionItem(ConnectionModel* connectionModel) const
 {
-    if(! connectionModel)
-        return 0;
-    
-    foreach(QGraphicsItem* item, items())
-    {
-        if(ConnectionItem* connectionItem = qgraphicsitem_cast<ConnectionItem*>(item))
-        {
-            if(connectionItem->model() == connectionModel)
-                return connectionItem;
-        }
-    }
-
-    return 0;
+    return m_connectionItems.value(connectionModel, 0);
 }
 
 void StreamEditorScene::keyPressEvent(QKeyEvent* keyEvent)
@@ -325,31 +323,33 @@ void StreamEditorScene::removeSelectedItems()
     if(! selectedItems().count())
         return;
     
+    // collect the models of the selected items before any item is deleted
+    QList<ConnectionModel*> connections;
+    QList<OperatorModel*> operators;
+    foreach(QGraphicsItem* item, selectedItems())
+    {
+        if(ConnectionItem* connectionItem = qgraphicsitem_cast<ConnectionItem*>(item))
+            connections.append(connectionItem->model());
+        else if(OperatorItem* opItem = qgraphicsitem_cast<OperatorItem*>(item))
+            operators.append(opItem->model());
+    }
+    
     m_model->undoStack()->beginMacro("remove objects");
-    QList<QGraphicsItem*> itemList = selectedItems();
     
     // remove all selected connections first
-    foreach(QGraphicsItem* item, selectedItems())
+    foreach(ConnectionModel* connection, connections)
     { 
-        // items have been deleted because they were dependent on other deleted items
-        // check the existence of each item separately           
-        if(items().contains(item))
-        {
-            if(ConnectionItem* connectionItem = qgraphicsitem_cast<ConnectionItem*>(item))
-                m_model->removeConnection(connectionItem->model());
-        }
+        // connections have been removed because they were dependent on other
+        // removed objects, check the existence of each connection separately
+        if(m_connectionItems.contains(connection))
+            m_model->removeConnection(connection);
     }
     
     // remove operators
-    foreach(QGraphicsItem* item, selectedItems())
+    foreach(OperatorModel* op, operators)
     { 
-        // items have been deleted because they were dependent on other deleted items
-        // check the existence of each item separately           
-        if(items().contains(item))
-        {
-            if(OperatorItem* opItem = qgraphicsitem_cast<OperatorItem*>(item))
-                m_model->removeOperator(opItem->model());
-        }
+        if(m_operatorItems.contains(op))
+            m_model->removeOperator(op);
     }
     
     m_model->undoStack()->endMacro();
@@ -357,13 +357,13 @@ void StreamEditorScene::removeSelectedItems()
 
 void StreamEditorScene::removeOperator(OperatorModel* op)
 {
-    if(OperatorItem* item = findOperatorItem(op))
+    if(OperatorItem* item = m_operatorItems.take(op))
         delete item;
 }
 
 void StreamEditorScene::removeConnection(ConnectionModel* connection)
 {
-    if(ConnectionItem* item = findConnectionItem(connection))
+    if(ConnectionItem* item = m_connectionItems.take(connection))
     {
         OperatorModel* targetOp = item->model()->targetOp();
         OperatorModel* sourceOp = item->model()->sourceOp();
@@ -21,6 +21,7 @@
 #define STREAMEDITORSCENE_H
 
 #include <QGraphicsScene>
+#include <QHash>
 #include "item/OperatorItem.h"
 
 class QAction;
@@ -66,6 +67,20 @@ public:
     /** Returns the current selection model. */
     SelectionModel* selectionModel() const { return m_selectionModel; }
     
+    /** 
+     * Returns true if the items are displayed with all details, i.e. if
+     * the scale of the view is at least \c DETAIL_SCALE.
+     */
+    bool isDetailed() const { return m_detailed; }
+    
+public slots:
+    /** 
+     * Sets the scale of the view which displays the scene. Below \c DETAIL_SCALE
+     * the labels and connectors of the operators are hidden and connections
+     * are drawn as straight lines.
+     */
+    void setScale(qreal scale);
+    
 signals:
     void initializeEnabledChanged(bool enabled);
     void deinitializeEnabledChanged(bool enabled);
@@ -116,6 +131,9 @@ private slots:
     void removeSelectedItems();
     
 private:
+    /** The minimal scale at which the items are displayed with all details. */
+    static const qreal DETAIL_SCALE;
+    
     OperatorItem* findOperatorItem(OperatorModel* opModel) const;
     ConnectionItem* findConnectionItem(ConnectionModel* connectionModel) const;
     bool isOperatorSelection() const;
@@ -123,6 +141,9 @@ private:
     StreamModel* m_model;
     SelectionModel* m_selectionModel;
     unsigned int m_numOperators;
+    bool m_detailed;
+    QHash<OperatorModel*, OperatorItem*> m_operatorItems;
+    QHash<ConnectionModel*, ConnectionItem*> m_connectionItems;
 };
 
 #endif // STREAMEDITORSCENE_H
@@ -0,0 +1,174 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef VARIANTTABLE_H
+#define VARIANTTABLE_H
+
+#include <QVector>
+
+#include <stromx/runtime/Data.h>
+#include <stromx/runtime/Matrix.h>
+#include <stromx/runtime/Variant.h>
+
+/**
+ * \brief Table which maps data variants to functions
+ * 
+ * The table replaces chains of \c isVariant() tests. Its entries are tested
+ * in the order they were added and the function of the first entry which
+ * matches is returned. Tables are usually constructed once and the resolved
+ * function is stored by the caller wherever the variant is known to be fixed.
+ */
+template <class Function>
+class VariantTable
+{
+public:
+    /** Constructs an empty table which resolves to \c defaultFunction. */
+    explicit VariantTable(Function defaultFunction = 0) : m_defaultFunction(defaultFunction) {}
+    
+    /** 
+     * Appends an entry which maps \c variant to \c function. The variant must
+     * exist for the lifetime of the table, e.g. one of the members of 
+     * \c stromx::runtime::Variant.
+     */
+    VariantTable & add(const stromx::runtime::VariantHandle & variant, Function function)
+    {
+        Entry entry;
+        entry.variant = &variant;
+        entry.function = function;
+        m_entries.append(entry);
+        return *this;
+    }
+    
+    /** Returns the function of the first entry whose variant matches \c data. */
+    Function lookup(const stromx::runtime::Data & data) const
+    {
+        for(typename QVector<Entry>::const_iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+        {
+            if(data.isVariant(*iter->variant))
+                return iter->function;
+        }
+        
+        return m_defaultFunction;
+    }
+    
+    /** Returns the function of the first entry whose variant matches \c variant. */
+    Function lookup(const stromx::runtime::VariantHandle & variant) const
+    {
+        for(typename QVector<Entry>::const_iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+        {
+            if(variant.isVariant(*iter->variant))
+                return iter->function;
+        }
+        
+        return m_defaultFunction;
+    }
+    
+    /** 
+     * Returns the function of the first entry whose variant matches \c variant
+     * if all data of \c variant is resolved to this function. Returns the default
+     * function if \c variant is composite, i.e. data of this variant can be
+     * resolved to different functions. E.g. data of a matrix variant might be
+     * an image which is resolved to the function of the image entry.
+     */
+    Function lookupUnique(const stromx::runtime::VariantHandle & variant) const
+    {
+        Function function = lookup(variant);
+        for(typename QVector<Entry>::const_iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+        {
+            if(iter->variant->isVariant(variant) && iter->function != function)
+                return m_defaultFunction;
+        }
+        
+        return function;
+    }
+    
+private:
+    struct Entry
+    {
+        const stromx::runtime::VariantHandle* variant;
+        Function function;
+    };
+    
+    QVector<Entry> m_entries;
+    Function m_defaultFunction;
+};
+
+/**
+ * \brief Table which maps the value types of matrices to functions
+ * 
+ * In contrast to a variant table the function is found by indexing the table
+ * with the value type of the matrix, i.e. the lookup time does not depend on
+ * the number of entries.
+ */
+template <class Function>
+class MatrixTable
+{
+public:
+    /** Constructs an empty table which resolves to \c defaultFunction. */
+    explicit MatrixTable(Function defaultFunction = 0) : m_defaultFunction(defaultFunction) {}
+    
+    /** Maps matrices of the value type \c valueType to \c function. */
+    MatrixTable & add(stromx::runtime::Matrix::ValueType valueType, Function function)
+    {
+        int index = int(valueType);
+        while(m_functions.size() <= index)
+            m_functions.append(0);
+        m_functions[index] = function;
+        return *this;
+    }
+    
+    /** Returns the function which was added for the value type of \c matrix. */
+    Function lookup(const stromx::runtime::Matrix & matrix) const
+    {
+        int index = int(matrix.valueType());
+        if(index < 0 || index >= m_functions.size() || m_functions[index] == 0)
+            return m_defaultFunction;
+        
+        return m_functions[index];
+    }
+    
+private:
+    QVector<Function> m_functions;
+    Function m_defaultFunction;
+};
+
+/**
+ * Returns a matrix table which maps each numeric value type of matrices to
+ * \c Instance<data_t>::create, where \c data_t is the C++ type of the values.
+ * The table is constructed once for each \c Instance.
+ */
+template <class Function, template <class> class Instance>
+const MatrixTable<Function> & matrixInstanceTable()
+{
+    using namespace stromx::runtime;
+    
+    static const MatrixTable<Function> TABLE = MatrixTable<Function>()
+        .add(Matrix::INT_8, &Instance<int8_t>::create)
+        .add(Matrix::UINT_8, &Instance<uint8_t>::create)
+        .add(Matrix::INT_16, &Instance<int16_t>::create)
+        .add(Matrix::UINT_16, &Instance<uint16_t>::create)
+        .add(Matrix::INT_32, &Instance<int32_t>::create)
+        .add(Matrix::UINT_32, &Instance<uint32_t>::create)
+        .add(Matrix::FLOAT_32, &Instance<float>::create)
+        .add(Matrix::FLOAT_64, &Instance<double>::create);
+        
+    return TABLE;
+}
+
+#endif // VARIANTTABLE_H
@@ -0,0 +1,25 @@
+#include "cmd/SetObserverHistorySizeCmd.h"
+
+#include "FrameHistory.h"
+#include "model/ObserverModel.h"
+
+SetObserverHistorySizeCmd::SetObserverHistorySizeCmd(ObserverModel* model, int newMaxFrames, 
+                                                     qint64 newMemoryBudget, QUndoCommand* parent)
+  : QUndoCommand(QObject::tr("set history size"), parent),
+    m_model(model),
+    m_oldMaxFrames(model->history()->maxFramesPerInput()),
+    m_newMaxFrames(newMaxFrames),
+    m_oldMemoryBudget(model->history()->memoryBudget()),
+    m_newMemoryBudget(newMemoryBudget)
+{
+}
+
+void SetObserverHistorySizeCmd::redo()
+{
+    m_model->doSetHistorySize(m_newMaxFrames, m_newMemoryBudget);
+}
+
+void SetObserverHistorySizeCmd::undo()
+{
+    m_model->doSetHistorySize(m_oldMaxFrames, m_oldMemoryBudget);
+}
@@ -0,0 +1,21 @@
+#include "cmd/SetObserverMaxLatencyCmd.h"
+
+#include "model/ObserverModel.h"
+
+SetObserverMaxLatencyCmd::SetObserverMaxLatencyCmd(ObserverModel* model, int newLatency, QUndoCommand* parent)
+  : QUndoCommand(QObject::tr("set maximal latency"), parent),
+    m_model(model),
+    m_oldLatency(model->maxLatency()),
+    m_newLatency(newLatency)
+{
+}
+
+void SetObserverMaxLatencyCmd::redo()
+{
+    m_model->doSetMaxLatency(m_newLatency);
+}
+
+void SetObserverMaxLatencyCmd::undo()
+{
+    m_model->doSetMaxLatency(m_oldLatency);
+}
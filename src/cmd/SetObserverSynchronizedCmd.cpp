@@ -0,0 +1,21 @@
+#include "cmd/SetObserverSynchronizedCmd.h"
+
+#include "model/ObserverModel.h"
+
+SetObserverSynchronizedCmd::SetObserverSynchronizedCmd(ObserverModel* model, bool newSynchronized, QUndoCommand* parent)
+  : QUndoCommand(QObject::tr("synchronize observer"), parent),
+    m_model(model),
+    m_oldSynchronized(model->isSynchronized()),
+    m_newSynchronized(newSynchronized)
+{
+}
+
+void SetObserverSynchronizedCmd::redo()
+{
+    m_model->doSetSynchronized(m_newSynchronized);
+}
+
+void SetObserverSynchronizedCmd::undo()
+{
+    m_model->doSetSynchronized(m_oldSynchronized);
+}
@@ -20,10 +20,18 @@ SetParameterCmd::~SetParameterCmd()
 
 void SetParameterCmd::redo()
 {
-    m_server->doSetParameter(m_parameter, m_newValue);
+    if(! m_newValue.isNull())
+        m_server->doSetParameter(m_parameter, m_newValue);
 }
 
 void SetParameterCmd::undo()
 {
-    m_server->doSetParameter(m_parameter, m_oldValue);
+    if(! m_oldValue.isNull())
+        m_server->doSetParameter(m_parameter, m_oldValue);
+}
+
+void SetParameterCmd::releaseValues()
+{
+    m_oldValue = stromx::runtime::DataRef();
+    m_newValue = stromx::runtime::DataRef();
 }
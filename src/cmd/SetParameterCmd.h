@@ -36,6 +36,18 @@ public:
     virtual void undo();
     virtual void redo();
     
+    /** Returns the value of the parameter before the command. */
+    const stromx::runtime::DataRef & oldValue() const { return m_oldValue; }
+    
+    /** Returns the value of the parameter after the command. */
+    const stromx::runtime::DataRef & newValue() const { return m_newValue; }
+    
+    /** 
+     * Releases the references to the old and new values. Afterwards undoing
+     * and redoing the command has no effect.
+     */
+    void releaseValues();
+    
 private:
     ParameterServer* m_server;
     unsigned int m_parameter;
@@ -6,17 +6,26 @@
 
 ErrorData::ErrorData()
   : m_time(QDateTime::currentDateTime()),
-    m_type(UNDEFINED)
+    m_lastTime(m_time),
+    m_count(1),
+    m_type(UNDEFINED),
+    m_op(0)
 {
 
 }
 
-ErrorData::ErrorData(const stromx::runtime::OperatorError& exception, Type type)
+ErrorData::ErrorData(const stromx::runtime::OperatorError& exception, Type type,
+                     const stromx::runtime::Operator* op)
   : m_time(QDateTime::currentDateTime()),
-    m_type(type)
+    m_lastTime(m_time),
+    m_count(1),
+    m_type(type),
+    m_op(op),
+    m_opPackage(QString::fromStdString(exception.package())),
+    m_opType(QString::fromStdString(exception.type())),
+    m_opName(QString::fromStdString(exception.name()))
 {
-    QString opType = QString("%1::%2").arg(QString::fromStdString(exception.package()))
-                                      .arg(QString::fromStdString(exception.type()));
+    QString opType = QString("%1::%2").arg(m_opPackage).arg(m_opType);
                                      
     QString errorType;
     switch(type)
@@ -51,3 +60,21 @@ ErrorData::ErrorData(const stromx::runtime::OperatorError& exception, Type type)
     
     m_description = QString::fromStdString(exception.message());
 }
+
+bool ErrorData::isSameError(const ErrorData& other) const
+{
+    return m_type == other.m_type && m_op == other.m_op && m_opPackage == other.m_opPackage
+        && m_opType == other.m_opType && m_opName == other.m_opName
+        && m_description == other.m_description;
+}
+
+void ErrorData::merge(const ErrorData& other)
+{
+    m_count += other.m_count;
+    
+    if(other.m_time < m_time)
+        m_time = other.m_time;
+    
+    if(other.m_lastTime > m_lastTime)
+        m_lastTime = other.m_lastTime;
+}
@@ -27,6 +27,7 @@ namespace stromx
 {
     namespace runtime
     {
+        class Operator;
         class OperatorError;
     }
 }
@@ -37,6 +38,10 @@ namespace stromx
  * This class holds information about an stromx operator exception. In addition
  * to the data contained in the exception it stores its \em type and the time
  * when the exception was caught.
+ * 
+ * Repeated occurrences of the same error can be merged into one error data
+ * object which counts the occurrences and remembers the first and the last
+ * one.
  */
 class ErrorData
 {
@@ -63,8 +68,13 @@ public:
     /** Constructs an error data of an undefined error. */
     ErrorData();
     
-    /** Constructs an error data from a stromx exception and the type of the exception. */
-    ErrorData(const stromx::runtime::OperatorError & exception, Type type);
+    /** 
+     * Constructs an error data from a stromx exception and the type of the exception.
+     * Pass the operator \c op which caused the error if it is known. Otherwise
+     * the operator is identified by its package, type and name only.
+     */
+    ErrorData(const stromx::runtime::OperatorError & exception, Type type,
+              const stromx::runtime::Operator* op = 0);
     
     /** Returns the title of the error. */
     const QString & title() const { return m_title; }
@@ -75,17 +85,43 @@ public:
      */
     const QString & description() const { return m_description; }
     
-    /** Returns the time when the exception was caught. */
+    /** Returns the time when the exception was caught (first). */
     const QDateTime & time() const { return m_time; }
     
+    /** Returns the time when the exception was caught last. */
+    const QDateTime & lastTime() const { return m_lastTime; }
+    
+    /** Returns how often the exception was caught. */
+    int count() const { return m_count; }
+    
     /**  Returns the type of the exception. */
     Type type() const { return m_type; }
+    
+    /** Returns the operator which caused the error or 0 if it is not known. */
+    const stromx::runtime::Operator* op() const { return m_op; }
+    
+    /** 
+     * Returns true if \c other was caused by the same error, i.e. it has the
+     * same type and was thrown by the same operator with the same message.
+     * Errors of operators of the same package, type and name can only be
+     * distinguished if the operators were passed to the constructor.
+     */
+    bool isSameError(const ErrorData & other) const;
+    
+    /** Adds the occurrences of the same error \c other to this error. */
+    void merge(const ErrorData & other);
                          
 private:
     QString m_title;
     QString m_description;
     QDateTime m_time;
+    QDateTime m_lastTime;
+    int m_count;
     Type m_type;
+    const stromx::runtime::Operator* m_op;
+    QString m_opPackage;
+    QString m_opType;
+    QString m_opName;
 };
 
 #endif // ERRORDATA_H
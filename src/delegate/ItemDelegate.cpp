@@ -72,9 +72,6 @@ QWidget* ItemDelegate::createEditor(QWidget* parent, const QStyleOptionViewItem&
     data = index.data(MatrixRole);
     if(data.canConvert<Matrix>())
     {
-        // get the matrix
-        const Matrix matrix = data.value<Matrix>();
-        
         // get and information about the matrix dimensions
         int rows = -1;
         int cols = -1;
@@ -1,10 +1,12 @@
 #include "event/ConnectorDataEvent.h"
 
 ConnectorDataEvent::ConnectorDataEvent(OperatorModel::ConnectorType type, unsigned int id,
-                                       const stromx::runtime::ReadAccess & access)
+                                       const stromx::runtime::ReadAccess & access,
+                                       quint64 sequence)
   : QEvent(Type(TYPE)),
     m_type(type),
     m_id(id),
-    m_access(access)
+    m_access(access),
+    m_sequence(sequence)
 {
 }
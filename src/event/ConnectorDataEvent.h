@@ -32,16 +32,20 @@ public:
     static const unsigned int TYPE = QEvent::User + ConnectorData;
     
     ConnectorDataEvent(OperatorModel::ConnectorType type, unsigned int id,
-                       const stromx::runtime::ReadAccess & access);
+                       const stromx::runtime::ReadAccess & access, quint64 sequence);
     
     OperatorModel::ConnectorType type() const { return m_type; }
     unsigned int id() const { return m_id; }
     const stromx::runtime::ReadAccess & access() const { return m_access; }
     
+    /** Returns the number of data objects which were set to the connector up to this one. */
+    quint64 sequence() const { return m_sequence; }
+    
 private:
     OperatorModel::ConnectorType m_type;
     unsigned int m_id;
     stromx::runtime::ReadAccess m_access;
+    quint64 m_sequence;
 };
 
 #endif // CONNECTORDATAEVENT_H
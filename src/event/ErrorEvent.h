@@ -23,22 +23,20 @@
 #include <QEvent>
 
 #include "Common.h"
-#include "data/ErrorData.h"
 
-/** \brief Event which contains error data. */
+/** 
+ * \brief Event which notifies the receiver of pending errors.
+ * 
+ * The errors themselves are buffered by the exception observer which sent
+ * the event.
+ */
 class ErrorEvent : public QEvent
 {
 public:
     static const unsigned int TYPE = QEvent::User + Error;
     
-    /** Construct an error event from error data. */
-    ErrorEvent(const ErrorData & data) : QEvent(Type(TYPE)), m_data(data) {}
-    
-    /** Returns the error data. */
-    const ErrorData & errorData() const { return m_data; }
-    
-private:
-    ErrorData m_data;
+    /** Constructs an error event. */
+    ErrorEvent() : QEvent(Type(TYPE)) {}
 };
 
 #endif // ERROREVENT_H
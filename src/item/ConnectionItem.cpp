@@ -22,8 +22,11 @@ ConnectionItem::ConnectionItem(ConnectionModel* model, QGraphicsItem* parent)
     m_endArrow(0),
     m_centerArrow(0),
     m_model(model),
+    m_pathIsValid(false),
+    m_geometryUpdatePending(false),
     m_inputOccupied(false),
-    m_outputOccupied(false)
+    m_outputOccupied(false),
+    m_detailed(true)
 {
     Q_ASSERT(model);
     
@@ -37,6 +40,7 @@ ConnectionItem::ConnectionItem(ConnectionModel* model, QGraphicsItem* parent)
     m_endArrow = createDoubleArrow(this);
     m_centerArrow = createDoubleArrow(this);
     
+    updateGeometry();
     update();
 }
 
@@ -75,13 +79,13 @@ QVariant ConnectionItem::itemChange(GraphicsItemChange change, const QVariant &v
 void ConnectionItem::setStart(const QPointF& start)
 {
     m_start = start;
-    update();
+    scheduleGeometryUpdate();
 }
 
 void ConnectionItem::setEnd(const QPointF& end)
 {
     m_end = end;
-    update();
+    scheduleGeometryUpdate();
 }
 
 void ConnectionItem::setColor(const QColor& color)
@@ -90,16 +94,65 @@ void ConnectionItem::setColor(const QColor& color)
     update();
 }
 
-void ConnectionItem::update()
+void ConnectionItem::setDetailed(bool detailed)
+{
+    if(detailed == m_detailed)
+        return;
+    
+    m_detailed = detailed;
+    m_pathIsValid = false;
+    updateGeometry();
+}
+
+void ConnectionItem::scheduleGeometryUpdate()
 {
+    if(m_geometryUpdatePending)
+        return;
+    
+    m_geometryUpdatePending = true;
+    QMetaObject::invokeMethod(this, "updateGeometry", Qt::QueuedConnection);
+}
+
+void ConnectionItem::updateGeometry()
+{
+    m_geometryUpdatePending = false;
+    
     QPointF start(m_start.x() + ConnectorItem::SIZE, m_start.y());
     QPointF end(m_end.x() - ConnectorItem::SIZE, m_end.y());
     
-    QPainterPath path = drawPath(start, end);
-    m_path->setPath(path);
-    m_path->setPen(m_pen);
+    // the shape of the connection did not change if both points moved
+    // together, e.g. while dragging source and target operator
+    if(m_pathIsValid && end - start == m_pathEnd - m_pathStart)
+    {
+        setPos(start - m_pathStart);
+        return;
+    }
+    
+    // compute the path in scene coordinates
+    setPos(0, 0);
+    m_pathStart = start;
+    m_pathEnd = end;
+    m_pathIsValid = true;
+    
+    if(! m_detailed)
+    {
+        QPainterPath path(start);
+        path.lineTo(end);
+        m_path->setPath(path);
+        
+        m_startArrow->setVisible(false);
+        m_endArrow->setVisible(false);
+        m_centerArrow->setVisible(false);
+        return;
+    }
     
+    m_path->setPath(drawPath(start, end));
     updateArrowPositions(start, end);
+}
+
+void ConnectionItem::update()
+{
+    m_path->setPen(m_pen);
     
     QBrush lightBrush = QBrush(m_pen.color().lighter(130));
     QBrush darkBrush =  QBrush(m_pen.color().darker(130));
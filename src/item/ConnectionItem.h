@@ -37,10 +37,16 @@ public:
     enum { Type = UserType + 2 };
     virtual int type() const { return Type; }
     
-    /** Sets the start point of the connection in scene coordinates. */
+    /** 
+     * Sets the start point of the connection in scene coordinates. The geometry
+     * of the connection is updated when control returns to the event loop.
+     */
     void setStart(const QPointF & start);
     
-    /** Sets the end point of the connection in scene coordinates. */
+    /** 
+     * Sets the end point of the connection in scene coordinates. The geometry
+     * of the connection is updated when control returns to the event loop.
+     */
     void setEnd(const QPointF & end);
     
     virtual QRectF boundingRect() const;
@@ -49,6 +55,12 @@ public:
     /** Returns the connection model of this item. */
     ConnectionModel* model() const { return m_model; }
     
+    /** 
+     * Switches between the full display of the connection and a straight
+     * line without arrows if \c detailed is false.
+     */
+    void setDetailed(bool detailed);
+    
 public slots:  
     /**
      * Marks the input connector at this connection as either occupied or
@@ -82,6 +94,13 @@ private slots:
     /** Sets the color of the connection. */
     void setColor(const QColor & color);
     
+    /** 
+     * Updates the path and the arrows to the current start and end point. If
+     * both points moved by the same offset since the path was computed the
+     * item is translated instead.
+     */
+    void updateGeometry();
+    
 private:
     /** 
      * The extra height added to backward point connection to loop around the
@@ -114,12 +133,18 @@ private:
     /** Returns a double arrow shape item as a child of \c parent. */
     static QGraphicsPathItem* createDoubleArrow(QGraphicsItem* parent);
     
-    /** Updates the current geometry and pen settings of the connection. */
+    /** Updates the current pen settings and arrow colors of the connection. */
     void update();
     
+    /** 
+     * Schedules a call of updateGeometry(). Subsequent changes before the
+     * call are combined into a single update.
+     */
+    void scheduleGeometryUpdate();
+    
     /** 
      * Moves and rotates the arrows of the connection such that the fit
-     * the connection. This functions is called by update().
+     * the connection. This functions is called by updateGeometry().
      */
     void updateArrowPositions(const QPointF & start, const QPointF & end);
     
@@ -131,8 +156,13 @@ private:
     QPen m_pen;
     QPointF m_start;
     QPointF m_end;
+    QPointF m_pathStart;
+    QPointF m_pathEnd;
+    bool m_pathIsValid;
+    bool m_geometryUpdatePending;
     bool m_inputOccupied;
     bool m_outputOccupied;
+    bool m_detailed;
 };
 
 #endif // CONNECTIONITEM_H
\ No newline at end of file
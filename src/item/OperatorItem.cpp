@@ -21,7 +21,8 @@ const qreal OperatorItem::CONNECTION_Z_OFFSET = 1.0/100.0;
     
 OperatorItem::OperatorItem(OperatorModel* model, QGraphicsItem * parent)
   : QGraphicsObject(parent),
-    m_model(model)
+    m_model(model),
+    m_detailed(true)
 {
     QPainterPath path;
     path.addRoundedRect(QRectF(-SIZE/2, -SIZE/2, SIZE, SIZE), RADIUS, RADIUS);
@@ -30,11 +31,13 @@ OperatorItem::OperatorItem(OperatorModel* model, QGraphicsItem * parent)
     pen.setWidthF(WIDTH);
     m_opRect->setPen(pen);
     m_opRect->setBrush(Qt::white);
+    m_opRect->setCacheMode(DeviceCoordinateCache);
     setPos(m_model->pos());
     
     m_label = new QGraphicsTextItem(this);
     m_label->setPlainText(QString::fromStdString(m_model->op()->name()));
     m_label->setPos(-m_label->boundingRect().width()/2, SIZE/2 + LABEL_OFFSET);
+    m_label->setCacheMode(DeviceCoordinateCache);
     
     setFlag(ItemIsMovable, true);
     setFlag(ItemIsSelectable, true);
@@ -42,9 +45,13 @@ OperatorItem::OperatorItem(OperatorModel* model, QGraphicsItem * parent)
     setFlag(ItemSendsScenePositionChanges, true);
     
     setInitialized(model->isInitialized());
+    setPending(model->isPending());
+    setHung(model->isHung());
     
     connect(m_model, SIGNAL(nameChanged(QString)), this, SLOT(setName(QString)));
     connect(m_model, SIGNAL(initializedChanged(bool)), this, SLOT(setInitialized(bool)));
+    connect(m_model, SIGNAL(pendingChanged(bool)), this, SLOT(setPending(bool)));
+    connect(m_model, SIGNAL(hungChanged(bool)), this, SLOT(setHung(bool)));
     connect(m_model, SIGNAL(posChanged(QPointF)), this, SLOT(setOperatorPos(QPointF)));
     connect(m_model, SIGNAL(connectorOccupiedChanged(OperatorModel::ConnectorType,uint,bool)),
             this, SLOT(setConnectorOccupied(OperatorModel::ConnectorType,uint,bool)));
@@ -128,6 +135,7 @@ void OperatorItem::initialize()
     {
         ConnectorItem* inputItem = new ConnectorItem(this->m_model, (*iter)->id(), ConnectorItem::INPUT, this);
         inputItem->setPos(inputXPos, firstInputYPos + i*yOffset);
+        inputItem->setVisible(m_detailed);
         
         m_inputs[(*iter)->id()] = inputItem;
     }
@@ -143,6 +151,7 @@ void OperatorItem::initialize()
     {
         ConnectorItem* outputItem = new ConnectorItem(this->m_model, (*iter)->id(), ConnectorItem::OUTPUT, this);
         outputItem->setPos(outputXPos, firstOutputYPos + i*yOffset);
+        outputItem->setVisible(m_detailed);
         
         m_outputs[(*iter)->id()] = outputItem;
     }
@@ -197,6 +206,18 @@ void OperatorItem::removeConnection(ConnectionItem* connection)
     }
 }
 
+void OperatorItem::setDetailed(bool detailed)
+{
+    m_detailed = detailed;
+    m_label->setVisible(m_detailed);
+    
+    foreach(ConnectorItem* input, m_inputs)
+        input->setVisible(m_detailed);
+    
+    foreach(ConnectorItem* output, m_outputs)
+        output->setVisible(m_detailed);
+}
+
 void OperatorItem::updateConnectionPositions()
 {
     QMapIterator<unsigned int, ConnectorItem*> inputIter(m_inputs);
@@ -259,6 +280,28 @@ void OperatorItem::setName(const QString& value)
     m_label->setPos(-m_label->boundingRect().width()/2, SIZE/2 + LABEL_OFFSET);
 }
 
+void OperatorItem::setPending(bool pending)
+{
+    if(pending)
+        m_opRect->setBrush(Qt::lightGray);
+    else
+        m_opRect->setBrush(Qt::white);
+}
+
+void OperatorItem::setHung(bool hung)
+{
+    if(hung)
+    {
+        m_opRect->setBrush(QColor(255, 160, 160));
+        setToolTip(tr("The operator did not make any progress recently."));
+    }
+    else
+    {
+        setPending(m_model->isPending());
+        setToolTip(QString());
+    }
+}
+
 void OperatorItem::resetAllConnectors()
 { 
     QMapIterator<unsigned int, ConnectorItem*> input(m_inputs);
@@ -49,11 +49,23 @@ public:
     void addOutputConnection(unsigned int id, ConnectionItem* connection);
     void removeConnection(ConnectionItem* connection);
     
+    /** 
+     * Shows or hides the label and the connectors of the operator. If \c detailed
+     * is false only the outline of the operator is displayed.
+     */
+    void setDetailed(bool detailed);
+    
 public slots:
     void setInitialized(bool value);
     void setOperatorPos(const QPointF & value);
     void setName(const QString & value);
     
+    /** Displays the operator as pending while it is initialized in the background. */
+    void setPending(bool pending);
+    
+    /** Highlights the operator if it stopped making progress. */
+    void setHung(bool hung);
+    
 protected:
     virtual void mouseReleaseEvent(QGraphicsSceneMouseEvent* event);
     virtual QVariant itemChange(GraphicsItemChange change, const QVariant & value);
@@ -99,6 +111,7 @@ private:
     OperatorModel* m_model;
     QAbstractGraphicsShapeItem* m_opRect;
     QGraphicsTextItem* m_label;
+    bool m_detailed;
     
     QMap<unsigned int, ConnectorItem*> m_inputs;
     QMap<unsigned int, ConnectorItem*> m_outputs;
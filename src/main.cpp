@@ -22,12 +22,16 @@
 #include <QSettings>
 #include <stromx/runtime/Exception.h>
 #include <fstream>
+#include "StartupTimer.h"
 #include "widget/MainWindow.h"
 
 int main(int argc, char *argv[])
 {
+    StartupTimer startupTimer;
+    
     QApplication a(argc, argv);
     a.setWindowIcon(QIcon(":/images/icon.png"));
+    startupTimer.mark("application");
     
     // look here for a transparent splash screen without background:
     // http://developer.qt.nokia.com/wiki/Custom_splashscreen_with_text
@@ -35,14 +39,33 @@ int main(int argc, char *argv[])
     QSplashScreen splash(pixmap);
     splash.show();
     a.processEvents();
+    startupTimer.mark("splash screen");
     
     MainWindow w;
+    startupTimer.mark("main window");
+    
+    startupTimer.observeFirstPaint(&w);
     w.show();
+    startupTimer.mark("show");
     
     QSettings settings("stromx", "stromx-studio");
     bool showOnStartup = settings.value("showFindPackagesOnStartup", true).toBool();
     if (showOnStartup)
         w.findPackages();
+    startupTimer.mark("find packages");
+    
+    // the packages of the recovered stream must be loaded at this point
+    w.recover();
+    startupTimer.mark("recover");
+    
+    // print the startup phases as soon as the main window has been painted
+    if(a.arguments().contains("--startup-timing"))
+    {
+        if(startupTimer.hasFirstPaint())
+            startupTimer.print();
+        else
+            QObject::connect(&startupTimer, SIGNAL(firstPaint()), &startupTimer, SLOT(print()));
+    }
 
     try
     {
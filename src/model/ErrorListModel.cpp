@@ -1,19 +1,26 @@
 #include "model/ErrorListModel.h"
 
 #include <QDebug>
+#include <QTimer>
 #include "event/ErrorEvent.h"
 
 const qint32 ErrorListModel::MAX_ERRORS = 100;
+const int ErrorListModel::TRANSFER_INTERVAL = 200;
 
 ErrorListModel::ErrorListModel(QObject* parent)
   : QAbstractTableModel(parent),
-    m_observer(this)
+    m_observer(this),
+    m_transferTimer(new QTimer(this)),
+    m_transferDeferred(false)
 {
+    m_transferTimer->setSingleShot(true);
+    m_transferTimer->setInterval(TRANSFER_INTERVAL);
+    connect(m_transferTimer, SIGNAL(timeout()), this, SLOT(handleTransferTimeout()));
 }
 
 int ErrorListModel::columnCount(const QModelIndex& /*parent*/) const
 {
-    return 2;
+    return 4;
 }
 
 int ErrorListModel::rowCount(const QModelIndex& /*parent*/) const
@@ -32,7 +39,11 @@ QVariant ErrorListModel::headerData(int section, Qt::Orientation orientation, in
     switch(section)
     {
     case TIME:
-        return tr("Time");
+        return tr("First");
+    case LAST_TIME:
+        return tr("Last");
+    case COUNT:
+        return tr("Count");
     case DESCRIPTION:
         return tr("Description");
     default:
@@ -55,6 +66,10 @@ QVariant ErrorListModel::data(const QModelIndex& index, int role) const
     {
     case TIME:
         return data.time().time().toString();
+    case LAST_TIME:
+        return data.lastTime().time().toString();
+    case COUNT:
+        return data.count();
     case DESCRIPTION:
         if(data.description().isEmpty())
             return data.title();
@@ -71,22 +86,61 @@ void ErrorListModel::customEvent(QEvent* event)
 {
     if(event->type() == ErrorEvent::TYPE)
     {
-        ErrorEvent* errorEvent = reinterpret_cast<ErrorEvent*>(event);
-        
-        // add the error to the list
-        beginInsertRows(QModelIndex(), 0, 0);
-        m_errorList.push_front(errorEvent->errorData());
-        endInsertRows();
-        
-        // if necessary remove errors at the end of the list
-        if(m_errorList.count() > MAX_ERRORS)
+        // update the list at most once per interval
+        if(m_transferTimer->isActive())
+        {
+            m_transferDeferred = true;
+        }
+        else
+        {
+            transferErrors();
+            m_transferTimer->start();
+        }
+    }
+}
+
+void ErrorListModel::handleTransferTimeout()
+{
+    if(m_transferDeferred)
+    {
+        m_transferDeferred = false;
+        transferErrors();
+        m_transferTimer->start();
+    }
+}
+
+void ErrorListModel::transferErrors()
+{
+    foreach(const ErrorData & error, m_observer.takeErrors())
+        addError(error);
+    
+    // if necessary remove errors at the end of the list
+    if(m_errorList.count() > MAX_ERRORS)
+    {
+        beginRemoveRows(QModelIndex(), MAX_ERRORS, m_errorList.count() - 1);
+        while(m_errorList.count() > MAX_ERRORS)
+            m_errorList.removeLast();
+        endRemoveRows();
+    }
+}
+
+void ErrorListModel::addError(const ErrorData& error)
+{
+    // update the row of the error if it is already in the list
+    for(int i = 0; i < m_errorList.count(); ++i)
+    {
+        if(m_errorList[i].isSameError(error))
         {
-            beginRemoveRows(QModelIndex(), MAX_ERRORS, m_errorList.count());
-            while(m_errorList.count() > MAX_ERRORS)
-                m_errorList.removeLast();
-            endRemoveRows();
+            m_errorList[i].merge(error);
+            emit dataChanged(index(i, TIME), index(i, DESCRIPTION));
+            return;
         }
     }
+    
+    // otherwise add the error to the list
+    beginInsertRows(QModelIndex(), 0, 0);
+    m_errorList.push_front(error);
+    endInsertRows();
 }
 
 void ErrorListModel::clear()
@@ -26,12 +26,18 @@
 #include "ExceptionObserver.h"
 #include "data/ErrorData.h"
 
+class QTimer;
+
 /** \brief Model of a list of errors.
  * 
  * This class models a list of errors. It contains a stromx <em>exception observer</em>
  * which asynchronously receives stromx exceptions, converts them to error data objects
- * and sends these as events to the model. Call the member observer() of this observer
- * to add an error to the error list model. 
+ * and buffers them until the model collects them. Call the member observer() of this
+ * observer to add an error to the error list model. 
+ * 
+ * The model collects the errors at most once per TRANSFER_INTERVAL milliseconds.
+ * Repeated occurrences of an error are shown in a single row which displays the number
+ * of occurrences and the time of the first and the last one.
  */
 class ErrorListModel : public QAbstractTableModel
 {
@@ -41,12 +47,19 @@ public:
     /** The columns of the list. */
     enum Column
     {
-        /** The time when the exception causing the error was caught. */
+        /** The time when the exception causing the error was caught first. */
         TIME,
+        /** The time when the exception causing the error was caught last. */
+        LAST_TIME,
+        /** The number of times the error occurred. */
+        COUNT,
         /** A description of the error. */
         DESCRIPTION
     };
     
+    /** The minimal time in milliseconds between two updates of the list. */
+    static const int TRANSFER_INTERVAL;
+    
     /** Constructs a thread list model. */
     explicit ErrorListModel(QObject *parent = 0);
     
@@ -63,15 +76,27 @@ public slots:
     void clear();
     
 protected:
-    /** Receives the error data events which are sent by the exception observer. */
+    /** Receives the error events which are sent by the exception observer. */
     virtual void customEvent(QEvent* event);
     
+private slots:
+    /** Transfers the errors which arrived since the last transfer. */
+    void handleTransferTimeout();
+    
 private:
     /** The maximal amount of errors which which are remembered and displayed. */
     static const qint32 MAX_ERRORS;
     
+    /** Adds the errors which are buffered by the exception observer to the list. */
+    void transferErrors();
+    
+    /** Adds \c error to the list or merges it with the same error in the list. */
+    void addError(const ErrorData & error);
+    
     QList<ErrorData> m_errorList;
     ExceptionObserver m_observer;
+    QTimer* m_transferTimer;
+    bool m_transferDeferred;
 };
     
 #endif // ERRORLISTMODEL_H
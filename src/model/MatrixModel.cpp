@@ -0,0 +1,311 @@
+#include "model/MatrixModel.h"
+
+#include <QRegExp>
+#include <QStringList>
+#include <algorithm>
+#include <climits>
+
+namespace
+{
+    template <class T>
+    T valueAt(const stromx::runtime::Matrix & matrix, const int i, const int j)
+    {
+        switch(matrix.valueType())
+        {
+        case stromx::runtime::Matrix::INT_8:
+            return matrix.at<int8_t>(i, j);
+        case stromx::runtime::Matrix::UINT_8:
+            return matrix.at<uint8_t>(i, j);
+        case stromx::runtime::Matrix::INT_16:
+            return matrix.at<int16_t>(i, j);
+        case stromx::runtime::Matrix::UINT_16:
+            return matrix.at<uint16_t>(i, j);
+        case stromx::runtime::Matrix::INT_32:
+            return matrix.at<int32_t>(i, j);
+        case stromx::runtime::Matrix::UINT_32:
+            return matrix.at<uint32_t>(i, j);
+        case stromx::runtime::Matrix::FLOAT_32:
+            return matrix.at<float>(i, j);
+        case stromx::runtime::Matrix::FLOAT_64:
+            return matrix.at<double>(i, j);
+        case stromx::runtime::Matrix::NONE:
+            return 0.0;
+        }
+        
+        return 0.0;
+    }
+    
+    template <class T>
+    void setValueAt(stromx::runtime::Matrix & matrix,
+                    const int i, const int j, const T value)
+    {
+        switch(matrix.valueType())
+        {
+        case stromx::runtime::Matrix::INT_8:
+            matrix.at<int8_t>(i, j) = value;
+            break;
+        case stromx::runtime::Matrix::UINT_8:
+            matrix.at<uint8_t>(i, j) = value;
+            break;
+        case stromx::runtime::Matrix::INT_16:
+            matrix.at<int16_t>(i, j) = value;
+            break;
+        case stromx::runtime::Matrix::UINT_16:
+            matrix.at<uint16_t>(i, j) = value;
+            break;
+        case stromx::runtime::Matrix::INT_32:
+            matrix.at<int32_t>(i, j) = value;
+            break;
+        case stromx::runtime::Matrix::UINT_32:
+            matrix.at<uint32_t>(i, j) = value;
+            break;
+        case stromx::runtime::Matrix::FLOAT_32:
+            matrix.at<float>(i, j) = value;
+            break;
+        case stromx::runtime::Matrix::FLOAT_64:
+            matrix.at<double>(i, j) = value;
+            break;
+        default:
+            ;
+        }
+    }
+    
+    // The bulk operations process the matrix row by row. Each row is a
+    // contiguous array of T, i.e. the inner loops can be vectorized by the
+    // compiler.
+    
+    template <class T>
+    void fillRows(stromx::runtime::Matrix & matrix, const double value)
+    {
+        const T typedValue = static_cast<T>(value);
+        uint8_t* data = matrix.data();
+        
+        for(unsigned int i = 0; i < matrix.rows(); ++i)
+        {
+            T* row = reinterpret_cast<T*>(data + i * matrix.stride());
+            std::fill(row, row + matrix.cols(), typedValue);
+        }
+    }
+    
+    template <class T>
+    void scaleRows(stromx::runtime::Matrix & matrix, const double factor)
+    {
+        const unsigned int cols = matrix.cols();
+        uint8_t* data = matrix.data();
+        
+        for(unsigned int i = 0; i < matrix.rows(); ++i)
+        {
+            T* row = reinterpret_cast<T*>(data + i * matrix.stride());
+            for(unsigned int j = 0; j < cols; ++j)
+                row[j] = static_cast<T>(row[j] * factor);
+        }
+    }
+    
+    void fillMatrix(stromx::runtime::Matrix & matrix, const double value)
+    {
+        switch(matrix.valueType())
+        {
+        case stromx::runtime::Matrix::INT_8:
+            fillRows<int8_t>(matrix, value);
+            break;
+        case stromx::runtime::Matrix::UINT_8:
+            fillRows<uint8_t>(matrix, value);
+            break;
+        case stromx::runtime::Matrix::INT_16:
+            fillRows<int16_t>(matrix, value);
+            break;
+        case stromx::runtime::Matrix::UINT_16:
+            fillRows<uint16_t>(matrix, value);
+            break;
+        case stromx::runtime::Matrix::INT_32:
+            fillRows<int32_t>(matrix, value);
+            break;
+        case stromx::runtime::Matrix::UINT_32:
+            fillRows<uint32_t>(matrix, value);
+            break;
+        case stromx::runtime::Matrix::FLOAT_32:
+            fillRows<float>(matrix, value);
+            break;
+        case stromx::runtime::Matrix::FLOAT_64:
+            fillRows<double>(matrix, value);
+            break;
+        default:
+            ;
+        }
+    }
+    
+    void scaleMatrix(stromx::runtime::Matrix & matrix, const double factor)
+    {
+        switch(matrix.valueType())
+        {
+        case stromx::runtime::Matrix::INT_8:
+            scaleRows<int8_t>(matrix, factor);
+            break;
+        case stromx::runtime::Matrix::UINT_8:
+            scaleRows<uint8_t>(matrix, factor);
+            break;
+        case stromx::runtime::Matrix::INT_16:
+            scaleRows<int16_t>(matrix, factor);
+            break;
+        case stromx::runtime::Matrix::UINT_16:
+            scaleRows<uint16_t>(matrix, factor);
+            break;
+        case stromx::runtime::Matrix::INT_32:
+            scaleRows<int32_t>(matrix, factor);
+            break;
+        case stromx::runtime::Matrix::UINT_32:
+            scaleRows<uint32_t>(matrix, factor);
+            break;
+        case stromx::runtime::Matrix::FLOAT_32:
+            scaleRows<float>(matrix, factor);
+            break;
+        case stromx::runtime::Matrix::FLOAT_64:
+            scaleRows<double>(matrix, factor);
+            break;
+        default:
+            ;
+        }
+    }
+}
+
+MatrixModel::MatrixModel(const Matrix& matrix, QObject* parent)
+  : QAbstractTableModel(parent),
+    m_matrix(matrix)
+{
+}
+
+int MatrixModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_matrix.rows();
+}
+
+int MatrixModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_matrix.cols();
+}
+
+QVariant MatrixModel::data(const QModelIndex& index, int role) const
+{
+    if(! index.isValid())
+        return QVariant();
+    
+    if(role != Qt::DisplayRole && role != Qt::EditRole)
+        return QVariant();
+    
+    return valueAt<double>(m_matrix, index.row(), index.column());
+}
+
+bool MatrixModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if(! index.isValid() || role != Qt::EditRole)
+        return false;
+    
+    bool ok = false;
+    double doubleValue = value.toDouble(&ok);
+    if(! ok)
+        return false;
+    
+    setValueAt(m_matrix, index.row(), index.column(), doubleValue);
+    emit dataChanged(index, index);
+    
+    return true;
+}
+
+Qt::ItemFlags MatrixModel::flags(const QModelIndex& index) const
+{
+    return QAbstractTableModel::flags(index) | Qt::ItemIsEditable;
+}
+
+bool MatrixModel::resize(int rows, int cols)
+{
+    if(rows < 0 || cols < 0)
+        return false;
+    
+    if(rows == rowCount() && cols == columnCount())
+        return true;
+    
+    // the size of the buffer must be representable by an int
+    qint64 bufferSize = qint64(rows) * qint64(cols) * qint64(m_matrix.valueSize());
+    if(bufferSize > INT_MAX)
+        return false;
+    
+    beginResetModel();
+    
+    Matrix matrix(rows, cols, m_matrix.valueType());
+    uint8_t* data = matrix.data();
+    memset(data, 0, matrix.rows() * matrix.stride());
+    
+    // copy the common values row by row
+    unsigned int commonRows = qMin(m_matrix.rows(), matrix.rows());
+    unsigned int commonCols = qMin(m_matrix.cols(), matrix.cols());
+    const Matrix & oldMatrix = m_matrix;
+    for(unsigned int i = 0; i < commonRows; ++i)
+    {
+        memcpy(data + i * matrix.stride(), oldMatrix.data() + i * oldMatrix.stride(),
+               commonCols * matrix.valueSize());
+    }
+    
+    m_matrix = matrix;
+    
+    endResetModel();
+    
+    return true;
+}
+
+void MatrixModel::fill(double value)
+{
+    fillMatrix(m_matrix, value);
+    emitAllDataChanged();
+}
+
+void MatrixModel::scale(double factor)
+{
+    scaleMatrix(m_matrix, factor);
+    emitAllDataChanged();
+}
+
+bool MatrixModel::paste(const QString& text, const QModelIndex& topLeft)
+{
+    int startRow = topLeft.isValid() ? topLeft.row() : 0;
+    int startCol = topLeft.isValid() ? topLeft.column() : 0;
+    
+    // parse all values before the matrix is changed
+    QList<QList<double> > values;
+    QStringList lines = text.split('\n', QString::SkipEmptyParts);
+    foreach(const QString & line, lines)
+    {
+        QList<double> rowValues;
+        QStringList cells = line.split(QRegExp("[\\t,]"));
+        foreach(const QString & cell, cells)
+        {
+            bool ok = false;
+            double value = cell.trimmed().toDouble(&ok);
+            if(! ok)
+                return false;
+            rowValues.append(value);
+        }
+        values.append(rowValues);
+    }
+    
+    int endRow = qMin(startRow + values.count(), rowCount());
+    int endCol = startCol;
+    for(int i = startRow; i < endRow; ++i)
+    {
+        const QList<double> & rowValues = values[i - startRow];
+        int numCols = qMin(rowValues.count(), columnCount() - startCol);
+        for(int j = 0; j < numCols; ++j)
+            setValueAt(m_matrix, i, startCol + j, rowValues[j]);
+        endCol = qMax(endCol, startCol + numCols);
+    }
+    
+    if(endRow > startRow && endCol > startCol)
+        emit dataChanged(index(startRow, startCol), index(endRow - 1, endCol - 1));
+    
+    return true;
+}
+
+void MatrixModel::emitAllDataChanged()
+{
+    if(rowCount() > 0 && columnCount() > 0)
+        emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+}
@@ -0,0 +1,83 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MATRIXMODEL_H
+#define MATRIXMODEL_H
+
+#include <QAbstractTableModel>
+
+#include "Matrix.h"
+
+/** 
+ * \brief Model of the values of a matrix.
+ *
+ * Each cell of the model corresponds to a value of the matrix. The values are
+ * read from and written to the matrix directly, i.e. views of the model only
+ * access the values of the cells which they actually display. The model
+ * modifies its own copy of the matrix which is returned by matrix().
+ */
+class MatrixModel : public QAbstractTableModel
+{
+    Q_OBJECT
+    
+public:
+    /** Constructs a model of \c matrix. */
+    explicit MatrixModel(const Matrix & matrix, QObject* parent = 0);
+    
+    /** Returns the matrix of the model. */
+    const Matrix & matrix() const { return m_matrix; }
+    
+    virtual int rowCount(const QModelIndex & parent = QModelIndex()) const;
+    virtual int columnCount(const QModelIndex & parent = QModelIndex()) const;
+    virtual QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
+    virtual bool setData(const QModelIndex & index, const QVariant & value, int role = Qt::EditRole);
+    virtual Qt::ItemFlags flags(const QModelIndex & index) const;
+    
+    /** 
+     * Resizes the matrix to \c rows and \c cols. The values which are
+     * contained in both the old and the new matrix are preserved, all other
+     * values are set to 0. Returns false and leaves the matrix unchanged if
+     * the dimensions are negative or if the resized matrix would exceed the
+     * maximal buffer size.
+     */
+    bool resize(int rows, int cols);
+    
+    /** Sets all values of the matrix to \c value. */
+    void fill(double value);
+    
+    /** Multiplies all values of the matrix by \c factor. */
+    void scale(double factor);
+    
+    /** 
+     * Sets the values starting at \c topLeft to the values in \c text. The rows
+     * in \c text are separated by line breaks and the values of a row by tabs or
+     * commas. Values which exceed the matrix are ignored. Returns false and does
+     * not change the matrix if \c text contains invalid values.
+     */
+    bool paste(const QString & text, const QModelIndex & topLeft);
+    
+private:
+    /** Informs the views that all values of the matrix changed. */
+    void emitAllDataChanged();
+    
+    Matrix m_matrix;
+};
+
+#endif // MATRIXMODEL_H
@@ -1,14 +1,23 @@
 #include "model/ObserverModel.h"
 
+#include "FrameHistory.h"
 #include "cmd/RenameObserverCmd.h"
+#include "cmd/SetObserverHistorySizeCmd.h"
+#include "cmd/SetObserverMaxLatencyCmd.h"
+#include "cmd/SetObserverSynchronizedCmd.h"
 #include "data/InputData.h"
 #include "model/InputModel.h"
 #include "model/ObserverTreeModel.h"
 
+const int ObserverModel::DEFAULT_MAX_LATENCY = 500;
+
 ObserverModel::ObserverModel(QUndoStack* undoStack, ObserverTreeModel* parent)
   : QAbstractTableModel(parent),
     m_undoStack(undoStack),
-    m_parent(parent)
+    m_parent(parent),
+    m_history(new FrameHistory(this)),
+    m_synchronized(false),
+    m_maxLatency(DEFAULT_MAX_LATENCY)
 {
     m_name = "New observer";
     
@@ -46,6 +55,59 @@ void ObserverModel::doSetName(const QString& name)
     emit changed(this);
 }
 
+void ObserverModel::setSynchronized(bool synchronized)
+{
+    if(synchronized != m_synchronized)
+    {
+        QUndoCommand* cmd = new SetObserverSynchronizedCmd(this, synchronized);
+        m_undoStack->push(cmd);
+    }
+}
+
+void ObserverModel::doSetSynchronized(bool synchronized)
+{
+    m_synchronized = synchronized;
+    emit synchronizedChanged(m_synchronized);
+    emit changed(this);
+}
+
+void ObserverModel::setMaxLatency(int latency)
+{
+    int truncatedLatency = latency >= 0 ? latency : 0;
+    
+    if(truncatedLatency != m_maxLatency)
+    {
+        QUndoCommand* cmd = new SetObserverMaxLatencyCmd(this, truncatedLatency);
+        m_undoStack->push(cmd);
+    }
+}
+
+void ObserverModel::doSetMaxLatency(int latency)
+{
+    m_maxLatency = latency;
+    emit maxLatencyChanged(m_maxLatency);
+    emit changed(this);
+}
+
+void ObserverModel::setHistorySize(int maxFramesPerInput, qint64 memoryBudget)
+{
+    int truncatedFrames = maxFramesPerInput >= 0 ? maxFramesPerInput : 0;
+    qint64 truncatedBudget = memoryBudget >= 0 ? memoryBudget : 0;
+    
+    if(truncatedFrames != m_history->maxFramesPerInput() || truncatedBudget != m_history->memoryBudget())
+    {
+        QUndoCommand* cmd = new SetObserverHistorySizeCmd(this, truncatedFrames, truncatedBudget);
+        m_undoStack->push(cmd);
+    }
+}
+
+void ObserverModel::doSetHistorySize(int maxFramesPerInput, qint64 memoryBudget)
+{
+    m_history->setMaxFramesPerInput(maxFramesPerInput);
+    m_history->setMemoryBudget(memoryBudget);
+    emit changed(this);
+}
+
 void ObserverModel::insertInput(int position, InputModel* input)
 {
     m_inputs.insert(position, input);
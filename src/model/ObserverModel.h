@@ -23,6 +23,7 @@
 #include <QAbstractTableModel>
 
 class QUndoStack;
+class FrameHistory;
 class InputModel;
 class ObserverTreeModel;
 
@@ -39,6 +40,9 @@ class ObserverModel : public QAbstractTableModel
     Q_OBJECT
     
     friend class RenameObserverCmd;
+    friend class SetObserverHistorySizeCmd;
+    friend class SetObserverMaxLatencyCmd;
+    friend class SetObserverSynchronizedCmd;
 
 public:
     /** Constructs an observer model. */
@@ -80,6 +84,28 @@ public:
     /** Returns the undo stack. */
     QUndoStack* undoStack() const { return m_undoStack; }
     
+    /** 
+     * Returns true if the layers of the observer are synchronized. In this case
+     * data which was observed at different inputs is only displayed together if
+     * it belongs to the same iteration of the stream.
+     */
+    bool isSynchronized() const { return m_synchronized; }
+    
+    /** 
+     * Returns the maximal time in milliseconds observed data is held back
+     * while waiting for matching data at the other inputs of a synchronized observer.
+     */
+    int maxLatency() const { return m_maxLatency; }
+    
+    /** Returns the history of the data which was displayed by the observer. */
+    FrameHistory* history() const { return m_history; }
+    
+    /** 
+     * Sets the maximal number of frames per input and the memory budget in bytes
+     * of the history.
+     */
+    void setHistorySize(int maxFramesPerInput, qint64 memoryBudget);
+    
     /** Emits data changed. This function is called by the parent model. */
     void emitDataChanged(const int topRow, const int bottomRow);
     
@@ -95,6 +121,13 @@ public:
     virtual Qt::DropActions supportedDragActions () const;
     virtual Qt::ItemFlags flags(const QModelIndex& index) const;
     
+public slots:
+    /** Activates or deactivates the synchronization of the layers of the observer. */
+    void setSynchronized(bool synchronized);
+    
+    /** Sets the maximal latency of a synchronized observer in milliseconds. */
+    void setMaxLatency(int latency);
+    
 signals:
     /** The name of the observer changed. */
     void nameChanged(const QString & name);
@@ -102,6 +135,12 @@ signals:
     /** A property of the observer changed. */
     void changed(ObserverModel* observer);
     
+    /** The synchronization of the observer layers was activated or deactivated. */
+    void synchronizedChanged(bool synchronized);
+    
+    /** The maximal latency of a synchronized observer changed. */
+    void maxLatencyChanged(int latency);
+    
     /** An input was removed from the model. */
     void inputRemoved(InputModel* input, int pos);
     
@@ -156,9 +195,21 @@ private slots:
                           ObserverModel* destObserver, int destPos);
     
 private:
+    /** The default maximal latency of synchronized observers in milliseconds. */
+    static const int DEFAULT_MAX_LATENCY;
+    
     /** Sets the name. */
     void doSetName(const QString & name);
     
+    /** Sets the synchronization. */
+    void doSetSynchronized(bool synchronized);
+    
+    /** Sets the maximal latency. */
+    void doSetMaxLatency(int latency);
+    
+    /** Sets the size of the history. */
+    void doSetHistorySize(int maxFramesPerInput, qint64 memoryBudget);
+    
     /** 
      * Returns true if \c parentModelIndex in the parent model refers to an
      * index of this observer.
@@ -169,6 +220,9 @@ private:
     ObserverTreeModel* m_parent;
     QList<InputModel*> m_inputs;
     QString m_name;
+    FrameHistory* m_history;
+    bool m_synchronized;
+    int m_maxLatency;
 };
 
 #endif // OBSERVERMODEL_H
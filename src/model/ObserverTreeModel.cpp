@@ -8,6 +8,7 @@
 #include <QDataStream>
 #include <QStringList>
 #include "Common.h"
+#include "FrameHistory.h"
 #include "cmd/InsertInputCmd.h"
 #include "cmd/InsertObserverCmd.h"
 #include "cmd/MoveInputCmd.h"
@@ -550,6 +551,79 @@ QDataStream& readVersion01(QDataStream& stream, ObserverTreeModel* model)
     return stream;
 }
 
+void ObserverTreeModel::write(QDataStream& stream) const
+{
+    stream << qint32(m_observers.count());
+    foreach(ObserverModel* observer, m_observers)
+    {
+        stream << observer->name();
+        stream << observer->isSynchronized();
+        stream << qint32(observer->maxLatency());
+        stream << qint32(observer->history()->maxFramesPerInput());
+        stream << qint64(observer->history()->memoryBudget());
+        
+        stream << qint32(observer->numInputs());
+        foreach(InputModel* input, observer->inputs())
+        {
+            stream << qint32(m_stream->operatorId(input->op()));
+            stream << quint32(input->id());
+            stream << input;
+        }
+    }
+}
+
+void ObserverTreeModel::read(QDataStream& stream)
+{
+    qint32 observerCount = 0;
+    stream >> observerCount;
+    
+    for(int i = 0; i < observerCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString name;
+        bool synchronized = false;
+        qint32 maxLatency = 0;
+        qint32 historyFrames = 0;
+        qint64 historyBudget = 0;
+        qint32 inputCount = 0;
+        
+        stream >> name >> synchronized >> maxLatency >> historyFrames >> historyBudget;
+        stream >> inputCount;
+        
+        ObserverModel* observer = new ObserverModel(m_undoStack, this);
+        QObject::connect(observer, SIGNAL(changed(ObserverModel*)), this, SLOT(updateObserver(ObserverModel*)));
+        observer->setName(name);
+        observer->setSynchronized(synchronized);
+        observer->setMaxLatency(maxLatency);
+        observer->history()->setMaxFramesPerInput(historyFrames);
+        observer->history()->setMemoryBudget(historyBudget);
+        
+        for(int j = 0; j < inputCount && stream.status() == QDataStream::Ok; ++j)
+        {
+            qint32 opId = 0;
+            quint32 inputId = 0;
+            stream >> opId >> inputId;
+            
+            if(opId < 0 || opId >= m_stream->operators().count())
+            {
+                // skip the visualization state of inputs of unknown operators
+                VisualizationState state;
+                stream >> state;
+                continue;
+            }
+            
+            OperatorModel* op = m_stream->operators()[opId];
+            InputModel* input = new InputModel(op, inputId, m_undoStack, this);
+            input->setParentModel(observer);
+            stream >> input;
+            
+            observer->insertInput(observer->numInputs(), input);
+            connect(input, SIGNAL(changed(InputModel*)), this, SLOT(updateInput(InputModel*)));
+        }
+        
+        m_observers.append(observer);
+    }
+}
+
 #ifndef STROMX_STUDIO_QT4
 void ObserverTreeModel::write(QJsonArray & json) const
 {
@@ -557,6 +631,10 @@ void ObserverTreeModel::write(QJsonArray & json) const
     {
         QJsonObject viewData;
         viewData["name"] = observer->name();
+        viewData["synchronized"] = observer->isSynchronized();
+        viewData["maxLatency"] = observer->maxLatency();
+        viewData["historyFrames"] = observer->history()->maxFramesPerInput();
+        viewData["historyBudget"] = static_cast<double>(observer->history()->memoryBudget());
         
         QJsonArray inputs;
         for (int i = 0; i < observer->inputs().count(); ++i)
@@ -593,6 +671,18 @@ void ObserverTreeModel::read(const QJsonArray & json)
         
         observer->setName(viewData["name"].toString());
         
+        // the synchronization settings are optional
+        if (viewData.contains("synchronized"))
+            observer->setSynchronized(viewData["synchronized"].toBool());
+        if (viewData.contains("maxLatency"))
+            observer->setMaxLatency(viewData["maxLatency"].toDouble());
+        
+        // so are the history settings
+        if (viewData.contains("historyFrames"))
+            observer->history()->setMaxFramesPerInput(viewData["historyFrames"].toDouble());
+        if (viewData.contains("historyBudget"))
+            observer->history()->setMemoryBudget(viewData["historyBudget"].toDouble());
+        
         QJsonArray inputs = viewData["observers"].toArray();
         foreach(QJsonValue input, inputs)
         {            
@@ -117,6 +117,18 @@ public:
     /** Returns the model index for the observer at position \c observerPos. */
     QModelIndex observerIndex(const int observerPos);
     
+    /** 
+     * Writes the observer tree including the synchronization and history settings
+     * of the observers to \c stream. 
+     */
+    void write(QDataStream & stream) const;
+    
+    /** 
+     * Appends the observers in \c stream to the content of the observer tree.
+     * Inputs of operators which do not exist are skipped.
+     */
+    void read(QDataStream & stream);
+    
 #ifndef STROMX_STUDIO_QT4
     /** Writes the observer tree to \c json. */
     void write(QJsonArray & json) const;
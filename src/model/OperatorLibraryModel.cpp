@@ -5,7 +5,9 @@
 #include <QDirIterator>
 #include <QFileInfo>
 #include <QLibrary>
+#include <QSet>
 #include <QSettings>
+#include <QtConcurrentMap>
 #include <stromx/runtime/Runtime.h>
 #include <stromx/runtime/Factory.h>
 #include <stromx/runtime/Operator.h>
@@ -30,6 +32,7 @@ OperatorLibraryModel::OperatorLibraryModel(QObject* parent)
     m_factory(0)
 {
     setupFactory();
+    readCache();
     updateOperators();
     
     QSettings settings("stromx", "stromx-studio");
@@ -103,7 +106,7 @@ QVariant OperatorLibraryModel::data(const QModelIndex& index, int role) const
     Item* item = static_cast<Item*>(index.internalPointer());
     
     // index is a package
-    if (item->op == 0)
+    if (! item->isOperator())
     {
         if(index.column() == 0)
             return item->package;
@@ -113,17 +116,9 @@ QVariant OperatorLibraryModel::data(const QModelIndex& index, int role) const
     
     // index is an operator
     if(index.column() == 0)
-    {
-        return QString::fromStdString(item->op->type());
-    }
+        return item->type;
     else
-    {
-        QString version = QString("%1.%2.%3")
-                          .arg(item->op->version().major())
-                          .arg(item->op->version().minor())
-                          .arg(item->op->version().revision());
-        return version;
-    }
+        return item->version;
 }
 
 int OperatorLibraryModel::columnCount(const QModelIndex& /*parent*/) const
@@ -141,9 +136,119 @@ int OperatorLibraryModel::rowCount(const QModelIndex& parent) const
 }
 
 void OperatorLibraryModel::loadPackage(const QString& packagePath)
+{
+    addPackage(packagePath);
+    
+    // save the package list
+    QSettings settings("stromx", "stromx-studio");
+    settings.setValue("loadedPackages", m_loadedPackages);
+        
+    updateOperators();
+}
+
+QStringList OperatorLibraryModel::loadPackages(const QStringList& packagePaths)
+{
+    QStringList failedPackages;
+    QStringList uncachedPackages;
+    foreach(const QString & packagePath, packagePaths)
+    {
+        if(! addCachedPackage(packagePath))
+            uncachedPackages.append(packagePath);
+    }
+    
+    // load the shared libraries concurrently
+    QList<ResolvedPackage> resolvedPackages = 
+        QtConcurrent::blockingMapped<QList<ResolvedPackage> >(uncachedPackages, &OperatorLibraryModel::resolvePackage);
+    
+    // the registration changes the factory, i.e. it must not run concurrently
+    foreach(const ResolvedPackage & package, resolvedPackages)
+    {
+        try
+        {
+            QList<CachedOperator> operators = registerOperators(package.function);
+            m_loadedPackages.append(package.path);
+            cachePackage(package.path, operators);
+        }
+        catch(LoadPackageFailed&)
+        {
+            failedPackages.append(package.path);
+        }
+    }
+    
+    if(! resolvedPackages.isEmpty())
+        writeCache();
+    
+    // save the package list
+    QSettings settings("stromx", "stromx-studio");
+    settings.setValue("loadedPackages", m_loadedPackages);
+    
+    // update the operators only once for all packages
+    updateOperators();
+    
+    return failedPackages;
+}
+
+void OperatorLibraryModel::addPackage(const QString& packagePath)
+{
+    if(addCachedPackage(packagePath))
+        return;
+    
+    QList<CachedOperator> operators = registerPackage(packagePath);
+    
+    // remember the package
+    m_loadedPackages.append(packagePath);
+    
+    cachePackage(packagePath, operators);
+    writeCache();
+}
+
+bool OperatorLibraryModel::addCachedPackage(const QString& packagePath)
+{
+    QFileInfo info(packagePath);
+    QString filePath = info.absoluteFilePath();
+    
+    if(! info.exists() || ! m_cache.contains(filePath))
+        return false;
+    
+    const CacheEntry & entry = m_cache[filePath];
+    if(entry.modified != info.lastModified() || entry.size != info.size())
+        return false;
+    
+    m_pendingPackages[packagePath] = entry.operators;
+    m_loadedPackages.append(packagePath);
+    
+    return true;
+}
+
+void OperatorLibraryModel::cachePackage(const QString& packagePath, const QList<CachedOperator> & operators)
 {
     QFileInfo info(packagePath);
     
+    // packages which are not specified by their file (e.g. only by their
+    // library name) are not cached
+    if(! info.exists())
+        return;
+    
+    CacheEntry entry;
+    entry.modified = info.lastModified();
+    entry.size = info.size();
+    entry.operators = operators;
+    m_cache[info.absoluteFilePath()] = entry;
+}
+
+QList<OperatorLibraryModel::CachedOperator> OperatorLibraryModel::registerPackage(const QString& packagePath)
+{
+    return registerOperators(resolvePackage(packagePath).function);
+}
+
+OperatorLibraryModel::ResolvedPackage OperatorLibraryModel::resolvePackage(const QString& packagePath)
+{
+    ResolvedPackage package;
+    package.path = packagePath;
+    package.function = 0;
+    
+    QFileInfo info(packagePath);
+    
 #ifdef UNIX
     QRegExp regEx("lib(.+)_(.+)");
 #endif // UNIX
@@ -154,49 +259,172 @@ void OperatorLibraryModel::loadPackage(const QString& packagePath)
     
     regEx.indexIn(info.baseName());
     if(regEx.captureCount() != 2)
-        throw LoadPackageFailed();
+        return package;
     
     QString prefix = regEx.cap(1);
     QString postfix = regEx.cap(2);
     postfix[0] = postfix[0].toUpper();
     QString registrationFunctionName = prefix + "Register" + postfix;
     
-    QLibrary* lib = new QLibrary(packagePath, this);
+    // resolve the registration function, the library stays loaded when
+    // the QLibrary object is destroyed
+    QLibrary lib(packagePath);
+    package.function = reinterpret_cast<RegistrationFunction>
+        (lib.resolve(registrationFunctionName.toStdString().c_str()));
     
-    // resolve the registration function
-    int (*registrationFunction)(stromx::runtime::Registry* registry);
-    registrationFunction = reinterpret_cast<int (*)(stromx::runtime::Registry* registry)>
-        (lib->resolve(registrationFunctionName.toStdString().c_str()));
-        
-    if(! registrationFunction)
-    {
-        delete lib;
+    return package;
+}
+
+QList<OperatorLibraryModel::CachedOperator> OperatorLibraryModel::registerOperators(RegistrationFunction function)
+{
+    if(! function)
         throw LoadPackageFailed();
-    }
+    
+    // remember the operators which are registered before
+    typedef std::vector<const stromx::runtime::OperatorKernel*> OperatorKernelList;
+    const OperatorKernelList & kernels = m_factory->availableOperators();
+    QSet<const stromx::runtime::OperatorKernel*> previousKernels;
+    for(OperatorKernelList::const_iterator iter = kernels.begin(); iter != kernels.end(); ++iter)
+        previousKernels.insert(*iter);
     
     // try to register the library
-    if((*registrationFunction)(m_factory))
+    if((*function)(m_factory))
     {
         // even if an exception was thrown, parts of the library might have been loaded
         // therefore the library is not closed
         throw LoadPackageFailed();
     }
     
-    // remember the package
-    m_loadedPackages.append(packagePath);
+    // return the new operators
+    QList<CachedOperator> operators;
+    for(OperatorKernelList::const_iterator iter = m_factory->availableOperators().begin();
+        iter != m_factory->availableOperators().end();
+        ++iter)
+    {
+        if(previousKernels.contains(*iter))
+            continue;
+        
+        CachedOperator op;
+        op.package = QString::fromStdString((*iter)->package());
+        op.type = QString::fromStdString((*iter)->type());
+        op.version = QString("%1.%2.%3")
+                     .arg((*iter)->version().major())
+                     .arg((*iter)->version().minor())
+                     .arg((*iter)->version().revision());
+        operators.append(op);
+    }
     
-    // save the package list
-    QSettings settings("stromx", "stromx-studio");
-    settings.setValue("loadedPackages", m_loadedPackages);
+    return operators;
+}
+
+void OperatorLibraryModel::loadPendingPackage(const QString& packagePath)
+{
+    QList<CachedOperator> cachedOperators = m_pendingPackages.take(packagePath);
+    QFileInfo info(packagePath);
+    
+    try
+    {
+        QList<CachedOperator> operators = registerPackage(packagePath);
         
+        // nothing to do if the cache was correct
+        if(operators == cachedOperators)
+            return;
+        
+        m_cache[info.absoluteFilePath()].operators = operators;
+    }
+    catch(LoadPackageFailed&)
+    {
+        qWarning() << "Failed to load" << packagePath;
+        
+        m_loadedPackages.removeAll(packagePath);
+        m_cache.remove(info.absoluteFilePath());
+        
+        QSettings settings("stromx", "stromx-studio");
+        settings.setValue("loadedPackages", m_loadedPackages);
+    }
+    
+    writeCache();
     updateOperators();
 }
 
+void OperatorLibraryModel::loadPendingPackages()
+{
+    foreach(const QString & packagePath, m_pendingPackages.keys())
+        loadPendingPackage(packagePath);
+}
+
+void OperatorLibraryModel::readCache()
+{
+    QSettings settings("stromx", "stromx-studio");
+    int numEntries = settings.beginReadArray("packageCache");
+    for(int i = 0; i < numEntries; ++i)
+    {
+        settings.setArrayIndex(i);
+        
+        CacheEntry entry;
+        entry.modified = settings.value("modified").toDateTime();
+        entry.size = settings.value("size").toLongLong();
+        
+        QStringList packages = settings.value("packages").toStringList();
+        QStringList types = settings.value("types").toStringList();
+        QStringList versions = settings.value("versions").toStringList();
+        
+        // ignore corrupt entries
+        if(types.count() != packages.count() || versions.count() != packages.count())
+            continue;
+        
+        for(int j = 0; j < packages.count(); ++j)
+        {
+            CachedOperator op;
+            op.package = packages[j];
+            op.type = types[j];
+            op.version = versions[j];
+            entry.operators.append(op);
+        }
+        
+        m_cache[settings.value("path").toString()] = entry;
+    }
+    settings.endArray();
+}
+
+void OperatorLibraryModel::writeCache() const
+{
+    QSettings settings("stromx", "stromx-studio");
+    settings.remove("packageCache");
+    settings.beginWriteArray("packageCache", m_cache.count());
+    
+    int i = 0;
+    QHash<QString, CacheEntry>::const_iterator iter;
+    for(iter = m_cache.constBegin(); iter != m_cache.constEnd(); ++iter, ++i)
+    {
+        QStringList packages;
+        QStringList types;
+        QStringList versions;
+        foreach(const CachedOperator & op, iter.value().operators)
+        {
+            packages.append(op.package);
+            types.append(op.type);
+            versions.append(op.version);
+        }
+        
+        settings.setArrayIndex(i);
+        settings.setValue("path", iter.key());
+        settings.setValue("modified", iter.value().modified);
+        settings.setValue("size", iter.value().size);
+        settings.setValue("packages", packages);
+        settings.setValue("types", types);
+        settings.setValue("versions", versions);
+    }
+    
+    settings.endArray();
+}
+
 void OperatorLibraryModel::resetLibrary()
 {
     delete m_factory;
     m_factory = 0;
     m_loadedPackages.clear();
+    m_pendingPackages.clear();
     
     setupFactory();
     updateOperators();
@@ -221,43 +449,56 @@ void OperatorLibraryModel::updateOperators()
     delete m_root;
     m_root = new Item;
     
-    QMap<QString, Item*> package2ItemMap;
+    // collect the registered operators and the ones of pending packages
+    QList<CachedOperator> operators;
     
     typedef std::vector<const stromx::runtime::OperatorKernel*> OperatorKernelList;
     for(OperatorKernelList::const_iterator iter = m_factory->availableOperators().begin();
         iter != m_factory->availableOperators().end();
         ++iter)
     {
-        QString package = QString::fromStdString((*iter)->package());
-        
-        QStringList parts = package.split("::");
+        CachedOperator op;
+        op.package = QString::fromStdString((*iter)->package());
+        op.type = QString::fromStdString((*iter)->type());
+        op.version = QString("%1.%2.%3")
+                     .arg((*iter)->version().major())
+                     .arg((*iter)->version().minor())
+                     .arg((*iter)->version().revision());
+        operators.append(op);
+    }
+    
+    foreach(const QList<CachedOperator> & pendingOperators, m_pendingPackages)
+        operators.append(pendingOperators);
+    
+    // the package items by their full name
+    QHash<QString, Item*> packageItems;
+    
+    foreach(const CachedOperator & op, operators)
+    {
+        QStringList parts = op.package.split("::");
         Item* root = m_root;
+        QString name;
         foreach (QString part, parts)
         {
-            // find the item
-            Item* partItem = 0;
-            foreach (Item* item, root->children)
-            {
-                if (item->package == part)
-                {
-                    partItem = item;
-                    break;
-                }
-            }
+            name = name.isEmpty() ? part : name + "::" + part;
             
+            Item* partItem = packageItems.value(name, 0);
             if (partItem == 0)
             {
                 partItem = new Item;
                 partItem->package = part;
                 partItem->parent = root;
                 root->children.append(partItem);
+                packageItems[name] = partItem;
             }
             
             root = partItem;
         }
         
         Item* opItem = new Item;
-        opItem->op = *iter;
+        opItem->package = op.package;
+        opItem->type = op.type;
+        opItem->version = op.version;
         opItem->parent = root;
         root->children.append(opItem);
     }
@@ -281,22 +522,39 @@ QVariant OperatorLibraryModel::headerData(int section, Qt::Orientation orientati
 bool OperatorLibraryModel::isOperator(const QModelIndex& index) const
 {
     Item* item = static_cast<Item*>(index.internalPointer());
-    return item->op != 0;
+    return item->isOperator();
 }
 
 OperatorData* OperatorLibraryModel::newOperatorData(const QModelIndex& index) const
 {
     Item* item = static_cast<Item*>(index.internalPointer());
     
-    if (! item->op)
+    if (! item->isOperator())
         return 0;
     
-    const stromx::runtime::OperatorKernel* op = item->op;
-    return new OperatorData(QString::fromStdString(op->package()), QString::fromStdString(op->type()));
+    return new OperatorData(item->package, item->type);
 }
 
-stromx::runtime::OperatorKernel* OperatorLibraryModel::newOperator(const OperatorData* data) const
+stromx::runtime::OperatorKernel* OperatorLibraryModel::newOperator(const OperatorData* data)
 {
+    // load the package of the operator if it was added from the cache
+    QString pendingPackage;
+    QMap<QString, QList<CachedOperator> >::const_iterator iter;
+    for(iter = m_pendingPackages.constBegin(); iter != m_pendingPackages.constEnd() && pendingPackage.isEmpty(); ++iter)
+    {
+        foreach(const CachedOperator & op, iter.value())
+        {
+            if(op.package == data->package() && op.type == data->type())
+            {
+                pendingPackage = iter.key();
+                break;
+            }
+        }
+    }
+    
+    if(! pendingPackage.isEmpty())
+        loadPendingPackage(pendingPackage);
+    
     try
     {
         return m_factory->newOperator(data->package().toStdString(), data->type().toStdString());
@@ -307,6 +565,12 @@ stromx::runtime::OperatorKernel* OperatorLibraryModel::newOperator(const Operato
     }
 }
 
+stromx::runtime::Factory* OperatorLibraryModel::factory()
+{
+    loadPendingPackages();
+    return m_factory;
+}
+
 QFileInfoList OperatorLibraryModel::findInstalledPackages()
 {
     QStringList packages;
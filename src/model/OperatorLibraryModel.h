@@ -21,7 +21,9 @@
 #define OPERATORLIBRARYMODEL_H
 
 #include <QAbstractItemModel>
+#include <QDateTime>
 #include <QFileInfoList>
+#include <QHash>
 #include <QMap>
 #include <QVector>
 #include <QStringList>
@@ -32,6 +34,7 @@ namespace stromx
     {
         class Factory;
         class OperatorKernel;
+        class Registry;
     }
 }
 
@@ -52,6 +55,12 @@ class OperatorData;
  * 
  * Internally, the operators in the operator list are stored in a stromx
  * factory.
+ * 
+ * The operators of each package file are remembered in a persistent cache
+ * together with the modification time and the size of the file. If a package
+ * is found in the cache its operators are added to the library without
+ * loading the shared library. The package is loaded as soon as one of its
+ * operators is allocated or the factory is accessed.
  */
 class OperatorLibraryModel : public QAbstractItemModel
 {
@@ -86,9 +95,22 @@ public:
     virtual int rowCount(const QModelIndex & parent) const;
     virtual int columnCount(const QModelIndex & parent) const;
     
-    /** Load the operator package located at \c packagePath. */
+    /** 
+     * Load the operator package located at \c packagePath. If the package is
+     * in the cache and did not change its shared library is loaded on demand.
+     * 
+     * \throws LoadPackageFailed
+     */
     void loadPackage(const QString& packagePath);
     
+    /** 
+     * Loads the operator packages located at \c packagePaths and updates the
+     * library once afterwards. The shared libraries are loaded concurrently
+     * but their operators are registered one after another. Returns the
+     * packages which could not be loaded.
+     */
+    QStringList loadPackages(const QStringList & packagePaths);
+    
     /** 
      * Removes all previously loaded packages from the library.
      * All packages which have been loaded in the constructor are
@@ -111,12 +133,20 @@ public:
      * Allocates and returns a stromx operator from \c data. The client is 
      * responsible for deleting the returned operator. If the operator 
      * can not be allocated (e.g. \c data does not refer to an operator contained
-     * in the library) 0 is returned.
+     * in the library) 0 is returned. The package of the operator is loaded
+     * if necessary.
      */
-    stromx::runtime::OperatorKernel* newOperator(const OperatorData* data) const;
+    stromx::runtime::OperatorKernel* newOperator(const OperatorData* data);
     
-    /** Returns a reference to the stromx factory of the operator library. */
-    stromx::runtime::Factory* factory() const { return m_factory; }
+    /** 
+     * Returns a reference to the stromx factory of the operator library. All
+     * packages which have not been loaded yet are loaded before because the
+     * client might need any of the registered operators or data types.
+     */
+    stromx::runtime::Factory* factory();
+    
+    /** Returns true if some packages of the library are not loaded yet. */
+    bool hasPendingPackages() const { return ! m_pendingPackages.isEmpty(); }
     
     /** 
      * Searches for stromx packages on the host and returns a list of the found 
@@ -127,21 +157,102 @@ public:
 private:
     struct Item
     {
-        Item() : op(0), parent(0) {}
+        Item() : parent(0) {}
         ~Item();
         
+        /** Returns true if the item is an operator and not a package. */
+        bool isOperator() const { return ! type.isEmpty(); }
+        
+        // the full package name of operators, the last part of the name of packages
         QString package;
-        const stromx::runtime::OperatorKernel* op;
+        QString type;
+        QString version;
         Item* parent;
         QList<Item*> children;
     };
     
+    struct CachedOperator
+    {
+        bool operator==(const CachedOperator & other) const
+        {
+            return package == other.package && type == other.type && version == other.version;
+        }
+        
+        QString package;
+        QString type;
+        QString version;
+    };
+    
+    struct CacheEntry
+    {
+        QDateTime modified;
+        qint64 size;
+        QList<CachedOperator> operators;
+    };
+    
+    typedef int (*RegistrationFunction)(stromx::runtime::Registry* registry);
+    
+    struct ResolvedPackage
+    {
+        QString path;
+        RegistrationFunction function;
+    };
+    
+    /** Adds the package to the library without updating the operator tree. */
+    void addPackage(const QString & packagePath);
+    
+    /** 
+     * Adds the package to the library if it is contained in the cache and
+     * did not change. Returns false otherwise.
+     */
+    bool addCachedPackage(const QString & packagePath);
+    
+    /** Stores the operators of the package in the cache (but not in the settings). */
+    void cachePackage(const QString & packagePath, const QList<CachedOperator> & operators);
+    
+    /** 
+     * Loads the shared library at \c packagePath and resolves its registration
+     * function. The function is 0 if the library can not be loaded. This
+     * function can be called from any thread.
+     */
+    static ResolvedPackage resolvePackage(const QString & packagePath);
+    
+    /** 
+     * Registers the operators of a package with the factory by calling 
+     * \c function. Returns the operators which were registered.
+     * 
+     * \throws LoadPackageFailed
+     */
+    QList<CachedOperator> registerOperators(RegistrationFunction function);
+    
+    /** 
+     * Loads the shared library at \c packagePath and registers its operators
+     * with the factory. Returns the operators which were registered.
+     * 
+     * \throws LoadPackageFailed
+     */
+    QList<CachedOperator> registerPackage(const QString & packagePath);
+    
+    /** 
+     * Loads the package \c packagePath which was added from the cache. Updates
+     * the library and the cache if the package can not be loaded or if
+     * its operators differ from the cached ones.
+     */
+    void loadPendingPackage(const QString & packagePath);
+    
+    /** Loads all packages which were added from the cache. */
+    void loadPendingPackages();
+    
+    void readCache();
+    void writeCache() const;
     void updateOperators();
     void setupFactory();
     
     Item* m_root;
     QStringList m_loadedPackages;
     stromx::runtime::Factory* m_factory;
+    QHash<QString, CacheEntry> m_cache;
+    QMap<QString, QList<CachedOperator> > m_pendingPackages;
 };
 
 #endif // OPERATORLIBRARYMODEL_H
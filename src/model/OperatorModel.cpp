@@ -10,6 +10,7 @@
 #include "Common.h"
 #include "ConnectorObserver.h"
 #include "DataConverter.h"
+#include "DataRouter.h"
 #include "ParameterServer.h"
 #include "StreamModel.h"
 #include "cmd/MoveOperatorCmd.h"
@@ -28,7 +29,10 @@ OperatorModel::OperatorModel(stromx::runtime::Operator* op, StreamModel* stream)
     m_type(QString::fromStdString(m_op->info().type())),
     m_name(QString::fromStdString(m_op->name())),
     m_observer(this),
-    m_server(new ParameterServer(op, stream->undoStack(), this))
+    m_server(new ParameterServer(op, stream->undoStack(), this)),
+    m_pending(false),
+    m_hung(false),
+    m_lastAccessTimeout(0)
 {
     Q_ASSERT(m_op);
     
@@ -42,6 +46,7 @@ OperatorModel::OperatorModel(stromx::runtime::Operator* op, StreamModel* stream)
     m_server->setAccessTimeout(m_stream->accessTimeout());
     
     // Activate and deactivate when the stream stream starts/stop
+    connect(m_stream, SIGNAL(streamStarting()), this, SLOT(setActiveTrue()));
     connect(m_stream, SIGNAL(streamStarted()), this, SLOT(setActiveTrue()));
     connect(m_stream, SIGNAL(streamJoined()), this, SLOT(setActiveFalse()));
     
@@ -50,6 +55,7 @@ OperatorModel::OperatorModel(stromx::runtime::Operator* op, StreamModel* stream)
     
     // forward the parameter server signals
     connect(m_server, SIGNAL(parameterAccessTimedOut()), this, SIGNAL(operatorAccessTimedOut()));
+    connect(m_server, SIGNAL(parameterAccessTimedOut()), this, SLOT(handleAccessTimeout()));
     connect(m_server, SIGNAL(parameterErrorOccurred(ErrorData)),
             this, SIGNAL(parameterErrorOccurred(ErrorData)));
     
@@ -76,6 +82,10 @@ int OperatorModel::rowCount(const QModelIndex& index) const
     }
     else
     {
+        // the parameters of the operator change while it is initialized
+        if(m_pending)
+            return PARAMETER_OFFSET;
+        
         return numDisplayedParameters(0) + PARAMETER_OFFSET;
     }
 }
@@ -236,6 +246,8 @@ QVariant OperatorModel::data(const QModelIndex& index, int role) const
     case STRING_STATUS:
         return tr("Status");
     case STATUS:
+        if(m_pending)
+            return tr("Initializing");
         return statusToString(m_op->status());
     case STRING_NAME:
         return tr("Name");
@@ -469,6 +481,35 @@ void OperatorModel::endChangeInitialized()
     emit initializedChanged(isInitialized());
 }
 
+void OperatorModel::setPending(bool pending)
+{
+    if(pending == m_pending)
+        return;
+    
+    // the parameters are hidden while the operator is pending
+    beginResetModel();
+    m_pending = pending;
+    
+    // the operator has been initialized in the background
+    if(! m_pending)
+        m_server->refresh();
+    
+    endResetModel();
+    
+    emit pendingChanged(m_pending);
+    if(! m_pending)
+        emit initializedChanged(isInitialized());
+}
+
+void OperatorModel::setHung(bool hung)
+{
+    if(m_hung == hung)
+        return;
+    
+    m_hung = hung;
+    emit hungChanged(m_hung);
+}
+
 const QString& OperatorModel::type() const
 {
     return m_type;
@@ -484,6 +525,36 @@ QUndoStack* OperatorModel::undoStack() const
     return m_stream->undoStack(); 
 }
 
+void OperatorModel::setObserveData(unsigned int id, bool observe)
+{
+    m_observer.setObserveData(id, observe);
+}
+
+void OperatorModel::setCaptureChannel(unsigned int id, CaptureWriter* writer, quint32 channel)
+{
+    m_observer.setCaptureChannel(id, writer, channel);
+}
+
+bool OperatorModel::hasCaptureChannel(unsigned int id) const
+{
+    return m_observer.hasCaptureChannel(id);
+}
+
+void OperatorModel::clearCaptureChannels()
+{
+    m_observer.clearCaptureChannels();
+}
+
+void OperatorModel::setDeferredParameters(DeferredParameters* parameters)
+{
+    m_server->setDeferredParameters(parameters);
+}
+
+bool OperatorModel::loadDeferredParameters()
+{
+    return m_server->loadDeferredParameters();
+}
+
 void OperatorModel::customEvent(QEvent* event)
 {
     if(event->type() == ConnectorOccupyEvent::TYPE)
@@ -494,7 +565,7 @@ void OperatorModel::customEvent(QEvent* event)
     else if(event->type() == ConnectorDataEvent::TYPE)
     {
         ConnectorDataEvent* dataEvent = reinterpret_cast<ConnectorDataEvent*>(event);
-        emit connectorDataChanged(dataEvent->type(), dataEvent->id(), dataEvent->access());
+        m_stream->dataRouter()->route(this, dataEvent->id(), dataEvent->access(), dataEvent->sequence());
     }
 }
 
@@ -514,6 +585,14 @@ void OperatorModel::setActiveFalse()
     // trigger the reset model signal (reset() is deprecated in Qt5)
     beginResetModel();
     endResetModel();
+    
+    // the data of the next run of the stream is counted from the beginning
+    m_observer.resetSequences();
+    
+    // the connectors are empty after the stream has finished
+    m_observer.resetActivity();
+    m_lastAccessTimeout = 0;
+    
     emit activeChanged(false);
 }
 
@@ -525,26 +604,10 @@ void OperatorModel::setActiveTrue()
     emit activeChanged(true);
 }
 
-#ifdef STROMX_STUDIO_QT4
-void OperatorModel::connectNotify(const char* /*signal*/)
-#else
-void OperatorModel::connectNotify(const QMetaMethod & /*signal*/)
-#endif // STROMX_STUDIO_QT4
-{
-    // if there are receivers for data change signals the according events must be sent
-    if(receivers(SIGNAL(connectorDataChanged(OperatorModel::ConnectorType,uint,stromx::runtime::ReadAccess))))
-        m_observer.setObserveData(true);  
-}
-
-#ifdef STROMX_STUDIO_QT4
-void OperatorModel::disconnectNotify(const char* /*signal*/)
-#else
-void OperatorModel::disconnectNotify(const QMetaMethod & /*signal*/)
-#endif // STROMX_STUDIO_QT4
+void OperatorModel::handleAccessTimeout()
 {
-    // if there are no receivers for data change signals do not send the events
-    if(! receivers(SIGNAL(connectorDataChanged(OperatorModel::ConnectorType,uint,stromx::runtime::ReadAccess))))
-        m_observer.setObserveData(false); 
+    if(isActive())
+        m_lastAccessTimeout = ConnectorObserver::currentTime();
 }
 
 QString OperatorModel::statusToString(int status)
@@ -39,7 +39,9 @@ namespace stromx
 }
 
 class QUndoStack;
+class CaptureWriter;
 class ConnectionModel;
+class DeferredParameters;
 class ErrorData;
 class ParameterServer;
 class StreamModel;
@@ -55,6 +57,7 @@ class OperatorModel : public PropertyModel
     Q_PROPERTY(bool initialized READ isInitialized)
     
     friend class MoveOperatorCmd;
+    friend class OperatorWatchdog;
     friend class RenameOperatorCmd;
     friend class StreamModel;
     friend QDataStream & operator<< (QDataStream & stream, const OperatorModel * op);
@@ -96,6 +99,12 @@ public:
      */
     bool isInitialized() const;
     
+    /** 
+     * Returns true if the operator is being initialized in the background.
+     * The parameters of the operator are not displayed while it is pending.
+     */
+    bool isPending() const { return m_pending; }
+    
     /** 
      * Returns true if the operator is activated, i.e. the status of the
      * stromx operator is stromx::runtime::Operator::ACTIVE or 
@@ -103,6 +112,28 @@ public:
      */
     bool isActive() const;
     
+    /** 
+     * Returns true if the operator stopped making progress while the stream
+     * is active. This state is updated by the watchdog of the stream.
+     */
+    bool isHung() const { return m_hung; }
+    
+    /** Returns the activity at the connectors of the operator. */
+    ConnectorObserver::Activity connectorActivity() const { return m_observer.activity(); }
+    
+    /** Returns the most recent change at the connectors of the operator for each thread. */
+    QHash<const stromx::runtime::Thread*, ConnectorObserver::ThreadPosition> threadPositions() const
+    {
+        return m_observer.threadPositions();
+    }
+    
+    /** 
+     * Returns the time of the most recent timed out parameter access in 
+     * milliseconds since the epoch or 0 if no access timed out while the
+     * stream is active.
+     */
+    qint64 lastAccessTimeout() const { return m_lastAccessTimeout; }
+    
     /** 
      * Returns the connections which end or start at this operator.
      */
@@ -117,6 +148,35 @@ public:
     /** Returns the undo stack. */
     QUndoStack* undoStack() const;
     
+    /** 
+     * Enables or disables the observation of the data at the input \c id.
+     * Observed data is passed to the data router of the stream. This function
+     * is called by the data router.
+     */
+    void setObserveData(unsigned int id, bool observe);
+    
+    /** 
+     * Writes all data set to the input \c id to the channel \c channel of
+     * \c writer. This function is called by the stream model when a capture
+     * is started.
+     */
+    void setCaptureChannel(unsigned int id, CaptureWriter* writer, quint32 channel);
+    
+    /** Returns true if the data set to the input \c id is written to a capture writer. */
+    bool hasCaptureChannel(unsigned int id) const;
+    
+    /** Stops writing data to the capture writer. */
+    void clearCaptureChannels();
+    
+    /** Sets the parameters of the operator which are loaded on demand. */
+    void setDeferredParameters(DeferredParameters* parameters);
+    
+    /** 
+     * Loads all deferred parameters of the operator. Returns false if any of
+     * them could not be loaded.
+     */
+    bool loadDeferredParameters();
+    
     virtual int rowCount(const QModelIndex & index) const;
     virtual QVariant data(const QModelIndex & index, int role) const;
     virtual bool setData(const QModelIndex & index, const QVariant & value, int role);
@@ -137,15 +197,17 @@ signals:
     /** The stromx operator was activated or deactivated. */
     void activeChanged(bool status);
     
+    /** The background initialization of the operator started or finished. */
+    void pendingChanged(bool pending);
+    
+    /** The operator stopped or resumed making progress. */
+    void hungChanged(bool hung);
+    
     /**
      * The connector specified by \c type and \c id was set to a data pointer which
      * was either zero (<tt>occupied == false</tt>) or non-zero (<tt>occupied == true</tt>).
      */
     void connectorOccupiedChanged(OperatorModel::ConnectorType type, unsigned int id, bool occupied);
-    
-    /** The connector specified by \c type and \c id was set to \c data. */
-    void connectorDataChanged(OperatorModel::ConnectorType type, unsigned int id,
-                              stromx::runtime::ReadAccess access);
       
     /** 
      * An operation accessing a parameter of the operator or data at an operator
@@ -158,14 +220,6 @@ signals:
     
 protected:
     virtual void customEvent(QEvent* event);
-    
-#ifdef STROMX_STUDIO_QT4
-    virtual void connectNotify(const char * signal);
-    virtual void disconnectNotify(const char * signal);
-#else
-    virtual void connectNotify(const QMetaMethod & signal);
-    virtual void disconnectNotify(const QMetaMethod & signal);
-#endif // STROMX_STUDIO_QT4
 
 private slots:
     /** Resets the model and emits <tt>activeChanged(true)</tt>. */
@@ -177,6 +231,9 @@ private slots:
     /** Emits a data changed event for the cell of the parameter \c id. */
     void handleParameterChanged(unsigned int id);
     
+    /** Remembers the time of the timed out parameter access. */
+    void handleAccessTimeout();
+    
 private:
     enum Row
     {
@@ -211,6 +268,32 @@ private:
      */
     void endChangeInitialized();
     
+    /** 
+     * Marks the operator as being initialized in the background. This functions
+     * is called by the class StreamModel before the initialization starts and
+     * after it has finished. Both calls reset the operator model.
+     */
+    void setPending(bool pending);
+    
+    /** 
+     * Marks the operator as hung or not. This function is called by the class
+     * OperatorWatchdog.
+     */
+    void setHung(bool hung);
+    
+    /** 
+     * Restarts the measurement of the time since the last connector change.
+     * This function is called by the class OperatorWatchdog whenever the
+     * stream is started or resumed.
+     */
+    void restartActivity() { m_observer.restartActivity(); }
+    
+    /** 
+     * Starts or stops recording the connector activity. This function is
+     * called by the class OperatorWatchdog.
+     */
+    void setTrackActivity(bool track) { m_observer.setTrackActivity(track); }
+    
     /**
      * Returns the number of members \c group which are currently displayed.
      * If \c group is 0 the number of displayed top-level parameters is returned.
@@ -252,6 +335,9 @@ private:
     unsigned int m_offsetPosParam;
     ConnectorObserver m_observer;
     ParameterServer* m_server;
+    bool m_pending;
+    bool m_hung;
+    qint64 m_lastAccessTimeout;
 };
 
 QDataStream & operator<< (QDataStream & stream, const OperatorModel * op);
@@ -5,10 +5,12 @@
 #include <QJsonDocument>
 #endif
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDir>
 #include <QFileInfo>
 #include <QFutureWatcher>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <QtDebug>
 #include <stromx/runtime/Description.h>
@@ -21,10 +23,17 @@
 #include <stromx/runtime/XmlReader.h>
 #include <stromx/runtime/XmlWriter.h>
 #include <stromx/runtime/Factory.h>
+#include "CaptureWriter.h"
 #include "Common.h"
 #include "Config.h"
+#include "DataRouter.h"
 #include "Exception.h"
 #include "ExceptionObserver.h"
+#include "MemoryFileOutput.h"
+#include "OperatorWatchdog.h"
+#include "PatchedFileInput.h"
+#include "SectionReader.h"
+#include "SectionWriter.h"
 #include "cmd/AddConnectionCmd.h"
 #include "cmd/AddOperatorCmd.h"
 #include "cmd/AddThreadCmd.h"
@@ -38,6 +47,8 @@
 #include "model/OperatorLibraryModel.h"
 #include "model/OperatorModel.h"
 #include "model/ConnectionModel.h"
+#include "model/InputModel.h"
+#include "model/ObserverModel.h"
 #include "model/ObserverTreeModel.h"
 #include "model/ThreadListModel.h"
 #include "model/ThreadModel.h"
@@ -54,20 +65,61 @@ const int StreamModel::DEFAULT_DELAY = 100;
 const int StreamModel::DEFAULT_ACCESS_TIMEOUT = 5000;
 
 const int StreamModel::STREAM_FORMAT_VERSION_MAJOR = 0;
-const int StreamModel::STREAM_FORMAT_VERSION_MINOR = 2;
+const int StreamModel::STREAM_FORMAT_VERSION_MINOR = 3;
 const int StreamModel::STREAM_FORMAT_VERSION_REVISION = 0;
 
 const stromx::runtime::Version StreamModel::STREAM_FORMAT_V2(0, 2, 0);
+const stromx::runtime::Version StreamModel::STREAM_FORMAT_V3(0, 3, 0);
+
+namespace
+{
+    // initializes the operators of a stream on the threads of a QtConcurrent::map()
+    class InitializeOperator
+    {
+    public:
+        InitializeOperator(stromx::runtime::Stream* stream, ExceptionObserver* observer)
+          : m_stream(stream),
+            m_observer(observer)
+        {
+        }
+        
+        void operator()(OperatorModel* op) const
+        {
+            try
+            {
+                m_stream->initializeOperator(op->op());
+            }
+            catch(stromx::runtime::OperatorError& e)
+            {
+                if(m_observer)
+                    m_observer->observe(stromx::runtime::ExceptionObserver::INITIALIZATION, e, 0);
+            }
+        }
+        
+    private:
+        stromx::runtime::Stream* m_stream;
+        ExceptionObserver* m_observer;
+    };
+}
 
 StreamModel::StreamModel(QUndoStack* undoStack, OperatorLibraryModel* operatorLibrary, QObject* parent) 
   : QObject(parent),
     m_stream(0),
     m_threadListModel(0),
     m_observerModel(0),
+    m_dataRouter(0),
+    m_watchdog(0),
     m_operatorLibrary(operatorLibrary),
     m_undoStack(undoStack),
     m_joinStreamWatcher(0),
-    m_exceptionObserver(0)
+    m_startStreamWatcher(0),
+    m_starting(false),
+    m_startCancelled(false),
+    m_inputOrderIsValid(false),
+    m_initializeWatcher(0),
+    m_exceptionObserver(0),
+    m_captureWriter(0),
+    m_deferredParameters(0)
 {
     initializeSubModels();
     createTemplate();
@@ -78,20 +130,57 @@ StreamModel::StreamModel(stromx::runtime::FileInput& input, const QString& basen
     m_stream(0),
     m_threadListModel(0),
     m_observerModel(0),
+    m_dataRouter(0),
+    m_watchdog(0),
     m_operatorLibrary(operatorLibrary),
     m_undoStack(undoStack),
     m_joinStreamWatcher(0),
-    m_exceptionObserver(0)
+    m_startStreamWatcher(0),
+    m_starting(false),
+    m_startCancelled(false),
+    m_inputOrderIsValid(false),
+    m_initializeWatcher(0),
+    m_exceptionObserver(0),
+    m_captureWriter(0),
+    m_deferredParameters(0)
 {
     initializeSubModels();
-    
+    allocateObjects(readStream(input, basename, m_operatorLibrary->factory()));
+}
+
+StreamModel::StreamModel(stromx::runtime::Stream* stream, QUndoStack* undoStack, OperatorLibraryModel* operatorLibrary, QObject* parent)
+  : QObject(parent),
+    m_stream(0),
+    m_threadListModel(0),
+    m_observerModel(0),
+    m_dataRouter(0),
+    m_watchdog(0),
+    m_operatorLibrary(operatorLibrary),
+    m_undoStack(undoStack),
+    m_joinStreamWatcher(0),
+    m_startStreamWatcher(0),
+    m_starting(false),
+    m_startCancelled(false),
+    m_inputOrderIsValid(false),
+    m_initializeWatcher(0),
+    m_exceptionObserver(0),
+    m_captureWriter(0),
+    m_deferredParameters(0)
+{
+    initializeSubModels();
+    allocateObjects(stream);
+}
+
+stromx::runtime::Stream* StreamModel::readStream(stromx::runtime::FileInput& input, const QString& basename,
+                                                 stromx::runtime::Factory* factory)
+{
     stromx::runtime::Stream* stream = 0;
     std::string streamFilename = (basename + ".xml").toStdString();
     
     try
     {
         stromx::runtime::XmlReader reader;
-        stream = reader.readStream(input, streamFilename, m_operatorLibrary->factory());
+        stream = reader.readStream(input, streamFilename, factory);
     }
     catch(stromx::runtime::FileAccessFailed& e)
     {
@@ -166,32 +255,66 @@ Use <b>File -> Load Libraries...</b> to load additional libraries.")
         throw ReadStreamFailed(error);
     }
     
-    allocateObjects(stream);
+    return stream;
+}
+
+stromx::runtime::Stream* StreamModel::readStream(stromx::runtime::FileInput& input, const QString& basename,
+                                                 stromx::runtime::Factory* factory,
+                                                 QList<DeferredParameters::Parameter>& deferredParameters)
+{
+    QString streamFilename = basename + ".xml";
+    QByteArray streamXml;
+    
+    try
+    {
+        streamXml = readFileContent(input, streamFilename, false);
+    }
+    catch(stromx::runtime::FileAccessFailed&)
+    {
+        // let the reader report the error
+        return readStream(input, basename, factory);
+    }
+    
+    // the reader obtains the modified stream description from the patched input
+    // and all other files from the original input
+    QList<DeferredParameters::Parameter> parameters;
+    QByteArray patchedXml = DeferredParameters::extract(streamXml, parameters);
+    PatchedFileInput patchedInput(input, streamFilename.toStdString(), 
+                                  std::string(patchedXml.constData(), patchedXml.size()));
+    stromx::runtime::Stream* stream = readStream(patchedInput, basename, factory);
+    
+    deferredParameters.append(parameters);
+    return stream;
+}
+
+QByteArray StreamModel::readFileContent(stromx::runtime::FileInput& input, const QString& filename, bool binary)
+{
+    input.initialize("", filename.toStdString());
+    input.openFile(binary ? stromx::runtime::InputProvider::BINARY : stromx::runtime::InputProvider::TEXT);
+    
+    // read all data from the input stream
+    QByteArray data;
+    int dataSize = 0;
+    const int CHUNK_SIZE = 64 * 1024;
+    while(! input.file().eof())
+    {
+        data.resize(dataSize + CHUNK_SIZE);
+        char* dataPtr = data.data() + dataSize;
+        input.file().read(dataPtr, CHUNK_SIZE);
+        dataSize += (int)(input.file().gcount());
+    }
+    data.resize(dataSize);
+    
+    return data;
 }
 
 void StreamModel::readStudioData(stromx::runtime::FileInput & input, const QString & basename)
 {  
+    QByteArray modelData;
+    
     try
     {
-        input.initialize("", (basename + ".studio").toStdString());
-        input.openFile(stromx::runtime::InputProvider::BINARY);
-        
-        // read all data from the input stream
-        QByteArray modelData;
-        int dataSize = 0;
-        const int CHUNK_SIZE = 10;
-        while(! input.file().eof())
-        {
-            modelData.resize(modelData.size() + CHUNK_SIZE);
-            char* dataPtr = modelData.data() + dataSize;
-            input.file().read(dataPtr, CHUNK_SIZE);
-            dataSize += (int)(input.file().gcount());
-        }
-        modelData.resize(dataSize);
-        
-        // allocate the uninitialized operators and read all model data like 
-        // operator positions, thread color etc.
-        deserializeModel(modelData);
+        modelData = readFileContent(input, basename + ".studio", true);
     }
     catch(stromx::runtime::FileAccessFailed& e)
     {
@@ -202,6 +325,18 @@ void StreamModel::readStudioData(stromx::runtime::FileInput & input, const QStri
                                                                                       QString::fromStdString(e.container()));
         throw ReadStudioDataFailed(error);
     }
+    
+    readStudioData(modelData);
+}
+
+void StreamModel::readStudioData(const QByteArray& data)
+{
+    try
+    {
+        // allocate the uninitialized operators and read all model data like 
+        // operator positions, thread color etc.
+        deserializeModel(data);
+    }
     catch(stromx::runtime::InconsistentFileContent& e)
     {
         qWarning() << e.what();
@@ -245,28 +380,11 @@ void StreamModel::readStudioData(stromx::runtime::FileInput & input, const QStri
 
 void StreamModel::readObserverData(stromx::runtime::FileInput & input)
 { 
+    QByteArray viewData;
+    
     try
     {
-        input.initialize("", "views.json");
-        input.openFile(stromx::runtime::InputProvider::TEXT);
-        
-        // read all data from the input stream
-        QByteArray viewData;
-        int dataSize = 0;
-        const int CHUNK_SIZE = 10;
-        while(! input.file().eof())
-        {
-            viewData.resize(viewData.size() + CHUNK_SIZE);
-            char* dataPtr = viewData.data() + dataSize;
-            input.file().read(dataPtr, CHUNK_SIZE);
-            dataSize += (int)(input.file().gcount());
-        }
-        viewData.resize(dataSize);
-        
-#ifndef STROMX_STUDIO_QT4
-        QJsonDocument document = QJsonDocument::fromJson(viewData);
-        m_observerModel->read(document.array());
-#endif
+        viewData = readFileContent(input, "views.json", false);
     }
     catch(stromx::runtime::FileAccessFailed& e)
     {
@@ -277,22 +395,57 @@ void StreamModel::readObserverData(stromx::runtime::FileInput & input)
                                                                                       QString::fromStdString(e.container()));
         throw ReadObserverDataFailed(error);
     }
+    
+    readObserverData(viewData);
 } 
 
+void StreamModel::readObserverData(const QByteArray& data)
+{
+#ifndef STROMX_STUDIO_QT4
+    QJsonDocument document = QJsonDocument::fromJson(data);
+    m_observerModel->read(document.array());
+#else
+    Q_UNUSED(data);
+#endif
+}
+
 void StreamModel::initializeSubModels()
 {
     m_stream = new stromx::runtime::Stream;
     m_joinStreamWatcher = new QFutureWatcher<void>(this);
+    m_startStreamWatcher = new QFutureWatcher<bool>(this);
+    m_initializeWatcher = new QFutureWatcher<void>(this);
     m_threadListModel = new ThreadListModel(this);
     m_observerModel = new ObserverTreeModel(m_undoStack, this);
+    m_dataRouter = new DataRouter(this);
+    m_watchdog = new OperatorWatchdog(this);
+    m_threadListModel->setWatchdog(m_watchdog);
     
     connect(m_joinStreamWatcher, SIGNAL(finished()), this, SIGNAL(streamJoined()));
+    connect(m_startStreamWatcher, SIGNAL(finished()), this, SLOT(finishStart()));
+    connect(m_initializeWatcher, SIGNAL(finished()), this, SLOT(finishInitialization()));
+    
+    // watch the operators while the stream is active
+    connect(this, SIGNAL(streamStarted()), m_watchdog, SLOT(start()));
+    connect(this, SIGNAL(streamPaused()), m_watchdog, SLOT(stop()));
+    connect(this, SIGNAL(streamJoined()), m_watchdog, SLOT(stop()));
+    connect(m_watchdog, SIGNAL(checked()), m_threadListModel, SLOT(updateActivity()));
+    
+    // capture inputs which are observed while a capture is running
+    connect(m_observerModel, SIGNAL(inputAdded(InputModel*,ObserverModel*,int)), this, SLOT(captureInput(InputModel*)));
+    connect(m_observerModel, SIGNAL(observerAdded(ObserverModel*)), this, SLOT(captureObserver(ObserverModel*)));
 }
 
 StreamModel::~StreamModel()
 {   
     stop();
-    m_joinStreamWatcher->waitForFinished();
+    join();
+    
+    // the undo stack must not refer to this model anymore, i.e. the pending
+    // operators are not finished
+    m_initializeWatcher->waitForFinished();
+    
+    stopCapture();
     deleteAllData();
 }
 
@@ -313,13 +466,13 @@ QAbstractItemModel* StreamModel::threadListModel() const
 
 int StreamModel::operatorId(const OperatorModel* op) const
 {
-    for(int i = 0; i < m_operators.count(); ++i)
+    if(m_operatorIds.isEmpty())
     {
-        if(op == m_operators[i])
-            return i;
+        for(int i = 0; i < m_operators.count(); ++i)
+            m_operatorIds[m_operators[i]] = i;
     }
     
-    return -1;
+    return m_operatorIds.value(op, -1);
 }
 
 void StreamModel::addOperator(const OperatorData* opData, const QPointF& pos)
@@ -418,6 +571,58 @@ void StreamModel::initializeOperator(OperatorModel* op)
     m_undoStack->push(cmd);
 }
 
+void StreamModel::initializeOperators(const QList<OperatorModel*> & operators)
+{
+    // only one set of operators is initialized at a time
+    waitForInitialization();
+    
+    foreach(OperatorModel* op, operators)
+    {
+        if(! op->isInitialized())
+            m_pendingOperators.append(op);
+    }
+    
+    if(m_pendingOperators.isEmpty())
+        return;
+    
+    foreach(OperatorModel* op, m_pendingOperators)
+        op->setPending(true);
+    
+    QFuture<void> future = QtConcurrent::map(m_pendingOperators, 
+                                             InitializeOperator(m_stream, m_exceptionObserver));
+    m_initializeWatcher->setFuture(future);
+    
+    // the operators are pending, i.e. the first call of InitializeOperatorCmd::redo()
+    // has no effect
+    m_undoStack->beginMacro(tr("initialize operators"));
+    foreach(OperatorModel* op, m_pendingOperators)
+        m_undoStack->push(new InitializeOperatorCmd(this, op));
+    m_undoStack->endMacro();
+}
+
+void StreamModel::waitForInitialization()
+{
+    if(m_pendingOperators.isEmpty())
+        return;
+    
+    m_initializeWatcher->waitForFinished();
+    finishInitialization();
+}
+
+void StreamModel::finishInitialization()
+{
+    // the operators might have been finished by waitForInitialization() before
+    if(m_pendingOperators.isEmpty())
+        return;
+    
+    QList<OperatorModel*> operators = m_pendingOperators;
+    m_pendingOperators.clear();
+    invalidateInputOrder();
+    
+    foreach(OperatorModel* op, operators)
+        op->setPending(false);
+}
+
 void StreamModel::deinitializeOperator(OperatorModel* op)
 {
     m_undoStack->beginMacro(tr("deinitialize operator"));
@@ -456,6 +661,8 @@ void StreamModel::doAddOperator(OperatorModel* op)
     
     m_stream->showOperator(op->op());
     m_operators.append(op);
+    m_operatorIndex[op->op()] = op;
+    m_operatorIds.clear();
     connect(op, SIGNAL(parameterErrorOccurred(ErrorData)), this, SLOT(handleParameterError(ErrorData)));
     
     emit operatorAdded(op);
@@ -463,10 +670,13 @@ void StreamModel::doAddOperator(OperatorModel* op)
 
 void StreamModel::doRemoveOperator(OperatorModel* op)
 {
+    waitForInitialization();
     Q_ASSERT(! op->isInitialized());
     
     disconnect(op, SIGNAL(parameterErrorOccurred(ErrorData)));
     m_operators.removeAll(op);
+    m_operatorIndex.remove(op->op());
+    m_operatorIds.clear();
     m_stream->hideOperator(op->op());
     
     emit operatorRemoved(op);
@@ -474,6 +684,11 @@ void StreamModel::doRemoveOperator(OperatorModel* op)
 
 void StreamModel::doInitializeOperator(OperatorModel* op)
 {
+    // the operator is initialized in the background
+    if(op->isPending())
+        return;
+    
+    waitForInitialization();
     if(op->isInitialized())
         return;
     
@@ -481,6 +696,7 @@ void StreamModel::doInitializeOperator(OperatorModel* op)
     try
     {
         m_stream->initializeOperator(op->op());
+        invalidateInputOrder();
     }
     catch(stromx::runtime::OperatorError& e)
     {
@@ -492,13 +708,21 @@ void StreamModel::doInitializeOperator(OperatorModel* op)
 
 void StreamModel::doDeinitializeOperator(OperatorModel* op)
 {
+    waitForInitialization();
     if(! op->isInitialized())
         return;
     
+    // the values of deferred parameters are lost when the operator is deinitialized,
+    // parameters which can not be loaded are reported and forgotten
+    op->loadDeferredParameters();
+    if(m_deferredParameters)
+        m_deferredParameters->remove(op->op());
+    
     op->beginChangeInitialized();
     try
     {
         m_stream->deinitializeOperator(op->op());
+        invalidateInputOrder();
     }
     catch(stromx::runtime::OperatorError& e)
     {
@@ -510,23 +734,31 @@ void StreamModel::doDeinitializeOperator(OperatorModel* op)
 
 void StreamModel::doAddConnection(ConnectionModel* connection)
 {
+    waitForInitialization();
     connection->connectToOperators();
     m_connections.append(connection);
+    m_connectionIndex[qMakePair<const stromx::runtime::Operator*, unsigned int>(connection->targetOp()->op(), connection->inputId())] = connection;
     m_stream->connect(connection->sourceOp()->op(), connection->outputId(),
                       connection->targetOp()->op(), connection->inputId());
+    connect(connection, SIGNAL(threadChanged(ThreadModel*)), this, SLOT(invalidateInputOrder()));
+    invalidateInputOrder();
     
     emit connectionAdded(connection);
 }
 
 void StreamModel::doRemoveConnection(ConnectionModel* connection)
 {
+    waitForInitialization();
     // connections must be removed from all threads before removed
     Q_ASSERT(! connection->thread()); 
     
     m_stream->disconnect(connection->targetOp()->op(), connection->inputId());
+    disconnect(connection, SIGNAL(threadChanged(ThreadModel*)), this, SLOT(invalidateInputOrder()));
+    invalidateInputOrder();
     
     connection->disconnectFromOperators();
     m_connections.removeAll(connection);
+    m_connectionIndex.remove(qMakePair<const stromx::runtime::Operator*, unsigned int>(connection->targetOp()->op(), connection->inputId()));
     
     emit connectionRemoved(connection);
 }
@@ -535,6 +767,8 @@ void StreamModel::doAddThread(ThreadModel* threadModel)
 {
     m_stream->showThread(threadModel->thread());
     m_threadListModel->addThread(threadModel);
+    m_threadIndex[threadModel->thread()] = threadModel;
+    invalidateInputOrder();
     emit threadAdded(threadModel);
 }
 
@@ -542,6 +776,8 @@ void StreamModel::doRemoveThread(ThreadModel* threadModel)
 {
     m_stream->hideThread(threadModel->thread());
     m_threadListModel->removeThread(threadModel);
+    m_threadIndex.remove(threadModel->thread());
+    invalidateInputOrder();
     emit threadRemoved(threadModel);
 }
 
@@ -610,16 +846,17 @@ void StreamModel::write(stromx::runtime::FileOutput & output, const QString& bas
 {
     try
     {
-        stromx::runtime::XmlWriter writer;
-        writer.writeStream(output, basename.toStdString(), *m_stream);
+        writeStream(output, basename);
 
-#ifdef STROMX_STUDIO_QT4        
         QByteArray modelData;
         serializeModel(modelData);
         output.initialize(basename.toStdString());
         output.openFile(".studio", stromx::runtime::OutputProvider::BINARY);
         output.file().write(modelData.data(), modelData.size());
-#else        
+        
+#ifndef STROMX_STUDIO_QT4
+        // the observers are also written to views.json which is read by
+        // earlier versions and other stromx applications
         QJsonArray views;
         m_observerModel->write(views);
         QJsonDocument document(views);
@@ -648,6 +885,132 @@ void StreamModel::write(stromx::runtime::FileOutput & output, const QString& bas
     }
 }
 
+void StreamModel::writeStream(stromx::runtime::FileOutput& output, const QString& basename) const
+{
+    stromx::runtime::XmlWriter writer;
+    if(! hasDeferredParameters())
+    {
+        writer.writeStream(output, basename.toStdString(), *m_stream);
+        return;
+    }
+    
+    // copy the deferred parameters from the stream file instead of loading them
+    MemoryFileOutput streamOutput;
+    writer.writeStream(streamOutput, basename.toStdString(), *m_stream);
+    
+    QString error;
+    if(m_deferredParameters->writeThrough(streamOutput, basename, *m_stream, error))
+    {
+        streamOutput.writeTo(output);
+        return;
+    }
+    
+    qWarning() << "Failed to copy the deferred parameters:" << error;
+    if(! loadDeferredParameters())
+        throw WriteStreamFailed(tr("Failed to load all parameters of the stream."));
+    
+    writer.writeStream(output, basename.toStdString(), *m_stream);
+}
+
+void StreamModel::setDeferredParameters(const QString& filepath,
+                                        const QList<DeferredParameters::Parameter>& parameters)
+{
+    delete m_deferredParameters;
+    m_deferredParameters = new DeferredParameters(filepath, parameters, m_stream, m_operatorLibrary);
+    
+    foreach(OperatorModel* op, m_operators)
+        op->setDeferredParameters(m_deferredParameters);
+}
+
+void StreamModel::setDeferredParametersFile(const QString& filepath, const QString& basename)
+{
+    if(m_deferredParameters)
+        m_deferredParameters->setFilepath(filepath, basename);
+}
+
+bool StreamModel::hasDeferredParameters() const
+{
+    return m_deferredParameters && ! m_deferredParameters->isEmpty();
+}
+
+bool StreamModel::loadDeferredParameters() const
+{
+    if(! hasDeferredParameters())
+        return true;
+    
+    bool success = true;
+    foreach(OperatorModel* op, m_operators)
+    {
+        if(! op->loadDeferredParameters())
+            success = false;
+    }
+    
+    return success;
+}
+
+void StreamModel::startCapture(const QString& fileName)
+{
+    stopCapture();
+    
+    CaptureWriter* writer = new CaptureWriter(fileName);
+    try
+    {
+        writer->open();
+    }
+    catch(WriteCaptureFailed &)
+    {
+        delete writer;
+        throw;
+    }
+    m_captureWriter = writer;
+    
+    // add a channel for each observed input of an initialized operator
+    foreach(ObserverModel* observer, m_observerModel->observers())
+        captureObserver(observer);
+}
+
+void StreamModel::captureObserver(ObserverModel* observer)
+{
+    foreach(InputModel* input, observer->inputs())
+        captureInput(input);
+}
+
+void StreamModel::captureInput(InputModel* input)
+{
+    if(! m_captureWriter)
+        return;
+    
+    // inputs which are observed several times are captured once
+    int id = operatorId(input->op());
+    if(id < 0 || input->op()->hasCaptureChannel(input->id()))
+        return;
+    
+    QString name = QString("%1/%2").arg(input->op()->name(), input->docTitle());
+    quint32 channel = m_captureWriter->addChannel(id, input->id(), name);
+    input->op()->setCaptureChannel(input->id(), m_captureWriter, channel);
+    
+    if(! m_capturedOperators.contains(input->op()))
+        m_capturedOperators.append(input->op());
+}
+
+void StreamModel::stopCapture()
+{
+    if(! m_captureWriter)
+        return;
+    
+    // the operators might have been deleted since the capture was started
+    foreach(QPointer<OperatorModel> op, m_capturedOperators)
+    {
+        if(op)
+            op->clearCaptureChannels();
+    }
+    m_capturedOperators.clear();
+    
+    m_captureWriter->close();
+    delete m_captureWriter;
+    m_captureWriter = 0;
+}
+
 void StreamModel::deleteAllData()
 {
     // backup all models
@@ -659,6 +1022,10 @@ void StreamModel::deleteAllData()
     m_connections.clear();
     m_operators.clear();
     m_threadListModel->removeAllThreads();
+    m_operatorIndex.clear();
+    m_connectionIndex.clear();
+    m_threadIndex.clear();
+    m_operatorIds.clear();
     
     // delete the models
     foreach(ConnectionModel* connection, connections)
@@ -673,6 +1040,9 @@ void StreamModel::deleteAllData()
     // delete the stream
     delete m_stream;
     m_stream = 0;
+    
+    delete m_deferredParameters;
+    m_deferredParameters = 0;
 }
 
 void StreamModel::allocateObjects(stromx::runtime::Stream* stream)
@@ -686,6 +1056,7 @@ void StreamModel::allocateObjects(stromx::runtime::Stream* stream)
     {
         OperatorModel* op = new OperatorModel(*iter, this);
         m_operators.append(op);
+        m_operatorIndex[*iter] = op;
         
         connect(op, SIGNAL(operatorAccessTimedOut()), this, SIGNAL(accessTimedOut()));
         connect(op, SIGNAL(parameterErrorOccurred(ErrorData)), this, SLOT(handleParameterError(ErrorData)));
@@ -710,6 +1081,8 @@ void StreamModel::allocateObjects(stromx::runtime::Stream* stream)
                 ConnectionModel* connection = new ConnectionModel(source, output.id(), opModel, (*inputIter)->id(), this);
                 connection->connectToOperators();
                 m_connections.append(connection);
+                m_connectionIndex[qMakePair<const stromx::runtime::Operator*, unsigned int>(op, (*inputIter)->id())] = connection;
+                connect(connection, SIGNAL(threadChanged(ThreadModel*)), this, SLOT(invalidateInputOrder()));
             }
         }
     }
@@ -720,6 +1093,7 @@ void StreamModel::allocateObjects(stromx::runtime::Stream* stream)
     {
         ThreadModel* thread = new ThreadModel(*iter, this);
         m_threadListModel->addThread(thread);
+        m_threadIndex[*iter] = thread;
     }
     
     
@@ -741,72 +1115,58 @@ void StreamModel::allocateObjects(stromx::runtime::Stream* stream)
 
 OperatorModel* StreamModel::findOperatorModel(const stromx::runtime::Operator* op) const
 {
-    foreach(OperatorModel* opModel, m_operators)
-    {
-        if(opModel->op() == op)
-            return opModel;
-    }
-    
-    return 0;
+    return m_operatorIndex.value(op, 0);
 }
 
 ConnectionModel* StreamModel::findConnectionModel(const stromx::runtime::InputConnector& input) const
 {
-    foreach(ConnectionModel* connectionModel, m_connections)
-    {
-        if(connectionModel->targetOp()->op() == input.op()
-            && connectionModel->inputId() == input.id())
-        {
-            return connectionModel;
-        }
-    }
-    
-    return 0;
+    return m_connectionIndex.value(qMakePair<const stromx::runtime::Operator*, unsigned int>(input.op(), input.id()), 0);
 }
 
 ThreadModel* StreamModel::findThreadModel(const stromx::runtime::Thread* thread) const
 {
-    foreach(ThreadModel* threadModel, m_threadListModel->threads())
-    {
-        if(threadModel->thread() == thread)
-            return threadModel;
-    }
-    
-    return 0;
+    return m_threadIndex.value(thread, 0);
 }
 
 void StreamModel::serializeModel(QByteArray& data) const
 {
-    QDataStream dataStream(&data, QIODevice::WriteOnly | QIODevice::Truncate);
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly | QIODevice::Truncate);
     
+    QDataStream dataStream(&buffer);
     dataStream << quint32(MAGIC_NUMBER);
     dataStream << quint32(STREAM_FORMAT_VERSION_MAJOR);
     dataStream << quint32(STREAM_FORMAT_VERSION_MINOR);
     dataStream << quint32(STREAM_FORMAT_VERSION_REVISION);
     
-    dataStream.setVersion(QDataStream::Qt_4_7);
-    
-    // The uninitialized operators. They were instantiated by stromx-
-    // studio in earlier versions but are part of the stromx stream now.
-    dataStream << qint32(0);  // number of uninitialized operators
-    
-    // The model data (i.e. positions) of the operators. They were stored by
-    // stromx-studio in earlier versions but are part of the stromx stream now.
-    dataStream << qint32(0); // number of model data of initialized operators
-    dataStream << qint32(0);  // number of model data of uninitialized operators
+    // The uninitialized operators and the model data of the operators and 
+    // threads were stored by earlier versions. They are part of the stromx
+    // stream now. All remaining data is written to sections.
+    SectionWriter writer(&buffer);
     
-    // The model data (i.e. colors) of the threads.  They were stored by
-    // stromx-studio in earlier versions but are part of the stromx stream now.
-    dataStream << qint32(0);
+    writer.beginSection(OBSERVER_SECTION);
+    m_observerModel->write(writer.stream());
+    writer.endSection();
     
-    dataStream << m_observerModel;
-    
-    dataStream << m_settings;
+    writer.beginSection(SETTINGS_SECTION);
+    writer.stream() << m_settings;
+    writer.endSection();
+}
+
+QByteArray StreamModel::studioData() const
+{
+    QByteArray data;
+    serializeModel(data);
+    return data;
 }
 
 void StreamModel::deserializeModel(const QByteArray& data)
 {
-    QDataStream dataStream(data);
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    
+    QDataStream dataStream(&buffer);
     quint32 magicNumber = 0;
     qint32 count = 0;
     QList<OperatorModel*> xmlOperators = m_operators;
@@ -824,6 +1184,12 @@ void StreamModel::deserializeModel(const QByteArray& data)
     dataStream >> versionRevision;
     stromx::runtime::Version streamFormatVersion(versionMajor, versionMinor, versionRevision);
     
+    if (! (streamFormatVersion < STREAM_FORMAT_V3))
+    {
+        deserializeSections(&buffer);
+        return;
+    }
+    
     dataStream.setVersion(QDataStream::Qt_4_7);
 
     dataStream >> count;
@@ -844,6 +1210,8 @@ void StreamModel::deserializeModel(const QByteArray& data)
         stromx::runtime::Operator* op = m_stream->addOperator(kernel);
         opModel = new OperatorModel(op, this);
         m_operators.append(opModel);
+        m_operatorIndex[op] = opModel;
+        m_operatorIds.clear();
         stromxStudioOperators.append(opModel);
     }
     
@@ -900,31 +1268,74 @@ void StreamModel::deserializeModel(const QByteArray& data)
     doSetSettings(settings);
 }
 
+void StreamModel::deserializeSections(QIODevice* device)
+{
+    SectionReader reader(device);
+    while(reader.nextSection())
+    {
+        switch(reader.tag())
+        {
+        case OBSERVER_SECTION:
+            m_observerModel->read(reader.stream());
+            break;
+        case SETTINGS_SECTION:
+        {
+            QMap<QString, QVariant> settings;
+            reader.stream() >> settings;
+            doSetSettings(settings);
+            break;
+        }
+        default:
+            // sections added by newer versions are skipped
+            ;
+        }
+        
+        if(! reader.sectionIsValid())
+            throw ReadStudioDataFailed(tr("The stromx-studio data is corrupt."));
+    }
+}
+
 bool StreamModel::start()
 {
     switch(m_stream->status())
     {
     case stromx::runtime::Stream::INACTIVE:
+    {
+        // do nothing if the stream is already starting
+        if(m_starting)
+            return true;
+        
+        // all operators must have been initialized before the stream starts
+        waitForInitialization();
+        
+        // the operators must have their actual parameters when the stream runs,
+        // the failed parameters have been reported to the exception observer
+        if(! loadDeferredParameters())
+            return false;
+        
+        // sort inputs before starting unless the graph did not change since
+        // the last time
+        if(! m_inputOrderIsValid)
         {
-            // sort inputs before starting
             stromx::runtime::SortInputsAlgorithm sort;
             sort.apply(*m_stream);
-        }
-        try
-        {
-            m_stream->start();
-        }
-        catch(stromx::runtime::OperatorError& e)
-        {
-            // report any errors to the error observer
-            if(m_exceptionObserver)
-                m_exceptionObserver->observe(stromx::runtime::ExceptionObserver::ACTIVATION, e, 0);
-            
-            // return with error
-            return false;
+            m_inputOrderIsValid = true;
         }
         
-        break;
+        // the operators must record the connector activity from the first
+        // change on, otherwise the occupied connectors are not reliable
+        m_watchdog->trackActivity();
+        
+        m_starting = true;
+        m_startCancelled = false;
+        emit streamStarting();
+        
+        // activate the operators in the background
+        QFuture<bool> future = QtConcurrent::run(this, &StreamModel::startStream);
+        m_startStreamWatcher->setFuture(future);
+        
+        return true;
+    }
     case stromx::runtime::Stream::PAUSED:
         m_stream->resume();
         break;
@@ -937,6 +1348,60 @@ bool StreamModel::start()
     return true;
 }
 
+bool StreamModel::startStream()
+{
+    try
+    {
+        // TODO: The stream activates its operators one after another. Operators
+        // which do not depend on each other could be activated concurrently but
+        // stromx::runtime::Operator does not allow to activate operators outside
+        // of stromx::runtime::Stream::start(). Once stromx offers this the
+        // operators should be activated on a thread pool before the threads
+        // of the stream are started.
+        m_stream->start();
+    }
+    catch(stromx::runtime::OperatorError& e)
+    {
+        // report any errors to the error observer
+        if(m_exceptionObserver)
+            m_exceptionObserver->observe(stromx::runtime::ExceptionObserver::ACTIVATION, e, 0);
+        
+        return false;
+    }
+    
+    return true;
+}
+
+void StreamModel::finishStart()
+{
+    // the start might have been finished by join() before
+    if(! m_starting)
+        return;
+    
+    m_starting = false;
+    
+    if(! m_startStreamWatcher->result())
+    {
+        // the stream is inactive again
+        emit streamJoined();
+        return;
+    }
+    
+    // stop the stream right away if the start was cancelled
+    if(m_startCancelled)
+    {
+        stop();
+        return;
+    }
+    
+    emit streamStarted();
+}
+
+void StreamModel::invalidateInputOrder()
+{
+    m_inputOrderIsValid = false;
+}
+
 bool StreamModel::pause()
 {
     m_stream->pause();
@@ -947,6 +1412,13 @@ bool StreamModel::pause()
 
 bool StreamModel::stop()
 {
+    // the stream can not be stopped while the operators are activated
+    if(m_starting)
+    {
+        m_startCancelled = true;
+        return true;
+    }
+    
     // do nothing if the stream is inactive
     if(m_stream->status() == stromx::runtime::Stream::INACTIVE)
         return true;
@@ -964,12 +1436,21 @@ bool StreamModel::stop()
 
 bool StreamModel::join()
 {
+    if(m_starting)
+    {
+        m_startStreamWatcher->waitForFinished();
+        finishStart();
+    }
+    
     m_joinStreamWatcher->waitForFinished();
     return true;
 }
 
 bool StreamModel::isActive() const
 {
+    if(m_starting)
+        return true;
+    
     return m_stream->status() != stromx::runtime::Stream::INACTIVE;
 }
 
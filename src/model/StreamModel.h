@@ -20,17 +20,24 @@
 #ifndef STREAMMODEL_H
 #define STREAMMODEL_H
 
+#include <QByteArray>
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QObject>
+#include <QPair>
+#include <QPointer>
 #include <QPointF>
 
 #include <stromx/runtime/Version.h>
 
+#include "DeferredParameters.h"
+
 namespace stromx
 {
     namespace runtime
     { 
+        class Factory;
         class FileInput;
         class FileOutput;
         class InputConnector;
@@ -42,14 +49,20 @@ namespace stromx
 }
 
 class QAbstractItemModel;
+class QIODevice;
 template<class T> class QFutureWatcher;
 class QUndoStack;
+class CaptureWriter;
 class ConnectionModel;
+class DataRouter;
 class ErrorData;
 class ExceptionObserver;
+class InputModel;
 class JoinStreamTask;
+class ObserverModel;
 class ObserverTreeModel;
 class OperatorData;
+class OperatorWatchdog;
 class OperatorModel;
 class OperatorLibraryModel;
 class ThreadListModel;
@@ -93,7 +106,45 @@ public:
     explicit StreamModel(stromx::runtime::FileInput & input, const QString & basename, 
                          QUndoStack* undoStack, OperatorLibraryModel* operatorLibrary, QObject *parent = 0);
     
+    /**
+     * Constructs a stream model from a stromx stream which was read by readStream().
+     * The stream model takes ownership of \c stream.
+     */
+    explicit StreamModel(stromx::runtime::Stream* stream, QUndoStack* undoStack,
+                         OperatorLibraryModel* operatorLibrary, QObject *parent = 0);
+    
     virtual ~StreamModel();
+    
+    /**
+     * Reads the stromx stream from the file \c basename.xml of \c input. This function
+     * does not access any Qt objects and can be called from any thread. The caller
+     * takes ownership of the returned stream.
+     * 
+     * \throws ReadStreamFailed
+     */
+    static stromx::runtime::Stream* readStream(stromx::runtime::FileInput & input, const QString & basename,
+                                               stromx::runtime::Factory* factory);
+    
+    /**
+     * Reads the stromx stream like the function above but does not deserialize
+     * file-backed parameters of initialized operators. Instead they are appended
+     * to \c deferredParameters and can be passed to setDeferredParameters() of
+     * the stream model which is constructed from the returned stream.
+     * 
+     * \throws ReadStreamFailed
+     */
+    static stromx::runtime::Stream* readStream(stromx::runtime::FileInput & input, const QString & basename,
+                                               stromx::runtime::Factory* factory,
+                                               QList<DeferredParameters::Parameter> & deferredParameters);
+    
+    /**
+     * Returns the complete content of the file \c filename in \c input. Like 
+     * readStream() this function can be called from any thread.
+     * 
+     * \throws stromx::runtime::FileAccessFailed
+     */
+    static QByteArray readFileContent(stromx::runtime::FileInput & input, const QString & filename, bool binary);
+    
     /**
      * Reads the studios specific data (operator positions, uninitialized operators...)
      * of the stream from a file input.
@@ -102,6 +153,16 @@ public:
      */
     void readStudioData(stromx::runtime::FileInput & input, const QString & basename);
     
+    /**
+     * Reads the studios specific data from the content of a \c *.studio file.
+     * 
+     * \throws ReadStudioDataFailed
+     */
+    void readStudioData(const QByteArray & data);
+    
+    /** Returns the studio specific data in the format of a \c *.studio file. */
+    QByteArray studioData() const;
+    
     /**
      * Reads the observer data of the stream from the file 'views.json' in the file input.
      * 
@@ -109,6 +170,9 @@ public:
      */
     void readObserverData(stromx::runtime::FileInput & input);
     
+    /** Reads the observer data of the stream from the content of a 'views.json' file. */
+    void readObserverData(const QByteArray & data);
+    
     /** 
      * Returns the operators of the stream model. The position of each operator
      * in the list corresponds to its ID.
@@ -174,12 +238,73 @@ public:
     /** Returns the observer list of the current model. */
     ObserverTreeModel* observerModel() const;
     
-    /** Writes the content of the stream model. */
+    /** Returns the router which distributes observed data to the data managers. */
+    DataRouter* dataRouter() const { return m_dataRouter; }
+    
+    /** Returns the watchdog which detects hung operators while the stream is active. */
+    OperatorWatchdog* watchdog() const { return m_watchdog; }
+    
+    /** 
+     * Writes the content of the stream model. Deferred parameters are copied
+     * from the stream file without loading them. They are only loaded if they
+     * can not be copied.
+     * 
+     * \throws WriteStreamFailed
+     */
     void write(stromx::runtime::FileOutput & output, const QString & basename) const;
     
-    /** Returns true if the underlying stromx stream is active. */
+    /** 
+     * Sets the parameters which were not loaded when the stream was read from
+     * the file at \c filepath. They are loaded on demand, at the latest when
+     * the stream is started.
+     */
+    void setDeferredParameters(const QString & filepath, 
+                               const QList<DeferredParameters::Parameter> & parameters);
+    
+    /** 
+     * Reads the deferred parameters from the file at \c filepath from now on.
+     * Call this function after the stream has been written to \c filepath with
+     * the basename \c basename, e.g. if the original stream file might be removed.
+     */
+    void setDeferredParametersFile(const QString & filepath, const QString & basename);
+    
+    /** Returns true if any parameter of the stream is deferred. */
+    bool hasDeferredParameters() const;
+    
+    /** 
+     * Loads all deferred parameters of the stream. Returns false if any of them
+     * could not be loaded. These parameters are reported to the exception observer
+     * and remain deferred.
+     */
+    bool loadDeferredParameters() const;
+    
+    /** 
+     * Returns true if the underlying stromx stream is active or if it is
+     * currently being started.
+     */
     bool isActive() const;
     
+    /** Returns true if the stream is being started in the background. */
+    bool isStarting() const { return m_starting; }
+    
+    /** 
+     * Initializes \c operators concurrently in the background. The operators
+     * are pending until all of them have been initialized. A single command
+     * for the operators is pushed on the undo stack when the initialization
+     * starts. Initialization errors are reported to the exception observer for
+     * each operator.
+     */
+    void initializeOperators(const QList<OperatorModel*> & operators);
+    
+    /** Returns true if operators are being initialized in the background. */
+    bool isInitializing() const { return ! m_pendingOperators.isEmpty(); }
+    
+    /** 
+     * Waits until the operators which are initialized in the background are
+     * done.
+     */
+    void waitForInitialization();
+    
     /** Sets the current exception observer. */
     void setExceptionObserver(ExceptionObserver* observer);
     
@@ -195,18 +320,52 @@ public:
     
     /** Returns the maximal time to wait when accessing the stromx stream in milliseconds. */
     int accessTimeout() const;
+    
+    /** 
+     * Starts writing the data at all observed inputs to the capture file
+     * \c fileName. A running capture is stopped before. Inputs which are
+     * added to an observer while the capture is running are captured from
+     * then on. Inputs which are removed from all observers are captured
+     * until the capture is stopped. Inputs of operators which are not
+     * initialized are not captured.
+     * 
+     * \throws WriteCaptureFailed
+     */
+    void startCapture(const QString & fileName);
+    
+    /** Returns true if a capture is running. */
+    bool isCapturing() const { return m_captureWriter != 0; }
+    
+    /** Returns the writer of the running capture or 0 if no capture is running. */
+    const CaptureWriter* captureWriter() const { return m_captureWriter; }
 
 public slots:
-    /** Starts the stromx stream. Returns true if successful. */
+    /** 
+     * Starts the stromx stream. An inactive stream is started in the background
+     * because activating the operators can take a long time. The signal
+     * streamStarting() is emitted immediately and streamStarted() as soon
+     * as all operators have been activated. If the activation fails
+     * streamJoined() is emitted instead. If the start is cancelled by stop()
+     * the stream is stopped and joined without emitting streamStarted(). A 
+     * paused stream is resumed immediately. Returns false if the stream is
+     * not started because its deferred parameters can not be loaded.
+     */
     bool start();
     
     /** Pauses the stromx stream. Returns true if successful. */
     bool pause();
     
-    /** Stops the stromx stream. Returns true if successful. */
+    /** 
+     * Stops the stromx stream. If the stream is still starting the start is
+     * cancelled, i.e. the stream is stopped as soon as the activation of the
+     * operators has finished. Returns true if successful.
+     */
     bool stop();
     
-    /** Waits for the stream to join. Returns true if successful. */
+    /** 
+     * Waits for the stream to join. A running start of the stream is
+     * finished before. Returns true if successful.
+     */
     bool join();
     
     /** 
@@ -222,10 +381,37 @@ public slots:
     /** Sets the maximal time to wait when accessing the stromx stream in milliseconds. */
     void setAccessTimeout(int timeout);
     
+    /** Writes all pending data to the capture file and closes it. */
+    void stopCapture();
+    
 private slots:
     /** Sends the parameter error to the error observer. */
     void handleParameterError(const ErrorData & data);
     
+    /** 
+     * Emits the signal for the result of the background start of the
+     * stream or stops the stream if the start was cancelled.
+     */
+    void finishStart();
+    
+    /** 
+     * Marks the input order of the threads as unsorted, i.e. the inputs
+     * are sorted again before the stream is started the next time.
+     */
+    void invalidateInputOrder();
+    
+    /** 
+     * Ends the pending state of the operators which were initialized in the
+     * background.
+     */
+    void finishInitialization();
+    
+    /** Adds a channel for \c input to the running capture. Does nothing if no capture is running. */
+    void captureInput(InputModel* input);
+    
+    /** Adds a channel for each input of \c observer to the running capture. */
+    void captureObserver(ObserverModel* observer);
+    
 signals:
     /** An operator was added. */
     void operatorAdded(OperatorModel* op);
@@ -245,6 +431,9 @@ signals:
     /** A thread was removed. */
     void threadRemoved(ThreadModel* thread);
     
+    /** The stromx stream is being started in the background. */
+    void streamStarting();
+    
     /** The stromx stream was started. */
     void streamStarted();
     
@@ -289,6 +478,19 @@ private:
      */
     static const stromx::runtime::Version STREAM_FORMAT_V2;
     
+    /** 
+     * Third stromx-studio stream file format. In this version the data following
+     * the header is stored in sections which are written by SectionWriter.
+     */
+    static const stromx::runtime::Version STREAM_FORMAT_V3;
+    
+    /** The sections of stromx-studio data files of format v3 and higher. */
+    enum StudioDataSection
+    {
+        OBSERVER_SECTION = 1,
+        SETTINGS_SECTION = 2
+    };
+    
     /** Allocates all submodel and sets up the necessary connections. */
     void initializeSubModels();
     
@@ -336,6 +538,15 @@ private:
      */
     void doSetSettings(const QMap<QString, QVariant> & settings);
     
+    /** 
+     * Writes the stromx stream to \c output. The deferred parameters are copied
+     * from the stream file if possible. Otherwise they are loaded before the
+     * stream is written.
+     * 
+     * \throws WriteStreamFailed
+     */
+    void writeStream(stromx::runtime::FileOutput & output, const QString & basename) const;
+    
     /** 
      * Serializes all data of the stream which is not stored in the stromx XML,
      * as e.g. operator positions.
@@ -348,6 +559,9 @@ private:
      */
     void deserializeModel(const QByteArray& data);
     
+    /** Reads the sections of stromx-studio data files of format v3 and higher from \c device. */
+    void deserializeSections(QIODevice* device);
+    
     /**
      * Iterates over \c stream and allocates models for all operators, threads
      * and connections in the stream.
@@ -363,6 +577,13 @@ private:
     /** Finds the connection model which connects to \c input. Returns 0 if no such model exists. */
     ConnectionModel* findConnectionModel(const stromx::runtime::InputConnector & input) const;
     
+    /** 
+     * Activates the operators and starts the threads of the stromx stream.
+     * This function is executed in the background. Returns false and reports
+     * the error to the exception observer if an operator can not be activated.
+     */
+    bool startStream();
+    
     /** Finds the thread model which wraps \c thread. Returns 0 if no such model exists. */
     ThreadModel* findThreadModel(const stromx::runtime::Thread* thread) const;
     
@@ -371,6 +592,16 @@ private:
     
     // The list of all operator models.
     QList<OperatorModel*> m_operators;
+    
+    // The indexes of the models of the stromx operators, connections and threads.
+    // Connections are identified by their target operator and input.
+    QHash<const stromx::runtime::Operator*, OperatorModel*> m_operatorIndex;
+    QHash<QPair<const stromx::runtime::Operator*, unsigned int>, ConnectionModel*> m_connectionIndex;
+    QHash<const stromx::runtime::Thread*, ThreadModel*> m_threadIndex;
+    
+    // The positions of the operator models in the list of operators. This cache is
+    // cleared whenever the list changes and rebuilt by operatorId().
+    mutable QHash<const OperatorModel*, int> m_operatorIds;
                 
     // The version of the stream file format. 
     static const int STREAM_FORMAT_VERSION_MAJOR;
@@ -379,12 +610,23 @@ private:
     
     ThreadListModel* m_threadListModel;
     ObserverTreeModel* m_observerModel;
+    DataRouter* m_dataRouter;
+    OperatorWatchdog* m_watchdog;
     OperatorLibraryModel* m_operatorLibrary;
     QUndoStack* m_undoStack;
     QList<ConnectionModel*> m_connections;
     QFutureWatcher<void>* m_joinStreamWatcher;
+    QFutureWatcher<bool>* m_startStreamWatcher;
+    bool m_starting;
+    bool m_startCancelled;
+    bool m_inputOrderIsValid;
+    QFutureWatcher<void>* m_initializeWatcher;
+    QList<OperatorModel*> m_pendingOperators;
     ExceptionObserver* m_exceptionObserver;
     QMap<QString, QVariant> m_settings;
+    CaptureWriter* m_captureWriter;
+    QList<QPointer<OperatorModel> > m_capturedOperators;
+    DeferredParameters* m_deferredParameters;
 };
 
 #endif // STREAMMODEL_H
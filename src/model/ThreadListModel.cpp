@@ -1,10 +1,14 @@
 #include "model/ThreadListModel.h"
 
 #include "Common.h"
+#include "ConnectorObserver.h"
+#include "OperatorWatchdog.h"
+#include "model/OperatorModel.h"
 #include "model/ThreadModel.h"
 
 ThreadListModel::ThreadListModel(QObject* parent)
-  : QAbstractTableModel(parent)
+  : QAbstractTableModel(parent),
+    m_watchdog(0)
 {
 
 }
@@ -54,6 +58,8 @@ QVariant ThreadListModel::data(const QModelIndex& index, int role) const
             else
                 return name;
         }
+        case 2:
+            return activity(m_threads[index.row()]);
         default:
             ;
         }
@@ -110,7 +116,11 @@ Qt::ItemFlags ThreadListModel::flags(const QModelIndex& index) const
 {
     Qt::ItemFlags flags = QAbstractItemModel::flags(index);
     
-    // all columns are editable
+    // the activity is read-only
+    if(index.column() == ACTIVITY)
+        return flags;
+    
+    // all other columns are editable
     return flags |= Qt::ItemIsEditable;
 }
 
@@ -128,6 +138,8 @@ QVariant ThreadListModel::headerData(int section, Qt::Orientation orientation, i
         return tr("Name");
     case 1:
         return tr("Color");
+    case 2:
+        return tr("Activity");
     default:
         ;
     }
@@ -185,5 +197,36 @@ void ThreadListModel::updateThread(ThreadModel* thread)
         emit dataChanged(createIndex(pos, 0), createIndex(pos, NUM_COLUMNS - 1));
 }
 
+void ThreadListModel::updateActivity()
+{
+    if(! m_threads.isEmpty())
+        emit dataChanged(createIndex(0, ACTIVITY), createIndex(m_threads.size() - 1, ACTIVITY));
+}
+
+QString ThreadListModel::activity(const ThreadModel* thread) const
+{
+    if(! m_watchdog || ! thread->thread())
+        return QString();
+    
+    ConnectorObserver::ThreadPosition position = m_watchdog->threadPosition(thread->thread());
+    OperatorModel* op = qobject_cast<OperatorModel*>(position.receiver);
+    if(! op)
+        return QString();
+    
+    // the thread is blocked in the step after its most recent connector change
+    QString change;
+    if(position.type == stromx::runtime::Connector::INPUT)
+    {
+        change = position.occupied ? tr("Set input %1 of \"%2\"") : tr("Cleared input %1 of \"%2\"");
+    }
+    else
+    {
+        change = position.occupied ? tr("Set output %1 of \"%2\"") : tr("Cleared output %1 of \"%2\"");
+    }
+    
+    qint64 seconds = (ConnectorObserver::currentTime() - position.time) / 1000;
+    return tr("%1 %2 s ago").arg(change.arg(position.id).arg(op->name())).arg(seconds);
+}
+
 
 
@@ -23,6 +23,7 @@
 #include <QAbstractTableModel>
 #include <QList>
 
+class OperatorWatchdog;
 class ThreadModel;
 
 /**
@@ -42,7 +43,9 @@ public:
     enum Column
     {
         NAME,
-        COLOR
+        COLOR,
+        /** The most recent connector change of the stromx thread. */
+        ACTIVITY
     };
     
     /** Constructs a thread list model. */
@@ -68,19 +71,33 @@ public:
     friend QDataStream & operator<< (QDataStream & stream, const ThreadListModel * threadList);
     friend QDataStream & operator>> (QDataStream & stream, ThreadListModel * threadList);
      
+public slots:
+    /** Updates the displayed activity of all threads. */
+    void updateActivity();
+    
 private slots:
     /** Updates the displayed data of \c thread. */
     void updateThread(ThreadModel* thread);
     
 private:
     /** The number of columns of the model. */
-    const static int NUM_COLUMNS = 2;
+    const static int NUM_COLUMNS = 3;
     
     void addThread(ThreadModel* thread);
     void removeThread(ThreadModel* thread);
     void removeAllThreads();
     
+    /** Sets the watchdog which provides the activity of the threads. */
+    void setWatchdog(const OperatorWatchdog* watchdog) { m_watchdog = watchdog; }
+    
+    /** 
+     * Returns a description of the most recent connector change of \c thread
+     * which was found by the watchdog.
+     */
+    QString activity(const ThreadModel* thread) const;
+    
     QList<ThreadModel*> m_threads;
+    const OperatorWatchdog* m_watchdog;
 };
     
 #endif // THREADLISTMODEL_H
@@ -28,7 +28,7 @@ void GetParameterTask::run()
     catch(stromx::runtime::OperatorError& e)
     {
         m_errorCode = EXCEPTION;
-        m_errorData = ErrorData(e, ErrorData::PARAMETER_ACCESS);
+        m_errorData = ErrorData(e, ErrorData::PARAMETER_ACCESS, m_op);
     }
     catch(stromx::runtime::Exception&)
     {
@@ -0,0 +1,154 @@
+#include "task/ReadStreamTask.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QtDebug>
+#include <memory>
+#include <stromx/runtime/DirectoryFileInput.h>
+#include <stromx/runtime/Exception.h>
+#include <stromx/runtime/Stream.h>
+#include <stromx/runtime/ZipFileInput.h>
+#include "Exception.h"
+#include "model/StreamModel.h"
+
+ReadStreamTask::ReadStreamTask(const QString& filepath, stromx::runtime::Factory* factory, QObject* parent)
+  : Task(parent),
+    m_filepath(filepath),
+    m_factory(factory),
+    m_stream(0),
+    m_canceled(false)
+{
+}
+
+ReadStreamTask::~ReadStreamTask()
+{
+    // the stream is accessed by run()
+    waitForFinished();
+    delete m_stream;
+}
+
+stromx::runtime::Stream* ReadStreamTask::takeStream()
+{
+    stromx::runtime::Stream* stream = m_stream;
+    m_stream = 0;
+    return stream;
+}
+
+QString ReadStreamTask::stageLabel(int stage)
+{
+    switch(stage)
+    {
+    case OPEN_FILE:
+        return tr("Opening file...");
+    case READ_STREAM:
+        return tr("Reading stream and initializing operators...");
+    case READ_STUDIO_DATA:
+        return tr("Reading operator layout...");
+    case READ_OBSERVER_DATA:
+        return tr("Reading observers...");
+    case READ_WINDOW_STATES:
+        return tr("Reading window states...");
+    default:
+        return QString();
+    }
+}
+
+void ReadStreamTask::cancel()
+{
+    m_canceled = true;
+}
+
+bool ReadStreamTask::startStage(Stage stage)
+{
+    if(m_canceled)
+        return false;
+    
+    emit stageStarted(stage);
+    return true;
+}
+
+void ReadStreamTask::run()
+{
+    QString extension = QFileInfo(m_filepath).suffix();
+    
+    // the stream in zip files is always stored as 'stream.xml'
+    QString basename = extension == "xml" ? QFileInfo(m_filepath).baseName() : QString("stream");
+    
+    if(! startStage(OPEN_FILE))
+        return;
+    
+    std::auto_ptr<stromx::runtime::FileInput> input;
+    QString location;
+    try
+    {
+        if(extension == "xml")
+        {
+            location = QFileInfo(m_filepath).absoluteDir().absolutePath();
+            input = std::auto_ptr<stromx::runtime::FileInput>(new stromx::runtime::DirectoryFileInput(location.toStdString()));
+        }
+        else
+        {
+            location = m_filepath;
+            input = std::auto_ptr<stromx::runtime::FileInput>(new stromx::runtime::ZipFileInput(m_filepath.toStdString()));
+        }
+    }
+    catch(stromx::runtime::FileAccessFailed&)
+    {
+        m_errorMessage = tr("The location %1 could not be openend for reading").arg(location);
+        return;
+    }
+    
+    if(! startStage(READ_STREAM))
+        return;
+    
+    try
+    {
+        m_stream = StreamModel::readStream(*input, basename, m_factory, m_deferredParameters);
+    }
+    catch(ReadStreamFailed& e)
+    {
+        m_errorMessage = e.what();
+        return;
+    }
+    
+    // the files below are optional, i.e. errors are ignored
+    if(! startStage(READ_STUDIO_DATA))
+        return;
+    
+    try
+    {
+        m_studioData = StreamModel::readFileContent(*input, basename + ".studio", true);
+    }
+    catch(stromx::runtime::FileAccessFailed& e)
+    {
+        qWarning() << e.what();
+    }
+    
+    if(! startStage(READ_OBSERVER_DATA))
+        return;
+    
+    // observers are only stored in zip files
+    if(extension != "xml")
+    {
+        try
+        {
+            m_observerData = StreamModel::readFileContent(*input, "views.json", false);
+        }
+        catch(stromx::runtime::FileAccessFailed& e)
+        {
+            qWarning() << e.what();
+        }
+    }
+    
+    if(! startStage(READ_WINDOW_STATES))
+        return;
+    
+    try
+    {
+        m_windowStates = StreamModel::readFileContent(*input, basename + ".studio.geometry", true);
+    }
+    catch(stromx::runtime::FileAccessFailed& e)
+    {
+        qWarning() << e.what();
+    }
+}
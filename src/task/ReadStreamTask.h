@@ -0,0 +1,143 @@
+/* 
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef READSTREAMTASK_H
+#define READSTREAMTASK_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include "DeferredParameters.h"
+#include "Task.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Factory;
+        class Stream;
+    }
+}
+
+/** 
+ * \brief Task which asynchronously reads a stream file.
+ *
+ * This class reads all parts of a stream file which do not require access to
+ * Qt objects on a worker thread: The stromx stream itself, which includes the
+ * initialization of the operators and the deserialization of the parameters,
+ * and the raw content of the stromx-studio specific files. The start of each 
+ * stage is signalled by stageStarted(). The task can be canceled between two
+ * stages.
+ * 
+ * After the finish signal was emitted the stream can be taken from the task and
+ * passed to a new StreamModel together with the studio, observer and window data.
+ * Streams which are not taken are deleted by the task. File-backed parameters of
+ * initialized operators are not deserialized but returned by deferredParameters().
+ */
+class ReadStreamTask : public Task
+{
+    Q_OBJECT
+    
+public:
+    enum Stage
+    {
+        OPEN_FILE,
+        READ_STREAM,
+        READ_STUDIO_DATA,
+        READ_OBSERVER_DATA,
+        READ_WINDOW_STATES,
+        NUM_STAGES
+    };
+    
+    /** 
+     * Constructs a task which reads the file at \c filepath. The operators and 
+     * data of the stream are allocated by \c factory. Call run() to actually start the task.
+     */
+    explicit ReadStreamTask(const QString & filepath, stromx::runtime::Factory* factory,
+                            QObject* parent = 0);
+    
+    /** Deletes the stream if it has not been taken. */
+    virtual ~ReadStreamTask();
+    
+    /** Returns the path of the file which is read. */
+    const QString & filepath() const { return m_filepath; }
+    
+    /** Returns true if the task was canceled before it finished. */
+    bool isCanceled() const { return m_canceled; }
+    
+    /** 
+     * Returns a message explaining why the stream could not be read. Returns
+     * an empty string if the stream was read successfully or the task was canceled.
+     */
+    const QString & errorMessage() const { return m_errorMessage; }
+    
+    /** 
+     * Returns the stream which was read and passes its ownership to the caller.
+     * Returns 0 if the stream could not be read.
+     */
+    stromx::runtime::Stream* takeStream();
+    
+    /** Returns the parameters of the stream which have not been loaded yet. */
+    const QList<DeferredParameters::Parameter> & deferredParameters() const { return m_deferredParameters; }
+    
+    /** Returns the content of the \c *.studio file or an empty array if it does not exist. */
+    const QByteArray & studioData() const { return m_studioData; }
+    
+    /** Returns the content of the file \c views.json or an empty array if it does not exist. */
+    const QByteArray & observerData() const { return m_observerData; }
+    
+    /** Returns the content of the \c *.studio.geometry file or an empty array if it does not exist. */
+    const QByteArray & windowStates() const { return m_windowStates; }
+    
+    /** Returns a user visible description of \c stage. */
+    static QString stageLabel(int stage);
+    
+public slots:
+    /** 
+     * Cancels the task. The current stage is completed but no further stages
+     * are started.
+     */
+    void cancel();
+    
+signals:
+    /** 
+     * Emitted by the worker thread when \c stage is started. Connections
+     * to this signal are queued to the thread of the task object.
+     */
+    void stageStarted(int stage);
+    
+private:
+    /** Reads the file and stores the results in the class members. */
+    void run();
+    
+    /** Emits stageStarted() and returns false if the task has been canceled. */
+    bool startStage(Stage stage);
+    
+    QString m_filepath;
+    stromx::runtime::Factory* m_factory;
+    stromx::runtime::Stream* m_stream;
+    QList<DeferredParameters::Parameter> m_deferredParameters;
+    QByteArray m_studioData;
+    QByteArray m_observerData;
+    QByteArray m_windowStates;
+    QString m_errorMessage;
+    volatile bool m_canceled;
+};
+
+#endif // READSTREAMTASK_H
@@ -29,7 +29,7 @@ void SetParameterTask::run()
     catch(stromx::runtime::OperatorError& e)
     {
         m_errorCode = EXCEPTION;
-        m_errorData = ErrorData(e, ErrorData::PARAMETER_ACCESS);
+        m_errorData = ErrorData(e, ErrorData::PARAMETER_ACCESS, m_op);
     }
     catch(stromx::runtime::Exception&)
     {
@@ -24,6 +24,11 @@ void Task::start()
 }
 
 Task::~Task()
+{
+    waitForFinished();
+}
+
+void Task::waitForFinished()
 {
     m_watcher->waitForFinished();
 }
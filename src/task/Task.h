@@ -60,6 +60,12 @@ signals:
 protected:
     virtual void run() = 0;
     
+    /** 
+     * Waits for the task to finish. Derived classes which delete data accessed
+     * by run() in their destructor must call this function first.
+     */
+    void waitForFinished();
+    
 private slots:
     /**
      * Obtains the result of the future and emits the finished signal. After
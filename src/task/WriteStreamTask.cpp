@@ -0,0 +1,87 @@
+#include "task/WriteStreamTask.h"
+
+#include <cstdio>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtDebug>
+#include <stromx/runtime/DirectoryFileOutput.h>
+#include <stromx/runtime/Exception.h>
+#include <stromx/runtime/ZipFileOutput.h>
+#include "MemoryFileOutput.h"
+
+const char* WriteStreamTask::TEMP_FILE_SUFFIX = ".tmp";
+
+WriteStreamTask::WriteStreamTask(const QString& filepath, MemoryFileOutput* snapshot,
+                                 int undoIndex, QObject* parent)
+  : Task(parent),
+    m_filepath(filepath),
+    m_snapshot(snapshot),
+    m_undoIndex(undoIndex)
+{
+}
+
+WriteStreamTask::~WriteStreamTask()
+{
+    // the snapshot is accessed by run()
+    waitForFinished();
+    delete m_snapshot;
+}
+
+void WriteStreamTask::run()
+{
+    QString extension = QFileInfo(m_filepath).suffix();
+    QString location;
+    QString tempFile = m_filepath + TEMP_FILE_SUFFIX;
+    
+    try
+    {
+        if(extension == "xml")
+        {
+            location = QFileInfo(m_filepath).absoluteDir().absolutePath();
+            stromx::runtime::DirectoryFileOutput output(location.toStdString());
+            m_snapshot->writeTo(output);
+        }
+        else
+        {
+            location = m_filepath;
+            
+            {
+                stromx::runtime::ZipFileOutput output(tempFile.toStdString());
+                m_snapshot->writeTo(output);
+                
+                // manually close the file to catch exceptions on writing
+                output.close();
+            }
+            
+            if(! replaceFile(tempFile, m_filepath))
+            {
+                QFile::remove(tempFile);
+                m_errorMessage = tr("The file %1 could not be replaced").arg(m_filepath);
+            }
+        }
+    }
+    catch(stromx::runtime::FileAccessFailed& e)
+    {
+        qWarning() << e.what();
+        QFile::remove(tempFile);
+        m_errorMessage = tr("The location %1 could not be openend for writing").arg(location);
+    }
+    catch(stromx::runtime::Exception& e)
+    {
+        // a file which is copied from the original stream file could not be read
+        qWarning() << e.what();
+        QFile::remove(tempFile);
+        m_errorMessage = tr("The files of the stream could not be copied to %1").arg(location);
+    }
+}
+
+bool WriteStreamTask::replaceFile(const QString& source, const QString& target)
+{
+#ifdef WIN32
+    // rename() does not replace existing files on Windows
+    QFile::remove(target);
+#endif // WIN32
+    
+    return std::rename(QFile::encodeName(source).constData(), QFile::encodeName(target).constData()) == 0;
+}
@@ -0,0 +1,84 @@
+/* 
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef WRITESTREAMTASK_H
+#define WRITESTREAMTASK_H
+
+#include <QString>
+#include "Task.h"
+
+class MemoryFileOutput;
+
+/** 
+ * \brief Task which asynchronously writes a snapshot of a stream to a file.
+ *
+ * The snapshot is taken on the GUI thread by writing the stream model to a 
+ * memory file output. This task compresses the snapshot and writes it to the
+ * disk. The files of deferred parameters are copied from the original stream
+ * file by this task. Zip files are first written to a temporary file which then replaces
+ * the target file, i.e. the target file is either completely written or left
+ * untouched. This is not possible for XML files because they consist of
+ * several files in a directory.
+ */
+class WriteStreamTask : public Task
+{
+    Q_OBJECT
+    
+public:
+    /** 
+     * Constructs a task which writes \c snapshot to the file at \c filepath. The task
+     * takes ownership of the snapshot. The \c undoIndex is the index of the 
+     * undo stack at the time the snapshot was taken. Call run() to actually start the task.
+     */
+    explicit WriteStreamTask(const QString & filepath, MemoryFileOutput* snapshot,
+                             int undoIndex, QObject* parent = 0);
+    
+    /** Deletes the snapshot. */
+    virtual ~WriteStreamTask();
+    
+    /** Returns the path of the file which is written. */
+    const QString & filepath() const { return m_filepath; }
+    
+    /** Returns the index of the undo stack at the time the snapshot was taken. */
+    int undoIndex() const { return m_undoIndex; }
+    
+    /** Returns true if the file could not be written. */
+    bool failed() const { return ! m_errorMessage.isEmpty(); }
+    
+    /** Returns a message explaining why the file could not be written. */
+    const QString & errorMessage() const { return m_errorMessage; }
+    
+private:
+    /** The suffix of the temporary file which is written before it replaces the target file. */
+    static const char* TEMP_FILE_SUFFIX;
+    
+    /** Writes the snapshot and stores the result in the class members. */
+    void run();
+    
+    /** Atomically replaces the file \c target by \c source. Returns false on failure. */
+    static bool replaceFile(const QString & source, const QString & target);
+    
+    QString m_filepath;
+    MemoryFileOutput* m_snapshot;
+    int m_undoIndex;
+    QString m_errorMessage;
+};
+
+#endif // WRITESTREAMTASK_H
@@ -0,0 +1,128 @@
+#include "test/CaptureTest.h"
+
+#include <QFile>
+#include <QtTest/QtTest>
+
+#include <stromx/runtime/DataContainer.h>
+#include <stromx/runtime/ReadAccess.h>
+
+#include "CaptureReader.h"
+#include "CaptureWriter.h"
+#include "Exception.h"
+#include "Image.h"
+#include "Matrix.h"
+
+void CaptureTest::testWriteReadImage()
+{
+    CaptureWriter writer("CaptureTest_testWriteReadImage.capture");
+    writer.open();
+    quint32 channel = writer.addChannel(2, 1, "Operator/Input");
+    
+    Image* original = new Image("lenna.jpg");
+    stromx::runtime::DataContainer container(original);
+    writer.write(channel, 5, stromx::runtime::ReadAccess(container));
+    writer.close();
+    
+    CaptureReader reader("CaptureTest_testWriteReadImage.capture");
+    reader.open();
+    
+    QCOMPARE(reader.channels().count(), 1);
+    QCOMPARE(reader.channels()[channel].operatorId, (unsigned int)(2));
+    QCOMPARE(reader.channels()[channel].inputId, (unsigned int)(1));
+    QCOMPARE(reader.channels()[channel].name, QString("Operator/Input"));
+    QCOMPARE(reader.numFrames(), 1);
+    QCOMPARE(reader.channel(0), channel);
+    QCOMPARE(reader.sequence(0), quint64(5));
+    
+    stromx::runtime::DataContainer readContainer(reader.createData(0));
+    stromx::runtime::ReadAccess access(readContainer);
+    const stromx::runtime::Image & image = stromx::runtime::data_cast<stromx::runtime::Image>(access.get());
+    QCOMPARE(image.width(), original->width());
+    QCOMPARE(image.height(), original->height());
+    QCOMPARE(image.pixelType(), stromx::runtime::Image::RGB_24);
+    QVERIFY(memcmp(image.data(), original->data(), image.width() * image.pixelSize()) == 0);
+}
+
+void CaptureTest::testWriteReadMatrix()
+{
+    CaptureWriter writer("CaptureTest_testWriteReadMatrix.capture");
+    writer.open();
+    quint32 channel = writer.addChannel(0, 0, "Matrix");
+    
+    Matrix* matrix = new Matrix(3, 4, stromx::runtime::Matrix::FLOAT_32);
+    float* values = reinterpret_cast<float*>(matrix->data());
+    for(unsigned int i = 0; i < 3 * 4; ++i)
+        values[i] = float(i);
+    stromx::runtime::DataContainer container(matrix);
+    writer.write(channel, 1, stromx::runtime::ReadAccess(container));
+    writer.write(channel, 2, stromx::runtime::ReadAccess(container));
+    writer.close();
+    
+    CaptureReader reader("CaptureTest_testWriteReadMatrix.capture");
+    reader.open();
+    
+    QCOMPARE(reader.numFrames(), 2);
+    QCOMPARE(reader.sequence(1), quint64(2));
+    QVERIFY(reader.timestamp(0) <= reader.timestamp(1));
+    
+    stromx::runtime::DataContainer readContainer(reader.createData(1));
+    stromx::runtime::ReadAccess access(readContainer);
+    const stromx::runtime::Matrix & readMatrix = stromx::runtime::data_cast<stromx::runtime::Matrix>(access.get());
+    QCOMPARE(readMatrix.rows(), (unsigned int)(3));
+    QCOMPARE(readMatrix.cols(), (unsigned int)(4));
+    QCOMPARE(readMatrix.valueType(), stromx::runtime::Matrix::FLOAT_32);
+    QCOMPARE(reinterpret_cast<const float*>(readMatrix.data())[11], 11.0f);
+}
+
+void CaptureTest::testQueueFull()
+{
+    CaptureWriter writer("CaptureTest_testQueueFull.capture");
+    
+    // data is only accepted while the writer is open
+    QVERIFY(writer.isQueueFull());
+    writer.open();
+    QVERIFY(! writer.isQueueFull());
+    writer.close();
+    QVERIFY(writer.isQueueFull());
+    
+    writer.dropFrame();
+    QCOMPARE(writer.numDroppedFrames(), quint64(1));
+}
+
+void CaptureTest::testReadTruncatedFile()
+{
+    CaptureWriter writer("CaptureTest_testReadTruncatedFile.capture");
+    writer.open();
+    quint32 channel = writer.addChannel(0, 0, "Matrix");
+    
+    stromx::runtime::DataContainer container(new Matrix(10, 10, stromx::runtime::Matrix::UINT_8));
+    writer.write(channel, 1, stromx::runtime::ReadAccess(container));
+    writer.write(channel, 2, stromx::runtime::ReadAccess(container));
+    writer.close();
+    
+    // cut off the end of the second frame
+    QFile file("CaptureTest_testReadTruncatedFile.capture");
+    file.resize(file.size() - 10);
+    
+    CaptureReader reader("CaptureTest_testReadTruncatedFile.capture");
+    reader.open();
+    
+    QCOMPARE(reader.numFrames(), 1);
+}
+
+void CaptureTest::testReadInvalidFile()
+{
+    CaptureReader reader("lenna.jpg");
+    
+    bool thrown = false;
+    try
+    {
+        reader.open();
+    }
+    catch(ReadCaptureFailed &)
+    {
+        thrown = true;
+    }
+    
+    QVERIFY(thrown);
+}
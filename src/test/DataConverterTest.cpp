@@ -3,8 +3,13 @@
 #include <QtTest/QtTest>
 
 #include "DataConverter.h"
+#include "Image.h"
+#include "Matrix.h"
+#include <stromx/runtime/DataRef.h>
+#include <stromx/runtime/Parameter.h>
 #include <stromx/runtime/Primitive.h>
 #include <stromx/runtime/String.h>
+#include <stromx/runtime/Variant.h>
 
 void DataConverterTest::testStromxDataEqualsTarget()
 {
@@ -12,3 +17,71 @@ void DataConverterTest::testStromxDataEqualsTarget()
     QCOMPARE(true, DataConverter::stromxDataEqualsTarget(stromx::runtime::Bool(), stromx::runtime::Bool()));
     QCOMPARE(false, DataConverter::stromxDataEqualsTarget(stromx::runtime::Bool(true), stromx::runtime::Bool(false)));
 }
+
+void DataConverterTest::testToQVariantFunction()
+{
+    stromx::runtime::Parameter param(0, stromx::runtime::Variant::FLOAT_64);
+    stromx::runtime::Float64 data(2.5);
+    
+    DataConverter::ToQVariantFunction function = DataConverter::toQVariantFunction(param.variant());
+    QVERIFY(function);
+    QVERIFY(function == DataConverter::toQVariantFunction(data));
+    QCOMPARE(QVariant(2.5), DataConverter::toQVariant(function, data, param, Qt::DisplayRole));
+    QCOMPARE(QVariant(2.5), DataConverter::toQVariant(data, param, Qt::DisplayRole));
+    QCOMPARE(QVariant(), DataConverter::toQVariant(0, data, param, Qt::DisplayRole));
+}
+
+void DataConverterTest::testToQVariantFunctionComposite()
+{
+    Image image("lenna.jpg");
+    Matrix matrix(3, 4, stromx::runtime::Matrix::FLOAT_32);
+    
+    // images are converted by a different function than other matrices
+    DataConverter::ToQVariantFunction imageFunction = DataConverter::toQVariantFunction(image);
+    DataConverter::ToQVariantFunction matrixFunction = DataConverter::toQVariantFunction(matrix);
+    QVERIFY(imageFunction != matrixFunction);
+    
+    // i.e. the function of a matrix parameter depends on its value
+    stromx::runtime::Parameter matrixParam(0, stromx::runtime::Variant::MATRIX);
+    QVERIFY(! DataConverter::toQVariantFunction(matrixParam.variant()));
+    
+    stromx::runtime::Parameter imageParam(0, stromx::runtime::Variant::IMAGE);
+    QVERIFY(DataConverter::toQVariantFunction(imageParam.variant()) == imageFunction);
+}
+
+void DataConverterTest::testToStromxDataFunction()
+{
+    stromx::runtime::Parameter param(0, stromx::runtime::Variant::INT_32);
+    
+    DataConverter::ToStromxDataFunction function = DataConverter::toStromxDataFunction(param.variant());
+    QVERIFY(function);
+    
+    stromx::runtime::DataRef data = DataConverter::toStromxData(function, QVariant(5), param);
+    QVERIFY(! data.isNull());
+    QVERIFY(DataConverter::stromxDataEqualsTarget(data, stromx::runtime::Int32(5)));
+    QVERIFY(DataConverter::toStromxData(function, QVariant(QString("5")), param).isNull());
+}
+
+void DataConverterTest::benchmarkToQVariant()
+{
+    // float data are found at the end of the chain of variants
+    stromx::runtime::Parameter param(0, stromx::runtime::Variant::FLOAT_64);
+    stromx::runtime::Float64 data(2.5);
+    
+    QBENCHMARK
+    {
+        DataConverter::toQVariant(data, param, Qt::DisplayRole);
+    }
+}
+
+void DataConverterTest::benchmarkToQVariantFunction()
+{
+    stromx::runtime::Parameter param(0, stromx::runtime::Variant::FLOAT_64);
+    stromx::runtime::Float64 data(2.5);
+    DataConverter::ToQVariantFunction function = DataConverter::toQVariantFunction(param.variant());
+    
+    QBENCHMARK
+    {
+        DataConverter::toQVariant(function, data, param, Qt::DisplayRole);
+    }
+}
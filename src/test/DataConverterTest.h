@@ -28,6 +28,11 @@ class DataConverterTest : public QObject
     
 private slots:
     void testStromxDataEqualsTarget();
+    void testToQVariantFunction();
+    void testToQVariantFunctionComposite();
+    void testToStromxDataFunction();
+    void benchmarkToQVariant();
+    void benchmarkToQVariantFunction();
 };
 
 #endif // DATACONVERTERTEST_H
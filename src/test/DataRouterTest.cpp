@@ -0,0 +1,203 @@
+#include "test/DataRouterTest.h"
+
+#include <QtTest/QtTest>
+#include <QUndoStack>
+#include <stromx/cvsupport/Cvsupport.h>
+#include <stromx/runtime/DataContainer.h>
+#include <stromx/runtime/Primitive.h>
+#include <stromx/runtime/ReadAccess.h>
+#include <stromx/runtime/Timeout.h>
+#include <stromx/runtime/WriteAccess.h>
+#include <stromx/runtime/ZipFileInput.h>
+
+#include "AbstractDataVisualizer.h"
+#include "DataManager.h"
+#include "DataRouter.h"
+#include "model/InputModel.h"
+#include "model/ObserverModel.h"
+#include "model/ObserverTreeModel.h"
+#include "model/OperatorLibraryModel.h"
+#include "model/StreamModel.h"
+
+namespace
+{
+    class TestVisualizer : public AbstractDataVisualizer
+    {
+    public:
+        virtual void addLayer(int) {}
+        virtual void moveLayer(int, int) {}
+        virtual void removeLayer(int) {}
+
+        virtual void setData(int pos, const stromx::runtime::Data & data, const VisualizationState &)
+        {
+            layers.append(pos);
+            values.append(stromx::runtime::data_cast<stromx::runtime::Int32>(data));
+        }
+
+        QList<int> layers;
+        QList<int> values;
+    };
+
+    void route(StreamModel* model, InputModel* input, int value, quint64 sequence)
+    {
+        stromx::runtime::DataContainer container(new stromx::runtime::Int32(value));
+        model->dataRouter()->route(input->op(), input->id(), stromx::runtime::ReadAccess(container),
+                                   sequence);
+    }
+}
+
+DataRouterTest::DataRouterTest()
+  : m_undoStack(new QUndoStack(this)),
+    m_operatorLibraryModel(new OperatorLibraryModel(this)),
+    m_model(0)
+{
+    stromxRegisterCvsupport(m_operatorLibraryModel->factory());
+}
+
+void DataRouterTest::init()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    m_model = new StreamModel(input, "stream", m_undoStack, m_operatorLibraryModel, this);
+    m_model->readObserverData(input);
+}
+
+void DataRouterTest::cleanup()
+{
+    m_undoStack->clear();
+    delete m_model;
+    m_model = 0;
+}
+
+void DataRouterTest::testSubscribe()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    InputModel* input = observer->input(0);
+    DataRouter* router = m_model->dataRouter();
+
+    QCOMPARE(router->numSubscriptions(input->op(), input->id()), 0);
+
+    TestVisualizer visualizer1;
+    DataManager manager1(observer, &visualizer1, 0);
+    QCOMPARE(router->numSubscriptions(input->op(), input->id()), 1);
+
+    TestVisualizer visualizer2;
+    DataManager manager2(observer, &visualizer2, 0);
+    QCOMPARE(router->numSubscriptions(input->op(), input->id()), 2);
+
+    router->unsubscribe(input, &manager1);
+    QCOMPARE(router->numSubscriptions(input->op(), input->id()), 1);
+}
+
+void DataRouterTest::testRouteSubscribed()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+
+    TestVisualizer visualizer1;
+    DataManager manager1(observer, &visualizer1, 0);
+    TestVisualizer visualizer2;
+    DataManager manager2(observer, &visualizer2, 0);
+
+    route(m_model, observer->input(1), 5, 1);
+
+    // the data is displayed in the layer of the input by all subscribers
+    QCOMPARE(visualizer1.layers, QList<int>() << 1);
+    QCOMPARE(visualizer1.values, QList<int>() << 5);
+    QCOMPARE(visualizer2.layers, QList<int>() << 1);
+    QCOMPARE(visualizer2.values, QList<int>() << 5);
+}
+
+void DataRouterTest::testRouteUnsubscribed()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    InputModel* input = observer->input(1);
+
+    TestVisualizer visualizer1;
+    DataManager manager1(observer, &visualizer1, 0);
+    TestVisualizer visualizer2;
+    DataManager manager2(observer, &visualizer2, 0);
+
+    m_model->dataRouter()->unsubscribe(input, &manager1);
+    route(m_model, input, 5, 1);
+
+    // only the remaining subscriber receives the data
+    QVERIFY(visualizer1.layers.isEmpty());
+    QCOMPARE(visualizer2.layers, QList<int>() << 1);
+
+    // the data of removed inputs is not routed at all
+    m_model->observerModel()->removeInput(observer, 1);
+    route(m_model, input, 6, 2);
+
+    QVERIFY(visualizer1.layers.isEmpty());
+    QCOMPARE(visualizer2.layers, QList<int>() << 1);
+    QCOMPARE(m_model->dataRouter()->numSubscriptions(input->op(), input->id()), 0);
+}
+
+void DataRouterTest::testRemoveManager()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    InputModel* input = observer->input(0);
+
+    TestVisualizer visualizer;
+    DataManager* manager = new DataManager(observer, &visualizer, 0);
+    QCOMPARE(m_model->dataRouter()->numSubscriptions(input->op(), input->id()), 1);
+
+    delete manager;
+    QCOMPARE(m_model->dataRouter()->numSubscriptions(input->op(), input->id()), 0);
+
+    // routing data without subscribers must not fail
+    route(m_model, input, 5, 1);
+}
+
+void DataRouterTest::testRouteReleasesAccess()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    InputModel* input = observer->input(0);
+    
+    TestVisualizer visualizer;
+    DataManager manager(observer, &visualizer, 0);
+    
+    stromx::runtime::DataContainer container(new stromx::runtime::Int32(5));
+    m_model->dataRouter()->route(input->op(), input->id(), stromx::runtime::ReadAccess(container), 1);
+    
+    // the data can be written as soon as it has been routed
+    try
+    {
+        stromx::runtime::WriteAccess access(container, 100);
+    }
+    catch(stromx::runtime::Timeout &)
+    {
+        QFAIL("The data is still read by the router.");
+    }
+}
+
+void DataRouterTest::testRouteSynchronizedReleasesAccess()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    observer->setSynchronized(true);
+    
+    TestVisualizer visualizer;
+    DataManager manager(observer, &visualizer, 0);
+    
+    route(m_model, observer->input(1), 5, 1);
+    
+    // the data waits for matching data at the first input
+    stromx::runtime::DataContainer container(new stromx::runtime::Int32(6));
+    m_model->dataRouter()->route(observer->input(0)->op(), observer->input(0)->id(),
+                                 stromx::runtime::ReadAccess(container), 2);
+    QCOMPARE(visualizer.layers, QList<int>() << 1);
+    
+    // the buffered data does not block the stream
+    try
+    {
+        stromx::runtime::WriteAccess access(container, 100);
+    }
+    catch(stromx::runtime::Timeout &)
+    {
+        QFAIL("The data is still read by the data manager.");
+    }
+    
+    // a copy of the buffered data is displayed
+    observer->setSynchronized(false);
+    QCOMPARE(visualizer.layers, QList<int>() << 1 << 0);
+    QCOMPARE(visualizer.values, QList<int>() << 5 << 6);
+}
@@ -0,0 +1,53 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef DATAROUTERTEST_H
+#define DATAROUTERTEST_H
+
+#include <QObject>
+
+class QUndoStack;
+class OperatorLibraryModel;
+class StreamModel;
+
+class DataRouterTest : public QObject
+{
+    Q_OBJECT
+    
+public:
+    explicit DataRouterTest();
+    
+private slots:
+    void init();
+    void cleanup();
+    void testSubscribe();
+    void testRouteSubscribed();
+    void testRouteUnsubscribed();
+    void testRemoveManager();
+    void testRouteReleasesAccess();
+    void testRouteSynchronizedReleasesAccess();
+    
+private:
+    QUndoStack* m_undoStack;
+    OperatorLibraryModel* m_operatorLibraryModel;
+    StreamModel* m_model;
+};
+
+#endif // DATAROUTERTEST_H
@@ -0,0 +1,67 @@
+#include "test/ErrorListModelTest.h"
+
+#include <QtTest/QtTest>
+#include <stromx/runtime/Dump.h>
+#include <stromx/runtime/Operator.h>
+#include <stromx/runtime/OperatorException.h>
+
+#include "data/ErrorData.h"
+#include "model/ErrorListModel.h"
+
+void ErrorListModelTest::testAggregateErrors()
+{
+    ErrorListModel model;
+    
+    for(int i = 0; i < 1000; ++i)
+        model.exceptionObserver()->sendErrorData(ErrorData());
+    QCoreApplication::sendPostedEvents();
+    
+    QCOMPARE(model.rowCount(QModelIndex()), 1);
+    QCOMPARE(model.data(model.index(0, ErrorListModel::COUNT)), QVariant(1000));
+}
+
+void ErrorListModelTest::testAggregateErrorsPerOperator()
+{
+    ErrorListModel model;
+    
+    // both operators have the same package, type and name
+    stromx::runtime::Operator op1(new stromx::runtime::Dump);
+    stromx::runtime::Operator op2(new stromx::runtime::Dump);
+    stromx::runtime::OperatorError error(op1.info(), "Error");
+    
+    model.exceptionObserver()->sendErrorData(ErrorData(error, ErrorData::PARAMETER_ACCESS, &op1));
+    model.exceptionObserver()->sendErrorData(ErrorData(error, ErrorData::PARAMETER_ACCESS, &op1));
+    model.exceptionObserver()->sendErrorData(ErrorData(error, ErrorData::PARAMETER_ACCESS, &op2));
+    QCoreApplication::sendPostedEvents();
+    
+    QCOMPARE(model.rowCount(QModelIndex()), 2);
+}
+
+void ErrorListModelTest::testRateLimit()
+{
+    ErrorListModel model;
+    
+    model.exceptionObserver()->sendErrorData(ErrorData());
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(model.data(model.index(0, ErrorListModel::COUNT)), QVariant(1));
+    
+    // the second error is not transferred before the interval elapsed
+    model.exceptionObserver()->sendErrorData(ErrorData());
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(model.data(model.index(0, ErrorListModel::COUNT)), QVariant(1));
+    
+    QTest::qWait(2 * ErrorListModel::TRANSFER_INTERVAL);
+    QCOMPARE(model.rowCount(QModelIndex()), 1);
+    QCOMPARE(model.data(model.index(0, ErrorListModel::COUNT)), QVariant(2));
+}
+
+void ErrorListModelTest::testClear()
+{
+    ErrorListModel model;
+    
+    model.exceptionObserver()->sendErrorData(ErrorData());
+    QCoreApplication::sendPostedEvents();
+    model.clear();
+    
+    QCOMPARE(model.rowCount(QModelIndex()), 0);
+}
@@ -0,0 +1,118 @@
+#include "test/FrameHistoryTest.h"
+
+#include <QtTest/QtTest>
+#include <stromx/runtime/Primitive.h>
+
+#include "FrameHistory.h"
+
+namespace
+{
+    // the history only uses the inputs as keys and never accesses them
+    InputModel* const INPUT_1 = reinterpret_cast<InputModel*>(0x1);
+    InputModel* const INPUT_2 = reinterpret_cast<InputModel*>(0x2);
+    
+    int value(const stromx::runtime::Data* data)
+    {
+        if(! data)
+            return -1;
+        
+        return stromx::runtime::data_cast<stromx::runtime::Int32>(*data);
+    }
+}
+
+void FrameHistoryTest::testRecord()
+{
+    FrameHistory history;
+    history.setRecording(true);
+    QSignalSpy spy(&history, SIGNAL(numFramesChanged(int)));
+    stromx::runtime::Int32 data1(1);
+    stromx::runtime::Int32 data2(2);
+    
+    history.record(INPUT_1, data1);
+    history.record(INPUT_2, data2);
+    
+    QCOMPARE(history.numFrames(), 2);
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(history.input(0), INPUT_1);
+    QCOMPARE(history.input(1), INPUT_2);
+    
+    // the newest data of the input up to the position is returned
+    QCOMPARE(value(history.data(INPUT_1, 1)), 1);
+    QCOMPARE(value(history.data(INPUT_2, 1)), 2);
+    QCOMPARE(value(history.data(INPUT_2, 0)), -1);
+    
+    // the history stores a copy of the data
+    QVERIFY(history.data(INPUT_1, 0) != &data1);
+}
+
+void FrameHistoryTest::testRecordingStopped()
+{
+    FrameHistory history;
+    
+    // recording must be explicitly started
+    QVERIFY(! history.isRecording());
+    history.record(INPUT_1, stromx::runtime::Int32(1));
+    QCOMPARE(history.numFrames(), 0);
+    
+    history.setRecording(true);
+    history.setRecording(false);
+    history.record(INPUT_1, stromx::runtime::Int32(1));
+    QCOMPARE(history.numFrames(), 0);
+}
+
+void FrameHistoryTest::testMaxFramesPerInput()
+{
+    FrameHistory history;
+    history.setRecording(true);
+    history.setMaxFramesPerInput(2);
+    
+    history.record(INPUT_1, stromx::runtime::Int32(1));
+    history.record(INPUT_2, stromx::runtime::Int32(2));
+    history.record(INPUT_1, stromx::runtime::Int32(3));
+    history.record(INPUT_1, stromx::runtime::Int32(4));
+    
+    // only the oldest frame of the first input is dropped
+    QCOMPARE(history.numFrames(), 3);
+    QCOMPARE(history.input(0), INPUT_2);
+    QCOMPARE(value(history.data(INPUT_1, 1)), 3);
+    QCOMPARE(value(history.data(INPUT_1, 2)), 4);
+    
+    history.setMaxFramesPerInput(1);
+    QCOMPARE(history.numFrames(), 2);
+}
+
+void FrameHistoryTest::testMemoryBudget()
+{
+    FrameHistory history;
+    history.setRecording(true);
+    qint64 size = FrameHistory::dataSize(stromx::runtime::Int32(0));
+    history.setMemoryBudget(2 * size);
+    
+    history.record(INPUT_1, stromx::runtime::Int32(1));
+    history.record(INPUT_2, stromx::runtime::Int32(2));
+    history.record(INPUT_1, stromx::runtime::Int32(3));
+    
+    // the oldest frame is dropped
+    QCOMPARE(history.numFrames(), 2);
+    QCOMPARE(history.memoryUsage(), 2 * size);
+    QCOMPARE(value(history.data(INPUT_1, 1)), 3);
+    
+    history.setMemoryBudget(0);
+    QCOMPARE(history.numFrames(), 0);
+    QCOMPARE(history.memoryUsage(), qint64(0));
+}
+
+void FrameHistoryTest::testRemoveInput()
+{
+    FrameHistory history;
+    history.setRecording(true);
+    history.record(INPUT_1, stromx::runtime::Int32(1));
+    history.record(INPUT_2, stromx::runtime::Int32(2));
+    history.record(INPUT_1, stromx::runtime::Int32(3));
+    
+    history.removeInput(INPUT_1);
+    
+    QCOMPARE(history.numFrames(), 1);
+    QCOMPARE(history.input(0), INPUT_2);
+    QVERIFY(! history.data(INPUT_1, 0));
+}
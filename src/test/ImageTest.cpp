@@ -39,3 +39,48 @@ void ImageTest::testQImageConstructor()
 }
 
 
+
+void ImageTest::testCopyConstructorSharesData()
+{
+    const Image image("lenna.jpg");
+    const Image copy(image);
+    
+    QCOMPARE(copy.data(), image.data());
+}
+
+void ImageTest::testDataDetaches()
+{
+    const Image image("lenna.jpg");
+    Image copy(image);
+    
+    uint8_t* data = copy.data();
+    
+    QVERIFY(data != image.data());
+    QCOMPARE(memcmp(data, image.data(), image.height() * image.stride()), 0);
+}
+
+void ImageTest::testBufferDetaches()
+{
+    const Image image("lenna.jpg");
+    Image copy(image);
+    
+    uint8_t* buffer = copy.buffer();
+    buffer[0] = uint8_t(~image.data()[0]);
+    
+    QVERIFY(buffer != image.data());
+    QVERIFY(copy.data()[0] != image.data()[0]);
+}
+
+void ImageTest::testResizeDetaches()
+{
+    const Image reference("lenna.jpg");
+    const Image image("lenna.jpg");
+    Image copy(image);
+    
+    copy.resize(image.width(), image.height(), stromx::runtime::Image::RGB_24);
+    memset(copy.data(), 0, copy.height() * copy.stride());
+    
+    QVERIFY(copy.data() != image.data());
+    QCOMPARE(copy.pixelType(), stromx::runtime::Image::RGB_24);
+    QCOMPARE(memcmp(image.data(), reference.data(), image.height() * image.stride()), 0);
+}
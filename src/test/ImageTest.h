@@ -31,6 +31,10 @@ private slots:
     void testFileConstructorGray();
     void testQImageConstructor();
     void testFileConstructorNullImage();
+    void testCopyConstructorSharesData();
+    void testDataDetaches();
+    void testBufferDetaches();
+    void testResizeDetaches();
 };
 
 #endif // IMAGETEST_H
@@ -0,0 +1,95 @@
+#include "test/LimitUndoStackTest.h"
+
+#include <QAction>
+#include <QtTest/QtTest>
+#include <stromx/runtime/OperatorTester.h>
+#include <stromx/test/ParameterOperator.h>
+#include "FrameHistory.h"
+#include "LimitUndoStack.h"
+#include "ParameterServer.h"
+#include "cmd/SetParameterCmd.h"
+
+namespace
+{
+    SetParameterCmd* createCmd(ParameterServer* server, const stromx::runtime::DataRef & oldValue,
+                               const stromx::runtime::DataRef & newValue)
+    {
+        return new SetParameterCmd(server, stromx::test::ParameterOperator::INT_PARAM, oldValue, newValue);
+    }
+    
+    stromx::runtime::DataRef createValue(int value)
+    {
+        return stromx::runtime::DataRef(new stromx::runtime::Int32(value));
+    }
+}
+
+LimitUndoStackTest::LimitUndoStackTest()
+  : m_op(new stromx::runtime::OperatorTester(new stromx::test::ParameterOperator())),
+    m_server(new ParameterServer(m_op, 0, this))
+{
+    m_op->initialize();
+    m_server->refresh();
+    QTest::qWait(100);
+}
+
+LimitUndoStackTest::~LimitUndoStackTest()
+{
+    delete m_op;
+}
+
+void LimitUndoStackTest::testMemoryUsage()
+{
+    LimitUndoStack stack;
+    qint64 size = FrameHistory::dataSize(stromx::runtime::Int32());
+    
+    stack.push(createCmd(m_server, createValue(0), createValue(1)));
+    stack.push(createCmd(m_server, createValue(1), createValue(2)));
+    QTest::qWait(100);
+    
+    QCOMPARE(stack.memoryUsage(), 4 * size);
+}
+
+void LimitUndoStackTest::testMemoryUsageSharedData()
+{
+    LimitUndoStack stack;
+    qint64 size = FrameHistory::dataSize(stromx::runtime::Int32());
+    stromx::runtime::DataRef shared = createValue(1);
+    
+    stack.push(createCmd(m_server, createValue(0), shared));
+    stack.push(createCmd(m_server, shared, createValue(2)));
+    QTest::qWait(100);
+    
+    QCOMPARE(stack.memoryUsage(), 3 * size);
+}
+
+void LimitUndoStackTest::testMemoryBudget()
+{
+    LimitUndoStack stack;
+    QAction* undoAction = stack.createLimitUndoAction(&stack);
+    qint64 size = FrameHistory::dataSize(stromx::runtime::Int32());
+    stack.setMemoryBudget(4 * size);
+    
+    for(int i = 0; i < 10; ++i)
+        stack.push(createCmd(m_server, createValue(i), createValue(i + 1)));
+    QTest::qWait(100);
+    
+    // only the last two commands hold their values
+    QCOMPARE(stack.memoryUsage(), 4 * size);
+    
+    stack.undo();
+    QVERIFY(undoAction->isEnabled());
+    stack.undo();
+    QVERIFY(! undoAction->isEnabled());
+    QTest::qWait(100);
+}
+
+void LimitUndoStackTest::testClear()
+{
+    LimitUndoStack stack;
+    stack.push(createCmd(m_server, createValue(0), createValue(1)));
+    QTest::qWait(100);
+    
+    stack.clear();
+    
+    QCOMPARE(stack.memoryUsage(), qint64(0));
+}
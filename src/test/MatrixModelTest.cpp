@@ -0,0 +1,119 @@
+#include "test/MatrixModelTest.h"
+
+#include <QtTest/QtTest>
+#include <climits>
+
+#include "Matrix.h"
+#include "model/MatrixModel.h"
+
+namespace
+{
+    Matrix createMatrix(const stromx::runtime::Matrix::ValueType valueType)
+    {
+        Matrix matrix(3, 4, valueType);
+        for(unsigned int i = 0; i < matrix.rows(); ++i)
+        {
+            for(unsigned int j = 0; j < matrix.cols(); ++j)
+            {
+                if(valueType == stromx::runtime::Matrix::FLOAT_64)
+                    matrix.at<double>(i, j) = double(i * matrix.cols() + j);
+                else
+                    matrix.at<int16_t>(i, j) = int16_t(i * matrix.cols() + j);
+            }
+        }
+        
+        return matrix;
+    }
+}
+
+void MatrixModelTest::testData()
+{
+    MatrixModel model(createMatrix(stromx::runtime::Matrix::FLOAT_64));
+    
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.columnCount(), 4);
+    QCOMPARE(model.data(model.index(2, 1)), QVariant(9.0));
+}
+
+void MatrixModelTest::testSetData()
+{
+    const Matrix matrix = createMatrix(stromx::runtime::Matrix::INT_16);
+    MatrixModel model(matrix);
+    
+    QVERIFY(model.setData(model.index(1, 2), QVariant(-5.0)));
+    
+    QCOMPARE(model.matrix().at<int16_t>(1, 2), int16_t(-5));
+    QCOMPARE(matrix.at<int16_t>(1, 2), int16_t(6));
+}
+
+void MatrixModelTest::testSetDataInvalid()
+{
+    MatrixModel model(createMatrix(stromx::runtime::Matrix::INT_16));
+    
+    QVERIFY(! model.setData(model.index(1, 2), QVariant("abc")));
+    QCOMPARE(model.matrix().at<int16_t>(1, 2), int16_t(6));
+}
+
+void MatrixModelTest::testResize()
+{
+    MatrixModel model(createMatrix(stromx::runtime::Matrix::FLOAT_64));
+    
+    model.resize(4, 2);
+    
+    QCOMPARE(model.matrix().rows(), (unsigned int)(4));
+    QCOMPARE(model.matrix().cols(), (unsigned int)(2));
+    QCOMPARE(model.matrix().at<double>(2, 1), 9.0);
+    QCOMPARE(model.matrix().at<double>(3, 1), 0.0);
+}
+
+void MatrixModelTest::testResizeTooLarge()
+{
+    MatrixModel model(createMatrix(stromx::runtime::Matrix::FLOAT_64));
+    
+    QVERIFY(! model.resize(INT_MAX, INT_MAX));
+    QVERIFY(! model.resize(65536, 65536));
+    
+    QCOMPARE(model.matrix().rows(), (unsigned int)(3));
+    QCOMPARE(model.matrix().cols(), (unsigned int)(4));
+}
+
+void MatrixModelTest::testFill()
+{
+    MatrixModel model(createMatrix(stromx::runtime::Matrix::INT_16));
+    
+    model.fill(7.0);
+    
+    QCOMPARE(model.matrix().at<int16_t>(0, 0), int16_t(7));
+    QCOMPARE(model.matrix().at<int16_t>(2, 3), int16_t(7));
+}
+
+void MatrixModelTest::testScale()
+{
+    MatrixModel model(createMatrix(stromx::runtime::Matrix::FLOAT_64));
+    
+    model.scale(0.5);
+    
+    QCOMPARE(model.matrix().at<double>(0, 1), 0.5);
+    QCOMPARE(model.matrix().at<double>(2, 3), 5.5);
+}
+
+void MatrixModelTest::testPaste()
+{
+    MatrixModel model(createMatrix(stromx::runtime::Matrix::FLOAT_64));
+    
+    QVERIFY(model.paste("-1\t-2\t-3\n-4,-5,-6\n", model.index(1, 2)));
+    
+    QCOMPARE(model.matrix().at<double>(1, 2), -1.0);
+    QCOMPARE(model.matrix().at<double>(1, 3), -2.0);
+    QCOMPARE(model.matrix().at<double>(2, 2), -4.0);
+    QCOMPARE(model.matrix().at<double>(2, 3), -5.0);
+    QCOMPARE(model.matrix().at<double>(1, 1), 5.0);
+}
+
+void MatrixModelTest::testPasteInvalid()
+{
+    MatrixModel model(createMatrix(stromx::runtime::Matrix::FLOAT_64));
+    
+    QVERIFY(! model.paste("1\tx", model.index(0, 0)));
+    QCOMPARE(model.matrix().at<double>(0, 0), 0.0);
+}
@@ -0,0 +1,42 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MATRIXMODELTEST_H
+#define MATRIXMODELTEST_H
+
+#include <QObject>
+
+class MatrixModelTest : public QObject
+{
+    Q_OBJECT
+    
+private slots:
+    void testData();
+    void testSetData();
+    void testSetDataInvalid();
+    void testResize();
+    void testResizeTooLarge();
+    void testFill();
+    void testScale();
+    void testPaste();
+    void testPasteInvalid();
+};
+
+#endif // MATRIXMODELTEST_H
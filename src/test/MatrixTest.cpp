@@ -0,0 +1,118 @@
+#include "test/MatrixTest.h"
+
+#include <QtTest/QtTest>
+#include <stromx/runtime/DirectoryFileInput.h>
+#include <stromx/runtime/DirectoryFileOutput.h>
+
+#include "Matrix.h"
+
+namespace
+{
+    Matrix createMatrix()
+    {
+        Matrix matrix(10, 20, stromx::runtime::Matrix::FLOAT_32);
+        for(unsigned int i = 0; i < matrix.rows(); ++i)
+        {
+            for(unsigned int j = 0; j < matrix.cols(); ++j)
+                matrix.at<float>(i, j) = float(i * matrix.cols() + j);
+        }
+        
+        return matrix;
+    }
+}
+
+void MatrixTest::testCopyConstructorSharesData()
+{
+    const Matrix matrix = createMatrix();
+    const Matrix copy(matrix);
+    
+    QVERIFY(copy.isShared());
+    QCOMPARE(copy.data(), matrix.data());
+}
+
+void MatrixTest::testConstructorFromStudioMatrixSharesData()
+{
+    const Matrix matrix = createMatrix();
+    const stromx::runtime::Matrix & stromxMatrix = matrix;
+    const Matrix copy(stromxMatrix);
+    
+    QCOMPARE(copy.data(), matrix.data());
+}
+
+void MatrixTest::testDataDetaches()
+{
+    const Matrix matrix = createMatrix();
+    Matrix copy(matrix);
+    
+    copy.at<float>(0, 0) = -1.0f;
+    
+    QVERIFY(! copy.isShared());
+    QVERIFY(! matrix.isShared());
+    QCOMPARE(matrix.at<float>(0, 0), 0.0f);
+    QCOMPARE(copy.at<float>(0, 0), -1.0f);
+    QCOMPARE(copy.at<float>(9, 19), 199.0f);
+}
+
+void MatrixTest::testResizeDetaches()
+{
+    const Matrix matrix = createMatrix();
+    Matrix copy(matrix);
+    
+    copy.resize(2, 3, stromx::runtime::Matrix::FLOAT_32);
+    
+    QCOMPARE(copy.rows(), (unsigned int)(2));
+    QCOMPARE(matrix.rows(), (unsigned int)(10));
+    QCOMPARE(matrix.at<float>(9, 19), 199.0f);
+}
+
+void MatrixTest::testResizeSameSizeDetaches()
+{
+    const Matrix matrix = createMatrix();
+    Matrix copy(matrix);
+    
+    copy.resize(10, 20, stromx::runtime::Matrix::FLOAT_32);
+    copy.at<float>(9, 19) = -1.0f;
+    
+    QVERIFY(copy.data() != matrix.data());
+    QCOMPARE(matrix.at<float>(9, 19), 199.0f);
+}
+
+void MatrixTest::testBufferDetaches()
+{
+    const Matrix matrix = createMatrix();
+    Matrix copy(matrix);
+    
+    float* buffer = reinterpret_cast<float*>(copy.buffer());
+    buffer[0] = -1.0f;
+    
+    QVERIFY(! copy.isShared());
+    QCOMPARE(matrix.at<float>(0, 0), 0.0f);
+    QCOMPARE(copy.at<float>(0, 0), -1.0f);
+}
+
+void MatrixTest::testDeserializeDetaches()
+{
+    Matrix source(10, 20, stromx::runtime::Matrix::FLOAT_32);
+    for(unsigned int i = 0; i < source.rows(); ++i)
+    {
+        for(unsigned int j = 0; j < source.cols(); ++j)
+            source.at<float>(i, j) = -1.0f;
+    }
+    
+    stromx::runtime::DirectoryFileOutput output(".");
+    output.initialize("MatrixTest_testDeserializeDetaches");
+    source.serialize(output);
+    std::string text = output.getText();
+    std::string filename = output.getFilename();
+    output.close();
+    
+    const Matrix matrix = createMatrix();
+    Matrix copy(matrix);
+    
+    stromx::runtime::DirectoryFileInput input(".");
+    input.initialize(text, filename);
+    copy.deserialize(input, copy.version());
+    
+    QCOMPARE(copy.at<float>(9, 19), -1.0f);
+    QCOMPARE(matrix.at<float>(9, 19), 199.0f);
+}
@@ -0,0 +1,108 @@
+#include "test/ObserverModelTest.h"
+
+#include <QtTest/QtTest>
+#include <QUndoStack>
+#include <stromx/cvsupport/Cvsupport.h>
+#include <stromx/runtime/ZipFileInput.h>
+
+#include "FrameHistory.h"
+#include "model/ObserverModel.h"
+#include "model/ObserverTreeModel.h"
+#include "model/OperatorLibraryModel.h"
+#include "model/StreamModel.h"
+
+ObserverModelTest::ObserverModelTest()
+  : m_undoStack(new QUndoStack(this)),
+    m_operatorLibraryModel(new OperatorLibraryModel(this)),
+    m_model(0)
+{
+    stromxRegisterCvsupport(m_operatorLibraryModel->factory());
+}
+
+void ObserverModelTest::init()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    m_model = new StreamModel(input, "stream", m_undoStack, m_operatorLibraryModel, this);
+    m_model->readObserverData(input);
+    m_undoStack->clear();
+}
+
+void ObserverModelTest::cleanup()
+{
+    m_undoStack->clear();
+    delete m_model;
+    m_model = 0;
+}
+
+void ObserverModelTest::testSetName()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    QString name = observer->name();
+    
+    observer->setName("Renamed observer");
+    QCOMPARE(observer->name(), QString("Renamed observer"));
+    QCOMPARE(m_undoStack->count(), 1);
+    
+    m_undoStack->undo();
+    QCOMPARE(observer->name(), name);
+}
+
+void ObserverModelTest::testSetSynchronized()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    QSignalSpy spy(observer, SIGNAL(synchronizedChanged(bool)));
+    
+    observer->setSynchronized(true);
+    QVERIFY(observer->isSynchronized());
+    QCOMPARE(m_undoStack->count(), 1);
+    
+    // setting the same value again is not recorded
+    observer->setSynchronized(true);
+    QCOMPARE(m_undoStack->count(), 1);
+    
+    m_undoStack->undo();
+    QVERIFY(! observer->isSynchronized());
+    QCOMPARE(spy.count(), 2);
+    
+    m_undoStack->redo();
+    QVERIFY(observer->isSynchronized());
+}
+
+void ObserverModelTest::testSetMaxLatency()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    int latency = observer->maxLatency();
+    
+    observer->setMaxLatency(latency + 100);
+    QCOMPARE(observer->maxLatency(), latency + 100);
+    QCOMPARE(m_undoStack->count(), 1);
+    
+    // negative latencies are truncated
+    observer->setMaxLatency(-1);
+    QCOMPARE(observer->maxLatency(), 0);
+    QCOMPARE(m_undoStack->count(), 2);
+    
+    m_undoStack->undo();
+    m_undoStack->undo();
+    QCOMPARE(observer->maxLatency(), latency);
+}
+
+void ObserverModelTest::testSetHistorySize()
+{
+    ObserverModel* observer = m_model->observerModel()->observers()[0];
+    int frames = observer->history()->maxFramesPerInput();
+    qint64 budget = observer->history()->memoryBudget();
+    
+    observer->setHistorySize(frames + 1, budget + 1);
+    QCOMPARE(observer->history()->maxFramesPerInput(), frames + 1);
+    QCOMPARE(observer->history()->memoryBudget(), budget + 1);
+    QCOMPARE(m_undoStack->count(), 1);
+    
+    // setting the same size again is not recorded
+    observer->setHistorySize(frames + 1, budget + 1);
+    QCOMPARE(m_undoStack->count(), 1);
+    
+    m_undoStack->undo();
+    QCOMPARE(observer->history()->maxFramesPerInput(), frames);
+    QCOMPARE(observer->history()->memoryBudget(), budget);
+}
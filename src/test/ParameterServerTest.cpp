@@ -4,6 +4,7 @@
 #include <QtTest/QtTest>
 #include <stromx/runtime/OperatorTester.h>
 #include <stromx/test/ParameterOperator.h>
+#include "Common.h"
 #include "ParameterServer.h"
 
 ParameterServerTest::ParameterServerTest()
@@ -38,6 +39,17 @@ void ParameterServerTest::testSetParameter()
     QCOMPARE(QVariant(tr("True")), m_server->getParameter(stromx::test::ParameterOperator::BOOL_PARAM, Qt::DisplayRole));
 }
 
+void ParameterServerTest::testGetParameterChoices()
+{
+    QVariant choices = m_server->getParameter(stromx::test::ParameterOperator::BOOL_PARAM, ChoicesRole);
+    QCOMPARE(choices.toStringList().count(), 2);
+    
+    // the cached choices are returned while the parameter is being set
+    m_server->setParameter(stromx::test::ParameterOperator::BOOL_PARAM, QVariant(0));
+    QCOMPARE(m_server->getParameter(stromx::test::ParameterOperator::BOOL_PARAM, ChoicesRole), choices);
+    QTest::qWait(1000);
+}
+
 void ParameterServerTest::testRefresh()
 {
     m_server->refresh();
@@ -43,6 +43,7 @@ public:
 private slots:
     void testGetParameter();
     void testSetParameter();
+    void testGetParameterChoices();
     void testRefresh();
     
 private:
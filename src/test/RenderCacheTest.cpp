@@ -0,0 +1,94 @@
+#include "test/RenderCacheTest.h"
+
+#include <QGraphicsLineItem>
+#include <QtTest/QtTest>
+
+#include "Matrix.h"
+#include "visualization/RenderCache.h"
+#include "visualization/VisualizationState.h"
+
+namespace
+{
+    void setLine(Matrix & matrix, double x1, double y1, double x2, double y2)
+    {
+        double* values = reinterpret_cast<double*>(matrix.data());
+        values[0] = x1;
+        values[1] = y1;
+        values[2] = x2;
+        values[3] = y2;
+    }
+    
+    Matrix createLine(double x1, double y1, double x2, double y2)
+    {
+        Matrix matrix(1, 4, Matrix::FLOAT_64);
+        setLine(matrix, x1, y1, x2, y2);
+        return matrix;
+    }
+    
+    QLineF line(const QList<QGraphicsItem*> & items)
+    {
+        if(items.count() != 1 || items[0]->type() != QGraphicsLineItem::Type)
+            return QLineF();
+        
+        return static_cast<QGraphicsLineItem*>(items[0])->line();
+    }
+    
+    VisualizationState lineSegments()
+    {
+        VisualizationState state;
+        state.setCurrentVisualization("line_segments");
+        return state;
+    }
+}
+
+void RenderCacheTest::testCreateItemsCached()
+{
+    RenderCache cache;
+    Matrix matrix = createLine(0, 0, 1, 1);
+    cache.setFrame(0, 0, matrix);
+    
+    QList<QGraphicsItem*> items = cache.createItems(matrix, lineSegments());
+    QCOMPARE(line(items), QLineF(0, 0, 1, 1));
+    qDeleteAll(items);
+    
+    // the items are copied from the cache and not created from the data again
+    setLine(matrix, 2, 2, 3, 3);
+    items = cache.createItems(matrix, lineSegments());
+    QCOMPARE(line(items), QLineF(0, 0, 1, 1));
+    qDeleteAll(items);
+    
+    cache.removeFrame(0, 0);
+}
+
+void RenderCacheTest::testCreateItemsUncached()
+{
+    RenderCache cache;
+    Matrix matrix = createLine(0, 0, 1, 1);
+    
+    QList<QGraphicsItem*> items = cache.createItems(matrix, lineSegments());
+    QCOMPARE(line(items), QLineF(0, 0, 1, 1));
+    qDeleteAll(items);
+    
+    // data which is not a frame of the cache is always converted
+    setLine(matrix, 2, 2, 3, 3);
+    items = cache.createItems(matrix, lineSegments());
+    QCOMPARE(line(items), QLineF(2, 2, 3, 3));
+    qDeleteAll(items);
+}
+
+void RenderCacheTest::testRemoveFrame()
+{
+    RenderCache cache;
+    Matrix matrix = createLine(0, 0, 1, 1);
+    cache.setFrame(0, 0, matrix);
+    
+    QList<QGraphicsItem*> items = cache.createItems(matrix, lineSegments());
+    qDeleteAll(items);
+    
+    // the cached items are forgotten with the frame
+    cache.removeFrame(0, 0);
+    setLine(matrix, 2, 2, 3, 3);
+    items = cache.createItems(matrix, lineSegments());
+    QCOMPARE(line(items), QLineF(2, 2, 3, 3));
+    qDeleteAll(items);
+}
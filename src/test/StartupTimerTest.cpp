@@ -0,0 +1,86 @@
+#include "test/StartupTimerTest.h"
+
+#include <QUndoStack>
+#include <QtTest/QtTest>
+#include "StartupTimer.h"
+#include "model/OperatorLibraryModel.h"
+#include "model/StreamModel.h"
+
+namespace
+{
+    // time in milliseconds which the construction of the models of the main
+    // window may take before the first paint is noticeably delayed, the default
+    // is generous to avoid failures on slow or busy machines
+    const qint64 DEFAULT_MODEL_STARTUP_BUDGET = 5000;
+    
+    // the budget can be tightened or relaxed by this environment variable
+    const char* MODEL_STARTUP_BUDGET_VARIABLE = "STROMX_STUDIO_STARTUP_BUDGET";
+    
+    qint64 modelStartupBudget()
+    {
+        bool ok = false;
+        qint64 budget = qgetenv(MODEL_STARTUP_BUDGET_VARIABLE).toLongLong(&ok);
+        return ok && budget > 0 ? budget : DEFAULT_MODEL_STARTUP_BUDGET;
+    }
+}
+
+void StartupTimerTest::testMark()
+{
+    StartupTimer timer;
+    QTest::qSleep(10);
+    timer.mark("first");
+    timer.mark("second");
+    
+    QCOMPARE(timer.phases().count(), 2);
+    QCOMPARE(timer.phases()[0].name, QString("first"));
+    QVERIFY(timer.phases()[0].duration >= 10);
+    QCOMPARE(timer.phases()[1].end, timer.phases()[0].end + timer.phases()[1].duration);
+}
+
+void StartupTimerTest::testFirstPaint()
+{
+    StartupTimer timer;
+    QSignalSpy spy(&timer, SIGNAL(firstPaint()));
+    
+    // the test application has no widgets, i.e. the paint events are sent
+    // to a plain object
+    QObject widget;
+    widget.installEventFilter(&timer);
+    timer.mark("show");
+    
+    QVERIFY(! timer.hasFirstPaint());
+    QCOMPARE(timer.timeToFirstPaint(), qint64(-1));
+    
+    QEvent paintEvent(QEvent::Paint);
+    QCoreApplication::sendEvent(&widget, &paintEvent);
+    
+    QVERIFY(timer.hasFirstPaint());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(timer.phases().count(), 2);
+    QCOMPARE(timer.phases()[1].name, QString("first paint"));
+    QCOMPARE(timer.timeToFirstPaint(), timer.phases()[1].end);
+    
+    // further paint events are ignored
+    QCoreApplication::sendEvent(&widget, &paintEvent);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(timer.phases().count(), 2);
+}
+
+void StartupTimerTest::testModelStartupBudget()
+{
+    StartupTimer timer;
+    QUndoStack undoStack;
+    
+    // the main window constructs these models before it is shown
+    OperatorLibraryModel operatorLibrary;
+    timer.mark("operator library");
+    StreamModel stream(&undoStack, &operatorLibrary);
+    timer.mark("stream");
+    
+    foreach(const StartupTimer::Phase & phase, timer.phases())
+        qDebug() << phase.name << phase.duration << "ms";
+    
+    qint64 budget = modelStartupBudget();
+    QString message = QString("The startup budget of %1 ms is exceeded: %2 ms").arg(budget).arg(timer.elapsed());
+    QVERIFY2(timer.elapsed() < budget, message.toLocal8Bit().constData());
+}
@@ -1,19 +1,38 @@
 #include "test/StreamModelTest.h"
 
+#ifndef STROMX_STUDIO_QT4
+#include <QJsonArray>
+#include <QJsonDocument>
+#endif
+
 #include <QtTest/QtTest>
 #include <QUndoStack>
 #include <stromx/cvsupport/Cvsupport.h>
 #include <stromx/runtime/DirectoryFileInput.h>
 #include <stromx/runtime/Factory.h>
+#include <stromx/runtime/Operator.h>
+#include <stromx/runtime/OperatorInfo.h>
+#include <stromx/runtime/OperatorKernel.h>
+#include <stromx/runtime/Stream.h>
+#include <stromx/runtime/Thread.h>
 #include <stromx/runtime/ZipFileInput.h>
+#include <stromx/runtime/ZipFileOutput.h>
 
 #include "Exception.h"
+#include "MemoryFileOutput.h"
+#include "OperatorWatchdog.h"
+#include "data/InputData.h"
+#include "data/OperatorData.h"
+#include "model/ObserverModel.h"
+#include "model/ObserverTreeModel.h"
 #include "model/OperatorLibraryModel.h"
+#include "model/OperatorModel.h"
 #include "model/StreamModel.h"
 
 StreamModelTest::StreamModelTest()
   : m_undoStack(new QUndoStack(this)),
-    m_operatorLibraryModel(new OperatorLibraryModel(this))
+    m_operatorLibraryModel(new OperatorLibraryModel(this)),
+    m_largeModel(0)
 {
     try
     {
@@ -63,6 +82,558 @@ void StreamModelTest::testFileConstructorExtraParameter()
     }
 }
 
+void StreamModelTest::testStreamConstructorCamera()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    stromx::runtime::Stream* stream = StreamModel::readStream(input, "stream", m_operatorLibraryModel->factory());
+    QByteArray observerData = StreamModel::readFileContent(input, "views.json", false);
+    
+    StreamModel* model = new StreamModel(stream, m_undoStack, m_operatorLibraryModel, this);
+    model->readObserverData(observerData);
+    
+    QVERIFY(! observerData.isEmpty());
+    QVERIFY(! model->operators().isEmpty());
+}
+
+void StreamModelTest::testReadStreamDeferred()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    QList<DeferredParameters::Parameter> parameters;
+    stromx::runtime::Stream* stream = StreamModel::readStream(input, "stream", m_operatorLibraryModel->factory(),
+                                                              parameters);
+    
+    QCOMPARE(parameters.count(), 1);
+    QCOMPARE(parameters[0].operatorId, 2u);
+    QCOMPARE(parameters[0].file, QString("stream_op2_parameter1.png"));
+    
+    StreamModel* model = new StreamModel(stream, m_undoStack, m_operatorLibraryModel, this);
+    model->setDeferredParameters("camera.stromx", parameters);
+    QVERIFY(model->loadDeferredParameters());
+}
+
+void StreamModelTest::testReadStreamDeferredFailed()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    QList<DeferredParameters::Parameter> parameters;
+    stromx::runtime::Stream* stream = StreamModel::readStream(input, "stream", m_operatorLibraryModel->factory(),
+                                                              parameters);
+    
+    StreamModel* model = new StreamModel(stream, m_undoStack, m_operatorLibraryModel, this);
+    model->setDeferredParameters("missing.stromx", parameters);
+    
+    // the parameter remains deferred, i.e. loading fails again
+    QVERIFY(! model->loadDeferredParameters());
+    QVERIFY(! model->loadDeferredParameters());
+    
+    // the default value of the parameter is never written
+    MemoryFileOutput output;
+    try
+    {
+        model->write(output, "stream");
+        QFAIL("WriteStreamFailed not thrown");
+    }
+    catch(WriteStreamFailed &)
+    {
+    }
+    
+    // the stream is not started without its parameters
+    QVERIFY(! model->start());
+    QVERIFY(! model->isActive());
+}
+
+void StreamModelTest::testWriteDeferred()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    QList<DeferredParameters::Parameter> parameters;
+    stromx::runtime::Stream* stream = StreamModel::readStream(input, "stream", m_operatorLibraryModel->factory(),
+                                                              parameters);
+    
+    StreamModel* model = new StreamModel(stream, m_undoStack, m_operatorLibraryModel, this);
+    model->setDeferredParameters("camera.stromx", parameters);
+    
+    MemoryFileOutput snapshot;
+    model->write(snapshot, "stream");
+    
+    // the parameter is copied from the stream file without loading it
+    QVERIFY(model->hasDeferredParameters());
+    
+    // the file of the parameter is not read before the snapshot is written
+    QVERIFY(snapshot.hasFile("stream_op2_parameter1.png"));
+    QVERIFY(snapshot.content("stream_op2_parameter1.png").empty());
+    
+    {
+        stromx::runtime::ZipFileOutput output("deferred.stromx");
+        snapshot.writeTo(output);
+        output.close();
+    }
+    
+    // the written file contains the actual value of the parameter
+    stromx::runtime::ZipFileInput writtenInput("deferred.stromx");
+    QList<DeferredParameters::Parameter> writtenParameters;
+    stromx::runtime::Stream* writtenStream = StreamModel::readStream(writtenInput, "stream", 
+                                                                     m_operatorLibraryModel->factory(),
+                                                                     writtenParameters);
+    QCOMPARE(writtenParameters.count(), 1);
+    QCOMPARE(writtenParameters[0].file, parameters[0].file);
+    QCOMPARE(writtenParameters[0].text, parameters[0].text);
+    
+    StreamModel* writtenModel = new StreamModel(writtenStream, m_undoStack, m_operatorLibraryModel, this);
+    writtenModel->setDeferredParameters("deferred.stromx", writtenParameters);
+    QVERIFY(writtenModel->loadDeferredParameters());
+    
+    // the parameter can be loaded from the written file
+    model->setDeferredParametersFile("deferred.stromx", "stream");
+    QVERIFY(model->loadDeferredParameters());
+    QVERIFY(! model->hasDeferredParameters());
+}
+
+void StreamModelTest::testWriteSnapshot()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    StreamModel* model = new StreamModel(input, "stream", m_undoStack, m_operatorLibraryModel, this);
+    
+    MemoryFileOutput snapshot;
+    model->write(snapshot, "stream");
+    snapshot.close();
+    QVERIFY(snapshot.size() > 0);
+    
+    {
+        stromx::runtime::ZipFileOutput output("snapshot.stromx");
+        snapshot.writeTo(output);
+        output.close();
+    }
+    
+    // the files referenced by the stream must be found
+    stromx::runtime::ZipFileInput snapshotInput("snapshot.stromx");
+    StreamModel* snapshotModel = new StreamModel(snapshotInput, "stream", m_undoStack, m_operatorLibraryModel, this);
+    QCOMPARE(snapshotModel->operators().count(), model->operators().count());
+}
+
+void StreamModelTest::testStart()
+{
+    StreamModel model(m_undoStack, m_operatorLibraryModel);
+    QSignalSpy startedSpy(&model, SIGNAL(streamStarted()));
+    
+    QVERIFY(model.start());
+    QVERIFY(model.isStarting());
+    QVERIFY(model.isActive());
+    
+    for(int i = 0; i < 100 && startedSpy.count() == 0; ++i)
+        QTest::qWait(10);
+    
+    QCOMPARE(startedSpy.count(), 1);
+    QVERIFY(! model.isStarting());
+    QVERIFY(model.isActive());
+    
+    model.stop();
+    model.join();
+    QVERIFY(! model.isActive());
+}
+
+void StreamModelTest::testStartCancel()
+{
+    StreamModel model(m_undoStack, m_operatorLibraryModel);
+    QSignalSpy startedSpy(&model, SIGNAL(streamStarted()));
+    
+    QVERIFY(model.start());
+    QVERIFY(model.stop());
+    model.join();
+    
+    QCOMPARE(startedSpy.count(), 0);
+    QVERIFY(! model.isStarting());
+    QVERIFY(! model.isActive());
+}
 
+void StreamModelTest::testWatchdog()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    StreamModel model(input, "stream", m_undoStack, m_operatorLibraryModel);
+    QSignalSpy startedSpy(&model, SIGNAL(streamStarted()));
+    QSignalSpy checkedSpy(model.watchdog(), SIGNAL(checked()));
+    
+    QVERIFY(model.start());
+    for(int i = 0; i < 100 && startedSpy.count() == 0; ++i)
+        QTest::qWait(10);
+    
+    // no operator exceeds the default threshold right after the start
+    model.watchdog()->check();
+    QCOMPARE(checkedSpy.count(), 1);
+    foreach(OperatorModel* op, model.operators())
+        QVERIFY(! op->isHung());
+    
+    model.stop();
+    model.join();
+    for(int i = 0; i < 100 && model.isActive(); ++i)
+        QTest::qWait(10);
+    
+    foreach(OperatorModel* op, model.operators())
+        QVERIFY(! op->isHung());
+}
 
+void StreamModelTest::testWatchdogThreshold()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    StreamModel model(input, "stream", m_undoStack, m_operatorLibraryModel);
+    QSignalSpy startedSpy(&model, SIGNAL(streamStarted()));
+    
+    OperatorModel* camera = 0;
+    foreach(OperatorModel* op, model.operators())
+    {
+        if(op->type() == "DummyCamera")
+            camera = op;
+    }
+    QVERIFY(camera);
+    
+    QVERIFY(model.start());
+    for(int i = 0; i < 100 && startedSpy.count() == 0; ++i)
+        QTest::qWait(10);
+    
+    // the camera spends most of the time waiting for the next frame, i.e. it
+    // executes without any connector change
+    model.watchdog()->setThreshold(0);
+    for(int i = 0; i < 100 && ! camera->isHung(); ++i)
+    {
+        QTest::qWait(10);
+        model.watchdog()->check();
+    }
+    QVERIFY(camera->isHung());
+    
+    // the state is reset when the stream is paused
+    QVERIFY(model.pause());
+    QVERIFY(! camera->isHung());
+    
+    model.stop();
+    model.join();
+    for(int i = 0; i < 100 && model.isActive(); ++i)
+        QTest::qWait(10);
+}
 
+void StreamModelTest::testWatchdogDisabled()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    StreamModel model(input, "stream", m_undoStack, m_operatorLibraryModel);
+    QSignalSpy startedSpy(&model, SIGNAL(streamStarted()));
+    
+    model.watchdog()->setEnabled(false);
+    model.watchdog()->setThreshold(0);
+    QVERIFY(model.start());
+    for(int i = 0; i < 100 && startedSpy.count() == 0; ++i)
+        QTest::qWait(10);
+    QTest::qWait(100);
+    
+    // no connector activity is recorded, i.e. no operator is reported
+    model.watchdog()->check();
+    foreach(OperatorModel* op, model.operators())
+    {
+        QVERIFY(! op->isHung());
+        QVERIFY(op->threadPositions().isEmpty());
+    }
+    
+    model.stop();
+    model.join();
+    for(int i = 0; i < 100 && model.isActive(); ++i)
+        QTest::qWait(10);
+}
+
+void StreamModelTest::testCaptureAddedInput()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    StreamModel model(input, "stream", m_undoStack, m_operatorLibraryModel);
+    
+    OperatorModel* op = 0;
+    foreach(OperatorModel* candidate, model.operators())
+    {
+        if(candidate->isInitialized() && candidate->op()->info().inputs().size() > 0)
+            op = candidate;
+    }
+    QVERIFY(op);
+    
+    ObserverTreeModel* observers = model.observerModel();
+    observers->insertRows(0, 1);
+    model.startCapture("added_input.capture");
+    QVERIFY(! op->hasCaptureChannel(0));
+    
+    // the input is captured as soon as it is observed
+    InputData inputData(op, 0);
+    observers->dropMimeData(&inputData, Qt::CopyAction, 0, 0, observers->observerIndex(0));
+    QVERIFY(op->hasCaptureChannel(0));
+    
+    model.stopCapture();
+    QVERIFY(! op->hasCaptureChannel(0));
+    QFile::remove("added_input.capture");
+}
+
+void StreamModelTest::testInitializeOperators()
+{
+    QUndoStack undoStack;
+    StreamModel model(&undoStack, m_operatorLibraryModel);
+    for(int i = 0; i < 10; ++i)
+    {
+        OperatorData data("runtime", "Dump");
+        model.addOperator(&data, QPointF(100 * i, 0));
+    }
+    int index = undoStack.index();
+    
+    OperatorModel* first = model.operators()[0];
+    QSignalSpy aboutToBeReset(first, SIGNAL(modelAboutToBeReset()));
+    QSignalSpy reset(first, SIGNAL(modelReset()));
+    
+    model.initializeOperators(model.operators());
+    QVERIFY(model.isInitializing());
+    foreach(OperatorModel* op, model.operators())
+        QVERIFY(op->isPending());
+    
+    // the model is not reset while the operators are initialized
+    QCOMPARE(aboutToBeReset.count(), 1);
+    QCOMPARE(reset.count(), 1);
+    
+    // the command is pushed when the initialization starts
+    QCOMPARE(undoStack.index(), index + 1);
+    
+    model.waitForInitialization();
+    QVERIFY(! model.isInitializing());
+    foreach(OperatorModel* op, model.operators())
+    {
+        QVERIFY(! op->isPending());
+        QVERIFY(op->isInitialized());
+    }
+    QCOMPARE(aboutToBeReset.count(), 2);
+    QCOMPARE(reset.count(), 2);
+    
+    // all operators are initialized by a single command
+    QCOMPARE(undoStack.index(), index + 1);
+    undoStack.undo();
+    foreach(OperatorModel* op, model.operators())
+        QVERIFY(! op->isInitialized());
+}
+
+void StreamModelTest::testStudioDataRoundTrip()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    StreamModel* model = new StreamModel(input, "stream", m_undoStack, m_operatorLibraryModel, this);
+    model->readObserverData(input);
+    QByteArray data = model->studioData();
+    
+    StreamModel* readModel = new StreamModel(input, "stream", m_undoStack, m_operatorLibraryModel, this);
+    readModel->readStudioData(data);
+    
+    QCOMPARE(readModel->observerModel()->observers().count(), model->observerModel()->observers().count());
+    for(int i = 0; i < model->observerModel()->observers().count(); ++i)
+    {
+        ObserverModel* observer = model->observerModel()->observers()[i];
+        ObserverModel* readObserver = readModel->observerModel()->observers()[i];
+        QCOMPARE(readObserver->name(), observer->name());
+        QCOMPARE(readObserver->numInputs(), observer->numInputs());
+    }
+}
+
+void StreamModelTest::benchmarkTakeSnapshot()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    StreamModel* model = new StreamModel(input, "stream", m_undoStack, m_operatorLibraryModel, this);
+    
+    // the part of writing a file which runs on the GUI thread
+    QBENCHMARK
+    {
+        MemoryFileOutput snapshot;
+        model->write(snapshot, "stream");
+        snapshot.close();
+    }
+}
+
+void StreamModelTest::benchmarkWriteSnapshot()
+{
+    stromx::runtime::ZipFileInput input("camera.stromx");
+    StreamModel* model = new StreamModel(input, "stream", m_undoStack, m_operatorLibraryModel, this);
+    
+    MemoryFileOutput snapshot;
+    model->write(snapshot, "stream");
+    snapshot.close();
+    
+    // the part of writing a file which runs on the write stream task
+    QBENCHMARK
+    {
+        stromx::runtime::ZipFileOutput output("snapshot.stromx");
+        snapshot.writeTo(output);
+        output.close();
+    }
+}
+
+void StreamModelTest::benchmarkWriteStudioData()
+{
+    StreamModel* model = largeModel();
+    
+    QBENCHMARK
+    {
+        model->studioData();
+    }
+}
+
+void StreamModelTest::benchmarkWriteStudioDataVersion2()
+{
+    StreamModel* model = largeModel();
+    
+    QBENCHMARK
+    {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_4_7);
+        stream << model->observerModel();
+    }
+}
+
+void StreamModelTest::benchmarkWriteViewsJson()
+{
+#ifndef STROMX_STUDIO_QT4
+    StreamModel* model = largeModel();
+    
+    QBENCHMARK
+    {
+        QJsonArray views;
+        model->observerModel()->write(views);
+        QJsonDocument(views).toJson(QJsonDocument::Compact);
+    }
+#else
+    QSKIP("JSON is not supported by Qt 4", SkipAll);
+#endif
+}
+
+void StreamModelTest::benchmarkReadStudioData()
+{
+    StreamModel* model = largeModel();
+    QByteArray data = model->studioData();
+    
+    // the operators of the stream are not part of the studio data
+    StreamModel* readModel = copyOperators(model);
+    
+    // reading the data again would append the observers a second time
+    QBENCHMARK_ONCE
+    {
+        readModel->readStudioData(data);
+    }
+    
+    QCOMPARE(readModel->observerModel()->observers().count(), 10);
+}
+
+void StreamModelTest::benchmarkReadStudioDataVersion2()
+{
+    StreamModel* model = largeModel();
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_4_7);
+        stream << model->observerModel();
+    }
+    
+    StreamModel* readModel = copyOperators(model);
+    
+    QBENCHMARK_ONCE
+    {
+        QDataStream stream(data);
+        stream.setVersion(QDataStream::Qt_4_7);
+        stream >> readModel->observerModel();
+    }
+    
+    QCOMPARE(readModel->observerModel()->observers().count(), 10);
+}
+
+void StreamModelTest::benchmarkReadViewsJson()
+{
+#ifndef STROMX_STUDIO_QT4
+    StreamModel* model = largeModel();
+    QJsonArray views;
+    model->observerModel()->write(views);
+    QByteArray data = QJsonDocument(views).toJson(QJsonDocument::Compact);
+    
+    StreamModel* readModel = copyOperators(model);
+    
+    QBENCHMARK_ONCE
+    {
+        readModel->readObserverData(data);
+    }
+    
+    QCOMPARE(readModel->observerModel()->observers().count(), 10);
+#else
+    QSKIP("JSON is not supported by Qt 4", SkipAll);
+#endif
+}
+
+void StreamModelTest::benchmarkAllocateObjects_data()
+{
+    QTest::addColumn<int>("numOperators");
+    
+    QTest::newRow("10 operators") << 10;
+    QTest::newRow("100 operators") << 100;
+    QTest::newRow("1000 operators") << 1000;
+    QTest::newRow("5000 operators") << 5000;
+}
+
+void StreamModelTest::benchmarkAllocateObjects()
+{
+    QFETCH(int, numOperators);
+    
+    // a chain of connected operators whose inputs are all processed by one thread
+    stromx::runtime::Stream* stream = new stromx::runtime::Stream;
+    stromx::runtime::Thread* thread = stream->addThread();
+    stromx::runtime::Operator* previous = 0;
+    for(int i = 0; i < numOperators; ++i)
+    {
+        stromx::runtime::OperatorKernel* kernel = m_operatorLibraryModel->factory()->newOperator("runtime", "PeriodicDelay");
+        stromx::runtime::Operator* op = stream->addOperator(kernel);
+        stream->initializeOperator(op);
+        
+        if(previous)
+        {
+            stream->connect(previous, 0, op, 0);
+            thread->addInput(op, 0);
+        }
+        previous = op;
+    }
+    
+    StreamModel* model = 0;
+    QBENCHMARK_ONCE
+    {
+        model = new StreamModel(stream, m_undoStack, m_operatorLibraryModel, this);
+    }
+    
+    QCOMPARE(model->operators().count(), numOperators);
+    QCOMPARE(model->connections().count(), numOperators - 1);
+    delete model;
+}
+
+StreamModel* StreamModelTest::largeModel()
+{
+    if(m_largeModel)
+        return m_largeModel;
+    
+    m_largeModel = new StreamModel(m_undoStack, m_operatorLibraryModel, this);
+    
+    OperatorData dumpData("runtime", "Dump");
+    for(int i = 0; i < 1000; ++i)
+        m_largeModel->addOperator(&dumpData, QPointF(i, i));
+    
+    ObserverTreeModel* observers = m_largeModel->observerModel();
+    for(int i = 0; i < 10; ++i)
+    {
+        observers->insertRows(i, 1);
+        for(int j = 0; j < 100; ++j)
+        {
+            InputData inputData(m_largeModel->operators()[100 * i + j], 0);
+            observers->dropMimeData(&inputData, Qt::CopyAction, j, 0, observers->observerIndex(i));
+        }
+    }
+    
+    return m_largeModel;
+}
+
+StreamModel* StreamModelTest::copyOperators(StreamModel* model)
+{
+    StreamModel* copy = new StreamModel(m_undoStack, m_operatorLibraryModel, this);
+    foreach(OperatorModel* op, model->operators())
+    {
+        OperatorData opData(op->package(), op->type());
+        copy->addOperator(&opData, QPointF());
+    }
+    
+    return copy;
+}
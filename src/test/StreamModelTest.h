@@ -24,6 +24,7 @@
 
 class QUndoStack;
 class OperatorLibraryModel;
+class StreamModel;
 
 class StreamModelTest : public QObject
 {
@@ -37,10 +38,47 @@ private slots:
     void testFileConstructorCamera();
     void testFileConstructorConnector();
     void testFileConstructorExtraParameter();
+    void testStreamConstructorCamera();
+    void testReadStreamDeferred();
+    void testReadStreamDeferredFailed();
+    void testWriteDeferred();
+    void testWriteSnapshot();
+    void testStudioDataRoundTrip();
+    void testStart();
+    void testStartCancel();
+    void testWatchdog();
+    void testWatchdogThreshold();
+    void testWatchdogDisabled();
+    void testCaptureAddedInput();
+    void testInitializeOperators();
+    void benchmarkTakeSnapshot();
+    void benchmarkWriteSnapshot();
+    void benchmarkWriteStudioData();
+    void benchmarkWriteStudioDataVersion2();
+    void benchmarkWriteViewsJson();
+    void benchmarkReadStudioData();
+    void benchmarkReadStudioDataVersion2();
+    void benchmarkReadViewsJson();
+    void benchmarkAllocateObjects_data();
+    void benchmarkAllocateObjects();
     
 private:
+    /** 
+     * Returns a stream model with 1000 operators and 10 observers which observe 
+     * 100 inputs each. The model is constructed when the function is called for
+     * the first time.
+     */
+    StreamModel* largeModel();
+    
+    /** 
+     * Returns a new stream model with the same operators as \c model but without
+     * any observers.
+     */
+    StreamModel* copyOperators(StreamModel* model);
+    
     QUndoStack* m_undoStack;
     OperatorLibraryModel* m_operatorLibraryModel;
+    StreamModel* m_largeModel;
 };
 
 #endif // STREAMMODELTEST_H
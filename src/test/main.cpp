@@ -1,22 +1,56 @@
 #include <QtTest/QtTest>
 
+#include "test/CaptureTest.h"
 #include "test/DataConverterTest.h"
+#include "test/DataRouterTest.h"
+#include "test/ErrorListModelTest.h"
+#include "test/FrameHistoryTest.h"
 #include "test/ImageTest.h"
+#include "test/LimitUndoStackTest.h"
+#include "test/MatrixModelTest.h"
+#include "test/MatrixTest.h"
+#include "test/ObserverModelTest.h"
 #include "test/ObserverSchedulerTest.h"
 #include "test/OperatorLibraryModelTest.h"
 #include "test/ParameterServerTest.h"
+#include "test/RenderCacheTest.h"
+#include "test/StartupTimerTest.h"
 #include "test/StreamModelTest.h"
 
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
     
+    CaptureTest capture;
+    QTest::qExec(&capture, argc, argv);
+    
     DataConverterTest dataConverter;
     QTest::qExec(&dataConverter, argc, argv);
     
+    DataRouterTest dataRouter;
+    QTest::qExec(&dataRouter, argc, argv);
+    
+    ErrorListModelTest errorListModel;
+    QTest::qExec(&errorListModel, argc, argv);
+    
+    FrameHistoryTest frameHistory;
+    QTest::qExec(&frameHistory, argc, argv);
+    
     ImageTest image;
     QTest::qExec(&image, argc, argv);
     
+    LimitUndoStackTest limitUndoStack;
+    QTest::qExec(&limitUndoStack, argc, argv);
+    
+    MatrixModelTest matrixModel;
+    QTest::qExec(&matrixModel, argc, argv);
+    
+    MatrixTest matrix;
+    QTest::qExec(&matrix, argc, argv);
+    
+    ObserverModelTest observerModel;
+    QTest::qExec(&observerModel, argc, argv);
+    
     ObserverSchedulerTest observerScheduler;
     QTest::qExec(&observerScheduler, argc, argv);
     
@@ -26,6 +60,12 @@ int main(int argc, char *argv[])
     ParameterServerTest parameterServer;
     QTest::qExec(&parameterServer, argc, argv);
     
+    RenderCacheTest renderCache;
+    QTest::qExec(&renderCache, argc, argv);
+    
+    StartupTimerTest startupTimer;
+    QTest::qExec(&startupTimer, argc, argv);
+    
     StreamModelTest streamModel;
     QTest::qExec(&streamModel, argc, argv);
 }
\ No newline at end of file
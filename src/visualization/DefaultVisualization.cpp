@@ -10,6 +10,7 @@
 #include <QPen>
 
 #include "Common.h"
+#include "VariantTable.h"
 #include "visualization/ColorChooser.h"
 
 namespace
@@ -55,22 +56,16 @@ QList< QGraphicsItem* > DefaultVisualization::createItems(const stromx::runtime:
 {
     using namespace stromx::runtime;
     
-    QList<QGraphicsItem*> items;
+    static const VariantTable<CreateItemsFunction> FUNCTIONS = VariantTable<CreateItemsFunction>()
+        .add(Variant::IMAGE, &createImageItems)
+        .add(Variant::PRIMITIVE, &createPrimitiveItems)
+        .add(Variant::STRING, &createStringItems);
     
-    if(data.isVariant(Variant::IMAGE))
-    {
-        items = createImageItems(data, properties);
-    }
-    else if(data.isVariant(Variant::PRIMITIVE))
-    {
-        items = createPrimitiveItems(data, properties);
-    } 
-    else if(data.isVariant(Variant::STRING))
-    {
-        items = createStringItems(data, properties);
-    }
-    
-    return items;
+    CreateItemsFunction function = FUNCTIONS.lookup(data);
+    if(function)
+        return function(data, properties);
+    else
+        return QList<QGraphicsItem*>();
 }
 
 QList<QGraphicsItem*> DefaultVisualization::createImageItems(const stromx::runtime::Data& data,
@@ -203,24 +198,20 @@ QList<QGraphicsItem*> DefaultVisualization::createPrimitiveItems(const stromx::r
 {    
     using namespace stromx::runtime;
     
-    if(data.isVariant(Variant::BOOL))
-        return createPrimitiveItemsTemplate<Bool>(data, properties);
-    else if(data.isVariant(Variant::INT_8))
-        return createPrimitiveItemsTemplate<Int8>(data, properties);
-    else if(data.isVariant(Variant::UINT_8))
-        return createPrimitiveItemsTemplate<UInt8>(data, properties);
-    else if(data.isVariant(Variant::INT_16))
-        return createPrimitiveItemsTemplate<Int16>(data, properties);
-    else if(data.isVariant(Variant::UINT_16))
-        return createPrimitiveItemsTemplate<UInt16>(data, properties);
-    else if(data.isVariant(Variant::INT_32))
-        return createPrimitiveItemsTemplate<Int32>(data, properties);
-    else if(data.isVariant(Variant::UINT_32))
-        return createPrimitiveItemsTemplate<UInt32>(data, properties);
-    else if(data.isVariant(Variant::FLOAT_32))
-        return createPrimitiveItemsTemplate<Float32>(data, properties);
-    else if(data.isVariant(Variant::FLOAT_64))
-        return createPrimitiveItemsTemplate<Float64>(data, properties);
+    static const VariantTable<CreateItemsFunction> FUNCTIONS = VariantTable<CreateItemsFunction>()
+        .add(Variant::BOOL, &createPrimitiveItemsTemplate<Bool>)
+        .add(Variant::INT_8, &createPrimitiveItemsTemplate<Int8>)
+        .add(Variant::UINT_8, &createPrimitiveItemsTemplate<UInt8>)
+        .add(Variant::INT_16, &createPrimitiveItemsTemplate<Int16>)
+        .add(Variant::UINT_16, &createPrimitiveItemsTemplate<UInt16>)
+        .add(Variant::INT_32, &createPrimitiveItemsTemplate<Int32>)
+        .add(Variant::UINT_32, &createPrimitiveItemsTemplate<UInt32>)
+        .add(Variant::FLOAT_32, &createPrimitiveItemsTemplate<Float32>)
+        .add(Variant::FLOAT_64, &createPrimitiveItemsTemplate<Float64>);
+    
+    CreateItemsFunction function = FUNCTIONS.lookup(data);
+    if(function)
+        return function(data, properties);
     else
         return QList<QGraphicsItem*>();
 }
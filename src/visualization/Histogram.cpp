@@ -8,74 +8,78 @@
 #include <QPen>
 
 #include "Common.h"
+#include "VariantTable.h"
 #include "visualization/ColorChooser.h"
 
 namespace
 {
     template <class data_t>
-    QList< QGraphicsItem* > createHistogramItemsTemplate(const stromx::runtime::Data& data,
-        const VisualizationState::Properties & properties)
+    struct HistogramItems
     {
-        const int WIDTH = 400;
-        const int HEIGHT = 400;
-        
-        using namespace stromx::runtime;
-        QVariant colorVariant = properties.value("color", Colors::DEFAULT);
-        QColor color = colorVariant.value<QColor>();
-        
-        QList<QGraphicsItem*> items;
-        try
+        static QList< QGraphicsItem* > create(const stromx::runtime::Data& data,
+            const VisualizationState::Properties & properties)
         {
-            // cast the data to a matrix
-            const Matrix & matrix = data_cast<Matrix>(data);
+            const int WIDTH = 400;
+            const int HEIGHT = 400;
             
-            if(! (matrix.valueSize() == sizeof(data_t) && matrix.cols() == 1))
-                return items;
+            using namespace stromx::runtime;
+            QVariant colorVariant = properties.value("color", Colors::DEFAULT);
+            QColor color = colorVariant.value<QColor>();
             
-            data_t maximum = 0;
-            const uint8_t* rowPtr = matrix.data();
-            for(unsigned int i = 0; i < matrix.rows(); ++i)
+            QList<QGraphicsItem*> items;
+            try
             {
-                const data_t* rowData = reinterpret_cast<const data_t*>(rowPtr);
-                for(unsigned int j = 0; j < matrix.cols(); ++j)
+                // cast the data to a matrix
+                const Matrix & matrix = data_cast<Matrix>(data);
+                
+                if(! (matrix.valueSize() == sizeof(data_t) && matrix.cols() == 1))
+                    return items;
+                
+                data_t maximum = 0;
+                const uint8_t* rowPtr = matrix.data();
+                for(unsigned int i = 0; i < matrix.rows(); ++i)
                 {
-                    data_t currentValue = rowData[j];
-                    if(i==0 && j==0)
-                    {
-                        //Initialization of min and max with first matrix entry
-                        maximum = currentValue;
-                    }
-                    else
+                    const data_t* rowData = reinterpret_cast<const data_t*>(rowPtr);
+                    for(unsigned int j = 0; j < matrix.cols(); ++j)
                     {
-                        //Update maximum
-                        if(currentValue > maximum)
+                        data_t currentValue = rowData[j];
+                        if(i==0 && j==0)
                         {
+                            //Initialization of min and max with first matrix entry
                             maximum = currentValue;
                         }
+                        else
+                        {
+                            //Update maximum
+                            if(currentValue > maximum)
+                            {
+                                maximum = currentValue;
+                            }
+                        }
                     }
+                    rowPtr += matrix.stride();
+                }
+                
+                for(unsigned int i = 0; i < matrix.rows(); ++i)
+                {
+                    float binWidth = static_cast<float>(WIDTH) / matrix.rows();
+                    float binHeight = static_cast<float>(HEIGHT) / maximum * matrix.at<data_t>(i, 0);
+                    float x = binWidth * i;
+                    float y = HEIGHT - binHeight;
+                    
+                    QGraphicsRectItem* rect = new QGraphicsRectItem(x, y, binWidth, binHeight);
+                    rect->setPen(QPen(color));
+                    rect->setBrush(QBrush(Qt::NoBrush));
+                    items.append(rect);
                 }
-                rowPtr += matrix.stride();
             }
-            
-            for(unsigned int i = 0; i < matrix.rows(); ++i)
+            catch(BadCast&)
             {
-                float binWidth = static_cast<float>(WIDTH) / matrix.rows();
-                float binHeight = static_cast<float>(HEIGHT) / maximum * matrix.at<data_t>(i, 0);
-                float x = binWidth * i;
-                float y = HEIGHT - binHeight;
-                
-                QGraphicsRectItem* rect = new QGraphicsRectItem(x, y, binWidth, binHeight);
-                rect->setPen(QPen(color));
-                rect->setBrush(QBrush(Qt::NoBrush));
-                items.append(rect);
             }
+            
+            return items;
         }
-        catch(BadCast&)
-        {
-        }
-        
-        return items;
-    }
+    };
 }
 
 VisualizationWidget* Histogram::createEditor() const
@@ -88,22 +92,12 @@ QList< QGraphicsItem* > Histogram::createItems(const stromx::runtime::Data & dat
 {
     using namespace stromx::runtime;
     
-    if(data.isVariant(Variant::INT_8_MATRIX))
-        return createHistogramItemsTemplate<int8_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_8_MATRIX))
-        return createHistogramItemsTemplate<uint8_t>(data, properties);
-    else if(data.isVariant(Variant::INT_16_MATRIX))
-        return createHistogramItemsTemplate<int16_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_16_MATRIX))
-        return createHistogramItemsTemplate<uint16_t>(data, properties);
-    else if(data.isVariant(Variant::INT_32_MATRIX))
-        return createHistogramItemsTemplate<int32_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_32_MATRIX))
-        return createHistogramItemsTemplate<uint32_t>(data, properties);
-    else if(data.isVariant(Variant::FLOAT_32_MATRIX))
-        return createHistogramItemsTemplate<float>(data, properties);
-    else if(data.isVariant(Variant::FLOAT_64_MATRIX))
-        return createHistogramItemsTemplate<double>(data, properties);
+    if(! data.isVariant(Variant::MATRIX))
+        return QList<QGraphicsItem*>();
+    
+    CreateItemsFunction function = matrixInstanceTable<CreateItemsFunction, HistogramItems>().lookup(data_cast<Matrix>(data));
+    if(function)
+        return function(data, properties);
     else
         return QList<QGraphicsItem*>();
 }
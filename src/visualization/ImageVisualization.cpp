@@ -8,96 +8,101 @@
 #include <QGraphicsLineItem>
 #include <QPen>
 
+#include "VariantTable.h"
+
 namespace
 {
-template <class data_t>
-    QList< QGraphicsItem* > createImageFromMatrixTemplate(const stromx::runtime::Data& data,
-                                                          const VisualizationState::Properties & /*properties*/)
+    template <class data_t>
+    struct MatrixImageItems
     {
-        using namespace stromx::runtime;
-        
-        QList<QGraphicsItem*> items;
-        try
+        static QList< QGraphicsItem* > create(const stromx::runtime::Data& data,
+                                              const VisualizationState::Properties & /*properties*/)
         {
-            // cast the data to a matrix
-            const Matrix & matrix = data_cast<Matrix>(data);
+            using namespace stromx::runtime;
             
-            // check if the value size of the matrix matches the size of the template
-            // parameter
-            data_t maximum = 0;
-            data_t minimum = 0;
-            if(matrix.valueSize() == sizeof(data_t))
+            QList<QGraphicsItem*> items;
+            try
             {
-                // loop over the rows of the matrix and search for maximum value
-                const uint8_t* rowPtr = matrix.data();
-                for(unsigned int i = 0; i < matrix.rows(); ++i)
+                // cast the data to a matrix
+                const Matrix & matrix = data_cast<Matrix>(data);
+                
+                // check if the value size of the matrix matches the size of the template
+                // parameter
+                data_t maximum = 0;
+                data_t minimum = 0;
+                if(matrix.valueSize() == sizeof(data_t))
                 {
-                    const data_t* rowData = reinterpret_cast<const data_t*>(rowPtr);
-                    for(unsigned int j = 0; j < matrix.cols(); ++j)
+                    // loop over the rows of the matrix and search for maximum value
+                    const uint8_t* rowPtr = matrix.data();
+                    for(unsigned int i = 0; i < matrix.rows(); ++i)
                     {
-                        data_t currentValue = rowData[j];
-                        if(i==0 && j==0)
-                        {
-                            //Initialization of min and max with first matrix entry
-                            maximum = currentValue;
-                            minimum = currentValue;
-                        }
-                        else
+                        const data_t* rowData = reinterpret_cast<const data_t*>(rowPtr);
+                        for(unsigned int j = 0; j < matrix.cols(); ++j)
                         {
-                            //Update maximum
-                            if(currentValue > maximum)
+                            data_t currentValue = rowData[j];
+                            if(i==0 && j==0)
                             {
+                                //Initialization of min and max with first matrix entry
                                 maximum = currentValue;
+                                minimum = currentValue;
                             }
                             else
                             {
-                                if(currentValue < minimum)
+                                //Update maximum
+                                if(currentValue > maximum)
+                                {
+                                    maximum = currentValue;
+                                }
+                                else
                                 {
-                                    //Update minimum
-                                    minimum = currentValue;
+                                    if(currentValue < minimum)
+                                    {
+                                        //Update minimum
+                                        minimum = currentValue;
+                                    }
                                 }
                             }
                         }
+                        rowPtr += matrix.stride();
                     }
-                    rowPtr += matrix.stride();
-                }
-                
-                data_t range = maximum - minimum;
-           
-                //loop over the rows of the matrix and re-scale each entry such that
-                //the determined maximum value becomes 255 (uchar) and store it in
-                //grey-scale QT image
-                QImage qtImage = QImage(matrix.cols(), matrix.rows(), QImage::Format_Indexed8);
-                
-                QVector<QRgb> colorTable(256);
-                for(unsigned int i = 0; i < 256; ++i)
-                    colorTable[i] = qRgb(i, i, i);
-                qtImage.setColorTable(colorTable);
-                
-                const uint8_t* rowPtrSrc = matrix.data();
-                for(unsigned int i = 0; i < matrix.rows(); ++i)
-                {
-                    const data_t* pixelPtrSrc = reinterpret_cast<const data_t*>(rowPtrSrc);
-                    uchar* pixelPtrDst = qtImage.scanLine(i);
-                    for(unsigned int j = 0; j < matrix.cols(); ++j)
+                    
+                    data_t range = maximum - minimum;
+               
+                    //loop over the rows of the matrix and re-scale each entry such that
+                    //the determined maximum value becomes 255 (uchar) and store it in
+                    //grey-scale QT image
+                    QImage qtImage = QImage(matrix.cols(), matrix.rows(), QImage::Format_Indexed8);
+                    
+                    QVector<QRgb> colorTable(256);
+                    for(unsigned int i = 0; i < 256; ++i)
+                        colorTable[i] = qRgb(i, i, i);
+                    qtImage.setColorTable(colorTable);
+                    
+                    const uint8_t* rowPtrSrc = matrix.data();
+                    for(unsigned int i = 0; i < matrix.rows(); ++i)
                     {
-                        //Caution: cast to double necessary to prevent integer arithmetic in case of data_t being a int or uint variant
-                        pixelPtrDst[j] = static_cast<uchar>(qFloor((static_cast<double>(*pixelPtrSrc) - static_cast<double>(minimum))/static_cast<double>(range) * 255.0));
-                        ++pixelPtrSrc;
+                        const data_t* pixelPtrSrc = reinterpret_cast<const data_t*>(rowPtrSrc);
+                        uchar* pixelPtrDst = qtImage.scanLine(i);
+                        for(unsigned int j = 0; j < matrix.cols(); ++j)
+                        {
+                            //Caution: cast to double necessary to prevent integer arithmetic in case of data_t being a int or uint variant
+                            pixelPtrDst[j] = static_cast<uchar>(qFloor((static_cast<double>(*pixelPtrSrc) - static_cast<double>(minimum))/static_cast<double>(range) * 255.0));
+                            ++pixelPtrSrc;
+                        }
+                        rowPtrSrc += matrix.stride();
                     }
-                    rowPtrSrc += matrix.stride();
+                    
+                    QPixmap pixmap = QPixmap::fromImage(qtImage);
+                    items.append(new QGraphicsPixmapItem(pixmap));
                 }
-                
-                QPixmap pixmap = QPixmap::fromImage(qtImage);
-                items.append(new QGraphicsPixmapItem(pixmap));
             }
+            catch(BadCast&)
+            {
+            }
+            
+            return items;
         }
-        catch(BadCast&)
-        {
-        }
-        
-        return items;
-    }
+    };
 }
 
 VisualizationWidget* ImageVisualization::createEditor() const
@@ -110,22 +115,12 @@ QList< QGraphicsItem* > ImageVisualization::createItems(const stromx::runtime::D
 {
     using namespace stromx::runtime;
     
-    if(data.isVariant(Variant::INT_8_MATRIX))
-        return createImageFromMatrixTemplate<int8_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_8_MATRIX))
-        return createImageFromMatrixTemplate<uint8_t>(data, properties);
-    else if(data.isVariant(Variant::INT_16_MATRIX))
-        return createImageFromMatrixTemplate<int16_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_16_MATRIX))
-        return createImageFromMatrixTemplate<uint16_t>(data, properties);
-    else if(data.isVariant(Variant::INT_32_MATRIX))
-        return createImageFromMatrixTemplate<int32_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_32_MATRIX))
-        return createImageFromMatrixTemplate<uint32_t>(data, properties);
-    else if(data.isVariant(Variant::FLOAT_32_MATRIX))
-        return createImageFromMatrixTemplate<float>(data, properties);
-    else if(data.isVariant(Variant::FLOAT_64_MATRIX))
-        return createImageFromMatrixTemplate<double>(data, properties);
+    if(! data.isVariant(Variant::MATRIX))
+        return QList<QGraphicsItem*>();
+    
+    CreateItemsFunction function = matrixInstanceTable<CreateItemsFunction, MatrixImageItems>().lookup(data_cast<Matrix>(data));
+    if(function)
+        return function(data, properties);
     else
         return QList<QGraphicsItem*>();
 }
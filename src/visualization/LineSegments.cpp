@@ -8,49 +8,53 @@
 #include <QPen>
 
 #include "Common.h"
+#include "VariantTable.h"
 #include "visualization/ColorChooser.h"
 
 namespace
 {
     template <class data_t>
-    QList< QGraphicsItem* > createLineSegmentItemsTemplate(const stromx::runtime::Data& data, 
-        const VisualizationState::Properties & properties)
+    struct LineSegmentItems
     {
-        using namespace stromx::runtime;
-        QVariant colorVariant = properties.value("color", Colors::DEFAULT);
-        QColor color = colorVariant.value<QColor>();
-        
-        QList<QGraphicsItem*> items;
-        try
+        static QList< QGraphicsItem* > create(const stromx::runtime::Data& data, 
+            const VisualizationState::Properties & properties)
         {
-            // cast the data to a matrix
-            const Matrix & matrix = data_cast<Matrix>(data);
+            using namespace stromx::runtime;
+            QVariant colorVariant = properties.value("color", Colors::DEFAULT);
+            QColor color = colorVariant.value<QColor>();
             
-            // check if the value size of the matrix matches the size of the template
-            // parameter and make sure the matrix has 4 columns
-            if(matrix.valueSize() == sizeof(data_t) && matrix.cols() == 4)
+            QList<QGraphicsItem*> items;
+            try
             {
-                // loop over the rows of the matrix and construct a line item from each row
-                const uint8_t* rowPtr = matrix.data();
-                for(unsigned int i = 0; i < matrix.rows(); ++i)
+                // cast the data to a matrix
+                const Matrix & matrix = data_cast<Matrix>(data);
+                
+                // check if the value size of the matrix matches the size of the template
+                // parameter and make sure the matrix has 4 columns
+                if(matrix.valueSize() == sizeof(data_t) && matrix.cols() == 4)
                 {
-                    const data_t* rowData = reinterpret_cast<const data_t*>(rowPtr);
-                    QGraphicsLineItem* lineItem = 
-                        new QGraphicsLineItem(rowData[0], rowData[1], rowData[2], rowData[3]);
-                    QPen pen = lineItem->pen();
-                    pen.setColor(color);
-                    lineItem->setPen(pen);
-                    items.append(lineItem);
-                    rowPtr += matrix.stride();
+                    // loop over the rows of the matrix and construct a line item from each row
+                    const uint8_t* rowPtr = matrix.data();
+                    for(unsigned int i = 0; i < matrix.rows(); ++i)
+                    {
+                        const data_t* rowData = reinterpret_cast<const data_t*>(rowPtr);
+                        QGraphicsLineItem* lineItem = 
+                            new QGraphicsLineItem(rowData[0], rowData[1], rowData[2], rowData[3]);
+                        QPen pen = lineItem->pen();
+                        pen.setColor(color);
+                        lineItem->setPen(pen);
+                        items.append(lineItem);
+                        rowPtr += matrix.stride();
+                    }
                 }
             }
+            catch(BadCast&)
+            {
+            }
+            
+            return items;
         }
-        catch(BadCast&)
-        {
-        }
-        
-        return items;
-    }
+    };
 }
 
 VisualizationWidget* LineSegments::createEditor() const
@@ -63,22 +67,12 @@ QList< QGraphicsItem* > LineSegments::createItems(const stromx::runtime::Data &
 {
     using namespace stromx::runtime;
     
-    if(data.isVariant(Variant::INT_8_MATRIX))
-        return createLineSegmentItemsTemplate<int8_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_8_MATRIX))
-        return createLineSegmentItemsTemplate<uint8_t>(data, properties);
-    else if(data.isVariant(Variant::INT_16_MATRIX))
-        return createLineSegmentItemsTemplate<int16_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_16_MATRIX))
-        return createLineSegmentItemsTemplate<uint16_t>(data, properties);
-    else if(data.isVariant(Variant::INT_32_MATRIX))
-        return createLineSegmentItemsTemplate<int32_t>(data, properties);
-    else if(data.isVariant(Variant::UINT_32_MATRIX))
-        return createLineSegmentItemsTemplate<uint32_t>(data, properties);
-    else if(data.isVariant(Variant::FLOAT_32_MATRIX))
-        return createLineSegmentItemsTemplate<float>(data, properties);
-    else if(data.isVariant(Variant::FLOAT_64_MATRIX))
-        return createLineSegmentItemsTemplate<double>(data, properties);
+    if(! data.isVariant(Variant::MATRIX))
+        return QList<QGraphicsItem*>();
+    
+    CreateItemsFunction function = matrixInstanceTable<CreateItemsFunction, LineSegmentItems>().lookup(data_cast<Matrix>(data));
+    if(function)
+        return function(data, properties);
     else
         return QList<QGraphicsItem*>();
 }
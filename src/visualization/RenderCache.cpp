@@ -0,0 +1,207 @@
+#include "visualization/RenderCache.h"
+
+#include <QBrush>
+#include <QGraphicsEllipseItem>
+#include <QGraphicsLineItem>
+#include <QGraphicsPixmapItem>
+#include <QGraphicsRectItem>
+#include <QGraphicsSimpleTextItem>
+#include <QPen>
+
+#include "visualization/Visualization.h"
+#include "visualization/VisualizationRegistry.h"
+
+RenderCache::RenderCache()
+{
+}
+
+RenderCache::~RenderCache()
+{
+    clear();
+}
+
+void RenderCache::setFrame(OperatorModel* op, unsigned int id, const stromx::runtime::Data& data)
+{
+    removeFrame(op, id);
+
+    Frame* frame = new Frame(&data);
+    m_frames[Key(op, id)] = frame;
+    m_framesByData[&data] = frame;
+}
+
+void RenderCache::removeFrame(OperatorModel* op, unsigned int id)
+{
+    Frame* frame = m_frames.take(Key(op, id));
+    if(! frame)
+        return;
+
+    // the same data object can be the current frame of several inputs,
+    // remove the data entry only if it refers to this frame
+    if(m_framesByData.value(frame->data) == frame)
+        m_framesByData.remove(frame->data);
+
+    deleteFrame(frame);
+}
+
+void RenderCache::clear()
+{
+    foreach(Frame* frame, m_frames)
+        deleteFrame(frame);
+
+    m_frames.clear();
+    m_framesByData.clear();
+}
+
+QList<QGraphicsItem*> RenderCache::createItems(const stromx::runtime::Data& data,
+                                               const VisualizationState& state)
+{
+    Frame* frame = m_framesByData.value(&data, 0);
+
+    // data which is not a current frame is not cached
+    if(! frame)
+        return renderItems(data, state);
+
+    const QString visualization = state.currentVisualization();
+    const VisualizationState::Properties properties = state.currentProperties();
+
+    // look for items which have been created for the same visualization
+    foreach(const Rendering & rendering, frame->renderings)
+    {
+        if(rendering.visualization == visualization && rendering.properties == properties)
+        {
+            if(rendering.shareable)
+                return cloneItems(rendering.items);
+            else
+                return renderItems(data, state);
+        }
+    }
+
+    // create the items and remember them
+    Rendering rendering;
+    rendering.visualization = visualization;
+    rendering.properties = properties;
+    rendering.items = renderItems(data, state);
+
+    // return a copy of the items if all of them can be copied
+    QList<QGraphicsItem*> items = cloneItems(rendering.items);
+    rendering.shareable = items.count() == rendering.items.count();
+    if(! rendering.shareable)
+    {
+        // return the original items and render them again next time
+        qDeleteAll(items);
+        items = rendering.items;
+        rendering.items.clear();
+    }
+
+    frame->renderings.append(rendering);
+
+    return items;
+}
+
+QList<QGraphicsItem*> RenderCache::renderItems(const stromx::runtime::Data& data,
+                                               const VisualizationState& state)
+{
+    const Visualization* visualization = VisualizationRegistry::visualization(state.currentVisualization());
+    if(visualization)
+        return visualization->createItems(data, state.currentProperties());
+    else
+        return QList<QGraphicsItem*>();
+}
+
+QList<QGraphicsItem*> RenderCache::cloneItems(const QList<QGraphicsItem*>& items)
+{
+    QList<QGraphicsItem*> clones;
+    foreach(const QGraphicsItem* item, items)
+    {
+        QGraphicsItem* clone = cloneItem(item);
+
+        // stop if any of the items can not be copied
+        if(! clone)
+        {
+            qDeleteAll(clones);
+            return QList<QGraphicsItem*>();
+        }
+
+        clones.append(clone);
+    }
+
+    return clones;
+}
+
+QGraphicsItem* RenderCache::cloneItem(const QGraphicsItem* item)
+{
+    if(! item)
+        return 0;
+
+    QGraphicsItem* clone = 0;
+
+    switch(item->type())
+    {
+    case QGraphicsPixmapItem::Type:
+    {
+        // the pixmap is implicitly shared between the item and its copy
+        const QGraphicsPixmapItem* src = static_cast<const QGraphicsPixmapItem*>(item);
+        QGraphicsPixmapItem* dest = new QGraphicsPixmapItem(src->pixmap());
+        dest->setOffset(src->offset());
+        dest->setTransformationMode(src->transformationMode());
+        clone = dest;
+        break;
+    }
+    case QGraphicsSimpleTextItem::Type:
+    {
+        const QGraphicsSimpleTextItem* src = static_cast<const QGraphicsSimpleTextItem*>(item);
+        QGraphicsSimpleTextItem* dest = new QGraphicsSimpleTextItem(src->text());
+        dest->setFont(src->font());
+        dest->setPen(src->pen());
+        dest->setBrush(src->brush());
+        clone = dest;
+        break;
+    }
+    case QGraphicsLineItem::Type:
+    {
+        const QGraphicsLineItem* src = static_cast<const QGraphicsLineItem*>(item);
+        QGraphicsLineItem* dest = new QGraphicsLineItem(src->line());
+        dest->setPen(src->pen());
+        clone = dest;
+        break;
+    }
+    case QGraphicsRectItem::Type:
+    {
+        const QGraphicsRectItem* src = static_cast<const QGraphicsRectItem*>(item);
+        QGraphicsRectItem* dest = new QGraphicsRectItem(src->rect());
+        dest->setPen(src->pen());
+        dest->setBrush(src->brush());
+        clone = dest;
+        break;
+    }
+    case QGraphicsEllipseItem::Type:
+    {
+        const QGraphicsEllipseItem* src = static_cast<const QGraphicsEllipseItem*>(item);
+        QGraphicsEllipseItem* dest = new QGraphicsEllipseItem(src->rect());
+        dest->setStartAngle(src->startAngle());
+        dest->setSpanAngle(src->spanAngle());
+        dest->setPen(src->pen());
+        dest->setBrush(src->brush());
+        clone = dest;
+        break;
+    }
+    default:
+        return 0;
+    }
+
+    clone->setPos(item->pos());
+    clone->setTransform(item->transform());
+    clone->setZValue(item->zValue());
+    clone->setVisible(item->isVisible());
+    clone->setOpacity(item->opacity());
+
+    return clone;
+}
+
+void RenderCache::deleteFrame(Frame* frame)
+{
+    foreach(const Rendering & rendering, frame->renderings)
+        qDeleteAll(rendering.items);
+
+    delete frame;
+}
@@ -0,0 +1,120 @@
+/*
+*  Copyright 2014 Matthias Fuchs
+*
+*  This file is part of stromx-studio.
+*
+*  Stromx-studio is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  Stromx-studio is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef RENDERCACHE_H
+#define RENDERCACHE_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+
+#include "visualization/VisualizationState.h"
+
+namespace stromx
+{
+    namespace runtime
+    {
+        class Data;
+    }
+}
+
+class QGraphicsItem;
+class OperatorModel;
+
+/**
+ * \brief Cache of graphics items created from observed data
+ *
+ * The render cache stores the current data frame of each observed operator
+ * input while this frame is delivered to the observers. Whenever this data is
+ * visualized the graphics items which are created by the visualization are
+ * stored together with the visualization and its properties. If the same data
+ * is visualized in the same way again (e.g. in a different observer window)
+ * the cached items are copied instead of converting the data again. The copies
+ * share the expensive parts such as pixmaps with the cached items.
+ *
+ * The cache does not hold any access to the data. A frame must be removed
+ * before its data is released, which deletes all items cached for the frame.
+ */
+class RenderCache
+{
+public:
+    RenderCache();
+    ~RenderCache();
+
+    /**
+     * Sets \c data as the current frame of the input \c id of \c op. All items
+     * cached for the previous frame of the input are deleted. The frame must
+     * be removed before \c data is destroyed.
+     */
+    void setFrame(OperatorModel* op, unsigned int id, const stromx::runtime::Data & data);
+
+    /** Deletes the current frame of the input \c id of \c op and all its items. */
+    void removeFrame(OperatorModel* op, unsigned int id);
+
+    /** Deletes all frames and items. */
+    void clear();
+
+    /**
+     * Returns graphics items which visualize \c data as specified by \c state.
+     * The caller takes ownership of the returned items. If \c data is a current
+     * frame of the cache the items are created only once per visualization and
+     * properties and are copied for any subsequent call. Otherwise the items are
+     * directly created by the visualization.
+     */
+    QList<QGraphicsItem*> createItems(const stromx::runtime::Data & data,
+                                      const VisualizationState & state);
+
+    /**
+     * Returns a copy of \c item or 0 if items of the type of \c item can not
+     * be copied.
+     */
+    static QGraphicsItem* cloneItem(const QGraphicsItem* item);
+
+private:
+    typedef QPair<OperatorModel*, unsigned int> Key;
+
+    struct Rendering
+    {
+        QString visualization;
+        VisualizationState::Properties properties;
+        QList<QGraphicsItem*> items;
+        bool shareable;
+    };
+
+    struct Frame
+    {
+        explicit Frame(const stromx::runtime::Data* frameData) : data(frameData) {}
+
+        const stromx::runtime::Data* data;
+        QList<Rendering> renderings;
+    };
+
+    RenderCache(const RenderCache &);
+    RenderCache & operator=(const RenderCache &);
+
+    static QList<QGraphicsItem*> renderItems(const stromx::runtime::Data & data,
+                                             const VisualizationState & state);
+    static QList<QGraphicsItem*> cloneItems(const QList<QGraphicsItem*> & items);
+    static void deleteFrame(Frame* frame);
+
+    QHash<Key, Frame*> m_frames;
+    QHash<const stromx::runtime::Data*, Frame*> m_framesByData;
+};
+
+#endif // RENDERCACHE_H
@@ -48,6 +48,10 @@ class VisualizationWidget;
 class Visualization
 {
 public:
+    /** Function which creates the graphics items of data of a specific type. */
+    typedef QList<QGraphicsItem*> (*CreateItemsFunction)(const stromx::runtime::Data & data,
+        const VisualizationState::Properties & properties);
+    
     /** Constructs a visualization. */
     Visualization(const QString & visualization, const QString & name)
       : m_visualization(visualization),
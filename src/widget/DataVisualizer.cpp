@@ -1,13 +1,15 @@
 #include "widget/DataVisualizer.h"
 
 #include "model/InputModel.h"
+#include "visualization/RenderCache.h"
 #include "visualization/Visualization.h"
 #include "visualization/VisualizationRegistry.h"
 #include <QGraphicsItem>
 #include <stromx/runtime/Primitive.h>
 
 DataVisualizer::DataVisualizer(QWidget* parent)
-  : GraphicsView(parent)
+  : GraphicsView(parent),
+    m_renderCache(0)
 {
     setScene(new QGraphicsScene(this));
 }
@@ -127,11 +129,16 @@ void DataVisualizer::setData(int pos, const stromx::runtime::Data& data,
         return;
     
     // create the graphic items representing the stromx data
-    QString identifier = state.currentVisualization();
-    const Visualization* visualization = VisualizationRegistry::visualization(identifier);
-    if (visualization)
+    if (m_renderCache)
     {
-        m_items[pos] = visualization->createItems(data, state.currentProperties());
+        m_items[pos] = m_renderCache->createItems(data, state);
+    }
+    else
+    {
+        QString identifier = state.currentVisualization();
+        const Visualization* visualization = VisualizationRegistry::visualization(identifier);
+        if (visualization)
+            m_items[pos] = visualization->createItems(data, state.currentProperties());
     }
     
     // add the items and set their z-value
@@ -27,6 +27,8 @@
 #include "AbstractDataVisualizer.h"
 #include "GraphicsView.h"
 
+class RenderCache;
+
 /** 
  * \brief Data visualizer based on QGraphicsView
  * 
@@ -39,6 +41,12 @@ class DataVisualizer : public GraphicsView, public AbstractDataVisualizer
 public:
     DataVisualizer(QWidget* parent = 0);
     
+    /** 
+     * Sets the cache which is used to create the graphics items of the layers.
+     * If no cache is set the items are directly created by the visualizations.
+     */
+    void setRenderCache(RenderCache* cache) { m_renderCache = cache; }
+    
     virtual void addLayer(int pos);
     virtual void moveLayer(int src, int dest);
     virtual void removeLayer(int pos);
@@ -50,6 +58,7 @@ public:
 private:
     /** Maps each existing layer to a list of graphic items the layer contains. */
     QMap<int, QList<QGraphicsItem*> > m_items;
+    RenderCache* m_renderCache;
 };
 
 #endif // DATAVISUALIZER_H
@@ -8,12 +8,10 @@
 #include "delegate/ItemDelegate.h"
 #include "model/ErrorListModel.h"
 
-ErrorListView::ErrorListView(QWidget* parent)
+ErrorListView::ErrorListView(ErrorListModel* model, QWidget* parent)
   : QWidget(parent),
-    m_model(0)
+    m_model(model)
 {
-    m_model = new ErrorListModel(this);
-    
     QTableView* tableView = new QTableView;
     
     tableView->setItemDelegate(new ItemDelegate);
@@ -26,9 +24,13 @@ ErrorListView::ErrorListView(QWidget* parent)
     
 #ifdef STROMX_STUDIO_QT4
     tableView->horizontalHeader()->setResizeMode(ErrorListModel::TIME, QHeaderView::Interactive);
+    tableView->horizontalHeader()->setResizeMode(ErrorListModel::LAST_TIME, QHeaderView::Interactive);
+    tableView->horizontalHeader()->setResizeMode(ErrorListModel::COUNT, QHeaderView::ResizeToContents);
     tableView->horizontalHeader()->setResizeMode(ErrorListModel::DESCRIPTION, QHeaderView::Stretch);
 #else
     tableView->horizontalHeader()->setSectionResizeMode(ErrorListModel::TIME, QHeaderView::Interactive);
+    tableView->horizontalHeader()->setSectionResizeMode(ErrorListModel::LAST_TIME, QHeaderView::Interactive);
+    tableView->horizontalHeader()->setSectionResizeMode(ErrorListModel::COUNT, QHeaderView::ResizeToContents);
     tableView->horizontalHeader()->setSectionResizeMode(ErrorListModel::DESCRIPTION, QHeaderView::Stretch);
 #endif // STROMX_STUDIO_QT4
     
@@ -30,8 +30,8 @@ class ErrorListView : public QWidget
     Q_OBJECT
 
 public:
-    /** Constructs an error list view. */
-    explicit ErrorListView(QWidget *parent = 0);
+    /** Constructs an error list view which displays \c model. */
+    explicit ErrorListView(ErrorListModel* model, QWidget *parent = 0);
     
     /** Returns the model of the view. */
     ErrorListModel* errorListModel() const { return m_model; }
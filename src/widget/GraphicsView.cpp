@@ -65,6 +65,7 @@ void GraphicsView::wheelEvent(QWheelEvent* event)
     scale(factor, factor);
     if(! matrix().isIdentity())
         emit isZoomedChanged(true);
+    emit scaleChanged(transform().m11());
     
     m_currentCenter = mapToScene(viewport()->contentsRect().center());
     setCenter(m_currentCenter);
@@ -166,9 +167,17 @@ void GraphicsView::setCenter(const QPointF center)
     centerOn(m_currentCenter);
 }
 
+void GraphicsView::setTransform(const QTransform& matrix, bool combine)
+{
+    QGraphicsView::setTransform(matrix, combine);
+    emit isZoomedChanged(! transform().isIdentity());
+    emit scaleChanged(transform().m11());
+}
+
 void GraphicsView::resetZoomSize()
 {
     resetMatrix();
     emit isZoomedChanged(false);
+    emit scaleChanged(1.0);
 }
 
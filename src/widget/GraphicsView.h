@@ -41,6 +41,12 @@ public:
      * not null the action is created as a child of \c parent.
      */
     QAction* createResetZoomAction(QObject* parent = 0);
+    
+    /** 
+     * Sets the transformation of the view to \c matrix and emits the changed
+     * zoom and scale.
+     */
+    void setTransform(const QTransform & matrix, bool combine = false);
 
 protected:
     virtual void mousePressEvent(QMouseEvent *event);
@@ -64,6 +70,9 @@ signals:
      */
     void isZoomedChanged(bool isZoomed);
     
+    /** This signal is emitted if the scale of the view changes. */
+    void scaleChanged(qreal scale);
+    
 private:
     QPoint m_lastPanPos;
     QPointF m_currentCenter;
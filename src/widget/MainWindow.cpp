@@ -17,39 +17,54 @@
 *  along with stromx-studio.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#ifndef STROMX_STUDIO_QT4
+#include <QLockFile>
+#endif
+
 #include <QAction>
+#include <QBuffer>
 #include <QApplication>
 #include <QCloseEvent>
 #include <QDockWidget>
+#include <QFile>
+#include <QEventLoop>
 #include <QLabel>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QSplitter>
+#include <QTimer>
 #include <QToolBar>
 #include <QDir>
 #include <QFileDialog>
 #include <QHBoxLayout>
+#include <QInputDialog>
+#include <QStatusBar>
 #include <QSettings>
 #include <QtDebug>
 #include <QtGlobal>
 #include <iostream>
 #include <memory>
-#include <stromx/runtime/DirectoryFileInput.h>
-#include <stromx/runtime/DirectoryFileOutput.h>
 #include <stromx/runtime/Exception.h>
 #include <stromx/runtime/Runtime.h>
-#include <stromx/runtime/ZipFileInput.h>
-#include <stromx/runtime/ZipFileOutput.h>
+#include "CapturePlayer.h"
+#include "CaptureWriter.h"
 #include "Common.h"
 #include "Config.h"
 #include "Exception.h"
 #include "LimitUndoStack.h"
+#include "MemoryFileOutput.h"
+#include "OperatorWatchdog.h"
+#include "SectionReader.h"
+#include "SectionWriter.h"
 #include "StreamEditorScene.h"
 #include "model/ErrorListModel.h"
 #include "model/ObserverTreeModel.h"
 #include "model/OperatorLibraryModel.h"
 #include "model/StreamModel.h"
+#include "task/ReadStreamTask.h"
+#include "task/WriteStreamTask.h"
 #include "widget/ErrorListView.h"
 #include "widget/FindPackagesDialog.h"
 #include "widget/MainWindow.h"
@@ -64,11 +79,31 @@
 #include "widget/DataVisualizer.h"
 #include "widget/DocumentationWindow.h"
 
+const quint32 MainWindow::WINDOW_STATES_MAGIC_NUMBER = 0x20140801;
+const quint32 MainWindow::WINDOW_STATES_VERSION = 1;
+
 MainWindow::MainWindow(QWidget *parent)
   : QMainWindow(parent),
+    m_errorListView(0),
+    m_errorListModel(0),
     m_model(0),
-    m_timeoutMessageIsActive(false)
+    m_timeoutMessageIsActive(false),
+    m_capturePlayer(0),
+    m_readStreamTask(0),
+    m_readProgressDialog(0),
+    m_startProgressDialog(0),
+    m_writeStreamTask(0),
+    m_autosaveTask(0),
+    m_autosaveTimer(0),
+    m_autosaveRequired(false),
+    m_unsavedRecovery(false)
 {
+#ifndef STROMX_STUDIO_QT4
+    // tell other instances that the recovery file of this instance is in use
+    m_recoveryLock = new QLockFile(recoveryFile() + ".lock");
+    m_recoveryLock->tryLock(0);
+#endif
+    
     m_undoStack = new LimitUndoStack(this);
     m_streamEditor = new StreamEditor;
     m_threadListView = new ThreadListView(this);
@@ -100,6 +135,15 @@ MainWindow::MainWindow(QWidget *parent)
             this, SLOT(resetObserverWindows(StreamModel*)));
     connect(m_undoStack, SIGNAL(cleanChanged(bool)), this, SLOT(updateWindowTitle(bool)));
     connect(m_undoStack, SIGNAL(cleanChanged(bool)), m_saveAct, SLOT(setDisabled(bool)));
+    connect(m_undoStack, SIGNAL(indexChanged(int)), this, SLOT(requestAutosave()));
+    
+    QSettings settings("stromx", "stromx-studio");
+    m_autosaveTimer = new QTimer(this);
+    connect(m_autosaveTimer, SIGNAL(timeout()), this, SLOT(autosave()));
+    setAutosaveInterval(settings.value("autosaveInterval", int(DEFAULT_AUTOSAVE_INTERVAL)).toInt());
+    
+    qint64 undoMemoryBudget = settings.value("undoMemoryBudget", int(LimitUndoStack::DEFAULT_MEMORY_BUDGET / MEGABYTE)).toInt();
+    m_undoStack->setMemoryBudget(undoMemoryBudget * MEGABYTE);
     
     StreamModel* streamModel = new StreamModel(m_undoStack,
                                                m_operatorLibraryView->operatorLibraryModel(),
@@ -109,6 +153,19 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
+    // stop the player before the stream model is deleted
+    stopReplay();
+    
+    // wait for the file reader before the operator factory is deleted
+    if(m_readStreamTask)
+    {
+        m_readStreamTask->cancel();
+        delete m_readStreamTask;
+    }
+    
+#ifndef STROMX_STUDIO_QT4
+    delete m_recoveryLock;
+#endif
 }
 
 void MainWindow::createDockWidgets()
@@ -134,12 +191,14 @@ void MainWindow::createDockWidgets()
     m_propertyDockWidget->setWidget(m_propertyView);
     m_propertyDockWidget->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
     
-    m_errorListView = new ErrorListView(this);
+    // the error log is hidden by default, i.e. its view is constructed
+    // when the dock widget is shown for the first time
+    m_errorListModel = new ErrorListModel(this);
     m_errorDockWidget = new QDockWidget(this);
     m_errorDockWidget->setWindowTitle(tr("Error log"));
     m_errorDockWidget->setObjectName("ErrorLog");
-    m_errorDockWidget->setWidget(m_errorListView);
     m_errorDockWidget->setAllowedAreas(Qt::BottomDockWidgetArea);
+    connect(m_errorDockWidget, SIGNAL(visibilityChanged(bool)), this, SLOT(createErrorListView(bool)));
     
     addDockWidget(Qt::LeftDockWidgetArea, m_operatorLibraryDockWidget);
     addDockWidget(Qt::RightDockWidgetArea, m_propertyDockWidget);
@@ -152,6 +211,9 @@ void MainWindow::setModel(StreamModel* model)
 {
     Q_ASSERT(model);
     
+    // finish saving the old model before the current file is changed
+    waitForWriteFile();
+    
     // the model is zero when this function is called for the first time
     if(m_model)
     {
@@ -167,11 +229,16 @@ void MainWindow::setModel(StreamModel* model)
         join();
     }
     
+    // the player and the capture refer to the operators of the old model
+    stopReplay();
+    if(m_model)
+        stopCapture();
+    
     // clear the undo stack
     m_undoStack->clear();
     
     // clear the error list
-    m_errorListView->errorListModel()->clear();
+    m_errorListModel->clear();
     
     // close the settings dialog
     m_settingsDialog->close();
@@ -180,7 +247,7 @@ void MainWindow::setModel(StreamModel* model)
     m_streamEditor->streamEditorScene()->setModel(model);
     m_threadListView->setStreamModel(model);
     m_observerTreeView->setModel(model->observerModel());
-    model->setExceptionObserver(m_errorListView->errorListModel()->exceptionObserver());
+    model->setExceptionObserver(m_errorListModel->exceptionObserver());
     m_settingsDialog->setModel(model);
     
     // delete the old model
@@ -190,6 +257,7 @@ void MainWindow::setModel(StreamModel* model)
     // remember the new model
     m_model = model;
     connect(m_model, SIGNAL(accessTimedOut()), this, SLOT(handleAccessTimeout()));
+    connect(m_model, SIGNAL(streamStarted()), this, SLOT(finishStart()));
     connect(m_model, SIGNAL(streamJoined()), this, SLOT(join()));
     connect(m_model->observerModel(), SIGNAL(observerAdded(ObserverModel*)), this, SLOT(createObserverWindow(ObserverModel*)));
     connect(m_model->observerModel(), SIGNAL(observerRemoved(ObserverModel*)), this, SLOT(destroyObserverWindow(ObserverModel*)));
@@ -197,6 +265,9 @@ void MainWindow::setModel(StreamModel* model)
     
     // update the state of the slow action
     m_slowAction->setChecked(m_model->delayActive());
+    
+    // apply the watchdog setting to the new model
+    m_model->watchdog()->setEnabled(m_watchdogAct->isChecked());
 }
 
 void MainWindow::createActions()
@@ -205,6 +276,10 @@ void MainWindow::createActions()
     m_undoAct->setShortcuts(QKeySequence::Undo);
     m_redoAct = m_undoStack->createRedoAction(this);
     m_redoAct->setShortcuts(QKeySequence::Redo);
+    
+    m_undoMemoryBudgetAct = new QAction(tr("Undo &Memory..."), this);
+    m_undoMemoryBudgetAct->setStatusTip(tr("Set the maximal memory which is used to undo parameter changes"));
+    connect(m_undoMemoryBudgetAct, SIGNAL(triggered()), this, SLOT(editUndoMemoryBudget()));
     m_initializeAct = m_streamEditor->streamEditorScene()->createInitializeAction(this);
     m_deinitializeAct = m_streamEditor->streamEditorScene()->createDeinitializeAction(this);
     m_addThreadAct = m_threadListView->createAddThreadAction(this);
@@ -236,6 +311,10 @@ void MainWindow::createActions()
     m_closeAct->setStatusTip(tr("Close the current stream"));
     connect(m_closeAct, SIGNAL(triggered()), this, SLOT(closeStream()));
     
+    m_autosaveIntervalAct = new QAction(tr("A&utosave Interval..."), this);
+    m_autosaveIntervalAct->setStatusTip(tr("Set the interval of the automatic backup of the current stream"));
+    connect(m_autosaveIntervalAct, SIGNAL(triggered()), this, SLOT(editAutosaveInterval()));
+    
     for (int i = 0; i < MAX_RECENT_FILES; ++i)
     {
         m_recentFileActs[i] = new QAction(this);
@@ -291,6 +370,13 @@ void MainWindow::createActions()
     m_slowAction->setCheckable(true);
     connect(m_slowAction, SIGNAL(toggled(bool)), this, SLOT(setSlowProcessing(bool)));
     
+    QSettings settings("stromx", "stromx-studio");
+    m_watchdogAct = new QAction(tr("Detect hung operators"), this);
+    m_watchdogAct->setStatusTip(tr("Record the connector activity while the stream is active and report operators which stopped making progress"));
+    m_watchdogAct->setCheckable(true);
+    m_watchdogAct->setChecked(settings.value("watchdogEnabled", true).toBool());
+    connect(m_watchdogAct, SIGNAL(toggled(bool)), this, SLOT(setWatchdogEnabled(bool)));
+    
     m_emptyRecentFilesAct = new QAction(tr("Empty recent files"), this);
     m_emptyRecentFilesAct->setStatusTip(tr("Empty the list of recently opened files"));
     connect(m_emptyRecentFilesAct, SIGNAL(triggered(bool)), this, SLOT(emptyRecentFiles()));
@@ -326,6 +412,24 @@ void MainWindow::createActions()
     m_showErrorListViewAct->setShortcut(tr("F8"));
     connect(m_errorDockWidget, SIGNAL(visibilityChanged(bool)), m_showErrorListViewAct, SLOT(setChecked(bool)));
     connect(m_showErrorListViewAct, SIGNAL(toggled(bool)), m_errorDockWidget, SLOT(setVisible(bool)));
+    
+    m_startCaptureAct = new QAction(tr("Start capture..."), this);
+    m_startCaptureAct->setStatusTip(tr("Write the data at all observed inputs to a capture file"));
+    connect(m_startCaptureAct, SIGNAL(triggered()), this, SLOT(startCapture()));
+    
+    m_stopCaptureAct = new QAction(tr("Stop capture"), this);
+    m_stopCaptureAct->setStatusTip(tr("Stop writing to the capture file"));
+    m_stopCaptureAct->setEnabled(false);
+    connect(m_stopCaptureAct, SIGNAL(triggered()), this, SLOT(stopCapture()));
+    
+    m_replayCaptureAct = new QAction(tr("Replay capture..."), this);
+    m_replayCaptureAct->setStatusTip(tr("Replay the data in a capture file"));
+    connect(m_replayCaptureAct, SIGNAL(triggered()), this, SLOT(replayCapture()));
+    
+    m_stopReplayAct = new QAction(tr("Stop replay"), this);
+    m_stopReplayAct->setStatusTip(tr("Stop replaying the capture file"));
+    m_stopReplayAct->setEnabled(false);
+    connect(m_stopReplayAct, SIGNAL(triggered()), this, SLOT(stopReplay()));
 }
 
 void MainWindow::createMenus()
@@ -335,6 +439,7 @@ void MainWindow::createMenus()
     m_fileMenu->addAction(m_saveAct);
     m_fileMenu->addAction(m_saveAsAct);
     m_fileMenu->addAction(m_closeAct);
+    m_fileMenu->addAction(m_autosaveIntervalAct);
     m_recentFilesSeparatorAct = m_fileMenu->addSeparator();
     for (int i = 0; i < MAX_RECENT_FILES; ++i)
         m_fileMenu->addAction(m_recentFileActs[i]);
@@ -350,6 +455,8 @@ void MainWindow::createMenus()
     m_editMenu = menuBar()->addMenu(tr("&Edit"));
     m_editMenu->addAction(m_undoAct);
     m_editMenu->addAction(m_redoAct);
+    m_editMenu->addSeparator();
+    m_editMenu->addAction(m_undoMemoryBudgetAct);
 
     m_streamMenu = menuBar()->addMenu(tr("&Stream"));
     m_streamMenu->addAction(m_startAct);
@@ -367,6 +474,12 @@ void MainWindow::createMenus()
     m_streamMenu->addAction(m_removeObserverAct);
     m_streamMenu->addAction(m_removeInputAct);
     m_streamMenu->addSeparator();
+    m_streamMenu->addAction(m_startCaptureAct);
+    m_streamMenu->addAction(m_stopCaptureAct);
+    m_streamMenu->addAction(m_replayCaptureAct);
+    m_streamMenu->addAction(m_stopReplayAct);
+    m_streamMenu->addSeparator();
+    m_streamMenu->addAction(m_watchdogAct);
     m_streamMenu->addAction(m_showSettingsAct);
 
     m_viewMenu = menuBar()->addMenu(tr("&View"));
@@ -417,12 +530,12 @@ void MainWindow::about()
 
 bool MainWindow::save()
 {
+    // the current file is set after the previous write has finished
+    waitForWriteFile();
+    
+    // return false if the saving dialog was cancelled
     if(m_currentFile.isEmpty())
-    {
-        // return false if the saving dialog was cancelled
-        if(! saveAs())
-            return false;
-    }
+        return saveAs();
     
     return writeFile(m_currentFile);
 }
@@ -432,14 +545,35 @@ void MainWindow::start()
     if(m_model->start())
     {
         m_startAct->setEnabled(false);
-        m_pauseAct->setEnabled(true);
+        m_pauseAct->setEnabled(! m_model->isStarting());
         m_stopAct->setEnabled(true);
         m_redoAct->setEnabled(false);
         m_undoAct->setEnabled(false);
         m_undoStack->activateLimit();
+        
+        if(m_model->isStarting() && ! m_startProgressDialog)
+        {
+            // the activation of the operators can not be tracked, i.e. the dialog
+            // only indicates that the stream is busy
+            m_startProgressDialog = new QProgressDialog(tr("Activating the operators..."),
+                                                        tr("Cancel"), 0, 0, this);
+            m_startProgressDialog->setWindowTitle(tr("Starting the stream"));
+            m_startProgressDialog->setWindowModality(Qt::WindowModal);
+            m_startProgressDialog->setMinimumDuration(START_PROGRESS_DELAY);
+            m_startProgressDialog->setValue(0);
+            connect(m_startProgressDialog, SIGNAL(canceled()), this, SLOT(stop()));
+        }
     }
 }
 
+void MainWindow::finishStart()
+{
+    delete m_startProgressDialog;
+    m_startProgressDialog = 0;
+    
+    m_pauseAct->setEnabled(true);
+}
+
 void MainWindow::stop()
 {
     if(m_model->stop())
@@ -462,6 +596,9 @@ void MainWindow::pause()
 
 void MainWindow::join()
 {
+    delete m_startProgressDialog;
+    m_startProgressDialog = 0;
+    
     m_startAct->setEnabled(true);
     m_pauseAct->setEnabled(false);
     m_stopAct->setEnabled(false);
@@ -480,16 +617,8 @@ bool MainWindow::openRecentFile()
         
         QString filepath = action->data().toString();
         
-        if(! readFile(filepath))
-        {
-            // if the file could not be opened remove it from the list of recently opened files
-            QSettings settings("stromx", "stromx-studio");
-            QStringList files = settings.value("recentFileList").toStringList();
-            files.removeAll(filepath);
-            settings.setValue("recentFileList", files);
-            
-            updateRecentFileActions();
-        }
+        // files which can not be read are removed from the recent files by finishReadFile()
+        readFile(filepath);
         
         return true;
     }
@@ -518,7 +647,6 @@ bool MainWindow::open()
 
 bool MainWindow::readFile(const QString& filepath)
 { 
-    QString basename = QFileInfo(filepath).baseName();
     QString extension = QFileInfo(filepath).suffix();
     
     if(extension != "xml" && extension != "zip" && extension != "stromx")
@@ -529,112 +657,123 @@ bool MainWindow::readFile(const QString& filepath)
         return false;
     }
     
-    // try to read the stream
-    StreamModel* stream = 0;
-    std::auto_ptr<stromx::runtime::FileInput> input;
-    QString location;
+    // only one file can be read at a time
+    if(m_readStreamTask)
+        return false;
     
-    try
-    {
-        if(extension == "xml")
-        {
-            location = QFileInfo(filepath).absoluteDir().absolutePath();
-            input = std::auto_ptr<stromx::runtime::FileInput>(new stromx::runtime::DirectoryFileInput(location.toStdString()));
-        }
-        else if(extension == "zip" || extension == "stromx")
-        {
-            location = filepath;
-            input = std::auto_ptr<stromx::runtime::FileInput>(new stromx::runtime::ZipFileInput(filepath.toStdString()));
-        }
-    }
-    catch(stromx::runtime::FileAccessFailed&)
+    // read the stream on a worker thread
+    m_readStreamTask = new ReadStreamTask(filepath, m_operatorLibraryView->operatorLibraryModel()->factory(), this);
+    connect(m_readStreamTask, SIGNAL(stageStarted(int)), this, SLOT(updateReadProgress(int)));
+    connect(m_readStreamTask, SIGNAL(finished()), this, SLOT(finishReadFile()));
+    
+    // the window is blocked by the progress dialog but is still repainted
+    m_readProgressDialog = new QProgressDialog(ReadStreamTask::stageLabel(ReadStreamTask::OPEN_FILE),
+                                               tr("Cancel"), 0, ReadStreamTask::NUM_STAGES, this);
+    m_readProgressDialog->setWindowTitle(tr("Opening %1").arg(strippedName(filepath)));
+    m_readProgressDialog->setWindowModality(Qt::WindowModal);
+    m_readProgressDialog->setMinimumDuration(READ_PROGRESS_DELAY);
+    m_readProgressDialog->setValue(0);
+    connect(m_readProgressDialog, SIGNAL(canceled()), m_readStreamTask, SLOT(cancel()));
+    
+    m_readStreamTask->start();
+    
+    return true;
+}
+
+void MainWindow::updateReadProgress(int stage)
+{
+    if(m_readProgressDialog && ! m_readProgressDialog->wasCanceled())
     {
-        QMessageBox::critical(this, tr("Failed to load file"),
-                              tr("The location %1 could not be openend for reading").arg(location),
-                              QMessageBox::Ok, QMessageBox::Ok);
-        return false;
+        m_readProgressDialog->setLabelText(ReadStreamTask::stageLabel(stage));
+        m_readProgressDialog->setValue(stage);
     }
+}
+
+void MainWindow::finishReadFile()
+{
+    ReadStreamTask* task = m_readStreamTask;
+    m_readStreamTask = 0;
     
-    try
+    delete m_readProgressDialog;
+    m_readProgressDialog = 0;
+    
+    // the task deletes itself after this function returns
+    if(! task || task->isCanceled())
+        return;
+    
+    QString filepath = task->filepath();
+    stromx::runtime::Stream* stromxStream = task->takeStream();
+    
+    if(! stromxStream)
     {
-        if(extension == "xml")
-        {
-            stream = new StreamModel(*input, basename, m_undoStack,
-                                     m_operatorLibraryView->operatorLibraryModel(), this);
-        }
-        else if(extension == "zip" || extension == "stromx")
+        QMessageBox::critical(this, tr("Failed to load file"), task->errorMessage(),
+                              QMessageBox::Ok, QMessageBox::Ok);
+        
+        // if the file could not be opened remove it from the list of recently opened files
+        QSettings settings("stromx", "stromx-studio");
+        QStringList files = settings.value("recentFileList").toStringList();
+        files.removeAll(filepath);
+        settings.setValue("recentFileList", files);
+        
+        updateRecentFileActions();
+        
+        // do not offer to recover the file again at the next start but
+        // keep it for a manual inspection
+        if(filepath == recoveryFile())
         {
-            stream = new StreamModel(*input, "stream", m_undoStack,
-                                     m_operatorLibraryView->operatorLibraryModel(), this);
+            QFile::remove(filepath + ".failed");
+            QFile::rename(filepath, filepath + ".failed");
         }
         
-        updateCurrentFile(filepath);
-    }
-    catch(stromx::runtime::FileAccessFailed&)
-    {
-        QMessageBox::critical(this, tr("Failed to load file"),
-                              tr("The location %1 could not be openend for reading").arg(location),
-                              QMessageBox::Ok, QMessageBox::Ok);
-        return false;
-    }
-    catch(ReadStreamFailed& e)
-    {
-        QMessageBox::critical(this, tr("Failed to load file"), e.what(),
-                              QMessageBox::Ok, QMessageBox::Ok);
-        return false;
+        return;
     }
     
-    // try to read observer data from views.json in zip archive
-    try
-    {
-        if(extension == "zip" || extension == "stromx")
-        {
-            stream->readObserverData(*input);
-        }
-    }
-    catch(ReadObserverDataFailed& e)
-    {
-        // ignore
-    }
+    // construct the stream model from the data read by the task
+    StreamModel* stream = new StreamModel(stromxStream, m_undoStack,
+                                          m_operatorLibraryView->operatorLibraryModel(), this);
+    stream->setDeferredParameters(filepath, task->deferredParameters());
+    updateCurrentFile(filepath);
     
     // try to read observer data from *.studio binary file
+    bool hasStudioData = false;
     try
     {
-        if(extension == "xml")
-        {
-            stream->readStudioData(*input, basename);
-        }
-        else if(extension == "zip" || extension == "stromx")
+        if(! task->studioData().isEmpty())
         {
-            stream->readStudioData(*input, "stream");
+            stream->readStudioData(task->studioData());
+            hasStudioData = true;
         }
     }
     catch(ReadStudioDataFailed& e)
     {
-        // ignore
+        // remove the observers which were read before the failure, they
+        // are read again from views.json below
+        ObserverTreeModel* observers = stream->observerModel();
+        while(! observers->observers().isEmpty())
+            observers->removeRows(0, 1);
     }
     
+    // observer data from views.json in zip archive, files which contain
+    // a *.studio file store the same observers in both files
+    if(! hasStudioData && ! task->observerData().isEmpty())
+        stream->readObserverData(task->observerData());
+    
     // reading was successful
     // set the new stream
     setModel(stream);
     
-    // read and restore the geometry of the observer windows
-    try
-    {
-        if(extension == "xml")
-        {
-            readWindowStates(*input, basename);
-        }
-        else if(extension == "zip" || extension == "stromx")
-        {
-            readWindowStates(*input, "stream");
-        }
-        
-    }
-    catch(ReadStreamFailed& e)
+    // restore the geometry of the observer windows
+    readWindowStates(task->windowStates());
+    
+    if(filepath == recoveryFile())
     {
-        QMessageBox::warning(this, tr("Loaded only part of file"), e.what(),
-                             QMessageBox::Ok, QMessageBox::Ok);
+        // the recovered stream has not been saved to its original file yet
+        QSettings settings("stromx", "stromx-studio");
+        m_currentFile = settings.value(recoveryOriginalFileKey(filepath)).toString();
+        m_unsavedRecovery = true;
+        m_saveAct->setEnabled(true);
+        updateWindowTitle(true);
+        return;
     }
     
     // remember the last file
@@ -656,13 +795,11 @@ bool MainWindow::readFile(const QString& filepath)
         if (mainWin)
             mainWin->updateRecentFileActions();
     }
-    
-    return true;
 }
 
 void MainWindow::updateWindowTitle(bool undoStackIsClean)
 {
-    QString cleanMarker = undoStackIsClean ? "" : tr("*");
+    QString cleanMarker = undoStackIsClean && ! m_unsavedRecovery ? "" : tr("*");
     QString file = m_currentFile.isEmpty() ? tr("Untitled") : QFileInfo(m_currentFile).fileName();
     QString title = file + cleanMarker + " - " + tr("stromx-studio");
     setWindowTitle(title);
@@ -671,6 +808,7 @@ void MainWindow::updateWindowTitle(bool undoStackIsClean)
 void MainWindow::updateCurrentFile(const QString& filepath)
 {
     m_currentFile = filepath;
+    m_unsavedRecovery = false;
     m_undoStack->setClean();
     updateWindowTitle(true);
 }
@@ -697,7 +835,10 @@ void MainWindow::updateRecentFileActions()
 
 bool MainWindow::saveBeforeClosing()
 {
-    if(! m_undoStack->isClean())
+    // the undo stack is marked as clean when the current write has finished
+    waitForWriteFile();
+    
+    if(isModified())
     { 
         QMessageBox msgBox;
         msgBox.setText(tr("The stream has been modified."));
@@ -712,6 +853,11 @@ bool MainWindow::saveBeforeClosing()
             // cancel closing if saving was cancelled
             if(! save())
                 return false;
+            
+            // or if it failed
+            waitForWriteFile();
+            if(isModified())
+                return false;
             break;
         case QMessageBox::Discard:
             // forget the changes
@@ -725,6 +871,9 @@ bool MainWindow::saveBeforeClosing()
         }
     }
     
+    // the changes are either saved or discarded
+    discardRecovery();
+    
     return true;
 }
 
@@ -761,7 +910,6 @@ bool MainWindow::saveAs()
 
 bool MainWindow::writeFile(const QString& filepath)
 {
-    QString basename = QFileInfo(filepath).baseName();
     QString extension = QFileInfo(filepath).suffix();
     if(extension != "xml" && extension != "zip" && extension != "stromx")
     {
@@ -769,41 +917,15 @@ bool MainWindow::writeFile(const QString& filepath)
                               QMessageBox::Ok, QMessageBox::Ok);
         return false;
     }
-        
-    // write the stream
-    QString location;
-    try
-    {
-        if(extension == "xml")
-        {
-            location = QFileInfo(filepath).absoluteDir().absolutePath();
-            stromx::runtime::DirectoryFileOutput output(location.toStdString());
-            m_streamEditor->streamEditorScene()->model()->write(output, basename);
-            writeWindowStates(output, basename);
-        }
-        else if(extension == "zip" || extension == "stromx")
-        {
-            location = filepath;
-            stromx::runtime::ZipFileOutput output(location.toStdString());
-            m_streamEditor->streamEditorScene()->model()->write(output, "stream");
-            writeWindowStates(output, "stream");
-            
-            // manually close the file to catch exceptions on writing
-            output.close();
-        }
     
-        updateCurrentFile(filepath);
-        
-        // remember the last dir
-        QSettings settings("stromx", "stromx-studio");
-        settings.setValue("lastStreamSavedDir", QFileInfo(filepath).dir().absolutePath());
-    }
-    catch(stromx::runtime::FileAccessFailed&)
+    // only one file is written at a time
+    waitForWriteFile();
+    
+    // take a snapshot of the stream in memory
+    MemoryFileOutput* snapshot = 0;
+    try
     {
-        QMessageBox::critical(this, tr("Failed to save file"),
-                              tr("The location %1 could not be openend for writing").arg(location),
-                              QMessageBox::Ok, QMessageBox::Ok);
-        return false;
+        snapshot = takeSnapshot(streamBasename(filepath));
     }
     catch(WriteStreamFailed& e)
     {
@@ -812,9 +934,268 @@ bool MainWindow::writeFile(const QString& filepath)
         return false;
     }
     
+    // compress and write the snapshot in the background
+    m_writeStreamTask = new WriteStreamTask(filepath, snapshot, m_undoStack->index(), this);
+    connect(m_writeStreamTask, SIGNAL(finished()), this, SLOT(finishWriteFile()));
+    m_writeStreamTask->start();
+    
+    statusBar()->showMessage(tr("Saving %1...").arg(strippedName(filepath)));
+    
     return true;
 }
 
+void MainWindow::finishWriteFile()
+{
+    WriteStreamTask* task = m_writeStreamTask;
+    m_writeStreamTask = 0;
+    
+    // the task deletes itself after this function returns
+    if(! task)
+        return;
+    
+    if(task->failed())
+    {
+        statusBar()->clearMessage();
+        QMessageBox::critical(this, tr("Failed to save file"), task->errorMessage(),
+                              QMessageBox::Ok, QMessageBox::Ok);
+        return;
+    }
+    
+    // the written file contains the deferred parameters which are read from it from
+    // now on, i.e. the file they were read from before can be removed
+    m_streamEditor->streamEditorScene()->model()->setDeferredParametersFile(task->filepath(),
+                                                                           streamBasename(task->filepath()));
+    
+    // the stream is only clean if it has not been edited since the snapshot was taken
+    m_currentFile = task->filepath();
+    if(m_undoStack->index() == task->undoIndex())
+    {
+        m_undoStack->setClean();
+        m_unsavedRecovery = false;
+    }
+    updateWindowTitle(m_undoStack->isClean());
+    
+    statusBar()->showMessage(tr("Saved %1").arg(strippedName(task->filepath())), SAVED_MESSAGE_TIMEOUT);
+        
+    // remember the last dir
+    QSettings settings("stromx", "stromx-studio");
+    settings.setValue("lastStreamSavedDir", QFileInfo(task->filepath()).dir().absolutePath());
+}
+
+void MainWindow::waitForWriteFile()
+{
+    while(m_writeStreamTask || m_autosaveTask)
+    {
+        WriteStreamTask* task = m_writeStreamTask ? m_writeStreamTask : m_autosaveTask;
+        
+        // finishWriteFile() and finishAutosave() are called before the loop quits
+        // because they were connected first
+        QEventLoop loop;
+        connect(task, SIGNAL(finished()), &loop, SLOT(quit()));
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+    }
+}
+
+MemoryFileOutput* MainWindow::takeSnapshot(const QString& basename) const
+{
+    std::auto_ptr<MemoryFileOutput> snapshot(new MemoryFileOutput);
+    
+    // operators which are initialized in the background can not be written
+    m_streamEditor->streamEditorScene()->model()->waitForInitialization();
+    m_streamEditor->streamEditorScene()->model()->write(*snapshot, basename);
+    writeWindowStates(*snapshot, basename);
+    snapshot->close();
+    
+    return snapshot.release();
+}
+
+QString MainWindow::recoveryFile()
+{
+    // store the file next to the application settings
+    QSettings settings("stromx", "stromx-studio");
+    return QFileInfo(settings.fileName()).absolutePath() 
+           + QString("/stromx-studio-recovery-%1.stromx").arg(QCoreApplication::applicationPid());
+}
+
+QString MainWindow::abandonedRecoveryFile()
+{
+    QSettings settings("stromx", "stromx-studio");
+    QDir dir = QFileInfo(settings.fileName()).absoluteDir();
+    QStringList files = dir.entryList(QStringList() << "stromx-studio-recovery-*.stromx",
+                                      QDir::Files, QDir::Time);
+    
+    foreach(const QString & file, files)
+    {
+        QString path = dir.absoluteFilePath(file);
+        if(path == recoveryFile())
+            continue;
+        
+#ifndef STROMX_STUDIO_QT4
+        // the lock of an instance which is still running can not be obtained
+        QLockFile lock(path + ".lock");
+        if(! lock.tryLock(0))
+            continue;
+#endif
+        
+        return path;
+    }
+    
+    return QString();
+}
+
+QString MainWindow::recoveryOriginalFileKey(const QString& recoveryFile)
+{
+    return "recoveryOriginalFile/" + QFileInfo(recoveryFile).completeBaseName();
+}
+
+bool MainWindow::isModified() const
+{
+    return ! m_undoStack->isClean() || m_unsavedRecovery;
+}
+
+void MainWindow::requestAutosave()
+{
+    m_autosaveRequired = true;
+}
+
+void MainWindow::autosave()
+{
+    // nothing changed since the last autosave or a file is being accessed
+    if(! m_autosaveRequired || m_writeStreamTask || m_autosaveTask || m_readStreamTask)
+        return;
+    
+    if(! isModified())
+    {
+        // the stream was saved, i.e. there is nothing to recover
+        QFile::remove(recoveryFile());
+        m_autosaveRequired = false;
+        return;
+    }
+    
+    MemoryFileOutput* snapshot = 0;
+    try
+    {
+        snapshot = takeSnapshot(streamBasename(recoveryFile()));
+    }
+    catch(WriteStreamFailed& e)
+    {
+        statusBar()->showMessage(tr("Autosave failed: %1").arg(e.what()));
+        return;
+    }
+    
+    QSettings settings("stromx", "stromx-studio");
+    settings.setValue(recoveryOriginalFileKey(recoveryFile()), m_currentFile);
+    
+    m_autosaveRequired = false;
+    m_autosaveTask = new WriteStreamTask(recoveryFile(), snapshot, m_undoStack->index(), this);
+    connect(m_autosaveTask, SIGNAL(finished()), this, SLOT(finishAutosave()));
+    m_autosaveTask->start();
+}
+
+void MainWindow::finishAutosave()
+{
+    WriteStreamTask* task = m_autosaveTask;
+    m_autosaveTask = 0;
+    
+    if(task && task->failed())
+    {
+        // try again at the next interval
+        m_autosaveRequired = true;
+        statusBar()->showMessage(tr("Autosave failed: %1").arg(task->errorMessage()));
+    }
+}
+
+void MainWindow::discardRecovery()
+{
+    // make sure the file is not written after it has been removed
+    waitForWriteFile();
+    
+    QFile::remove(recoveryFile());
+    QSettings settings("stromx", "stromx-studio");
+    settings.remove(recoveryOriginalFileKey(recoveryFile()));
+    m_autosaveRequired = false;
+}
+
+void MainWindow::setAutosaveInterval(int minutes)
+{
+    if(minutes > 0)
+        m_autosaveTimer->start(minutes * 60 * 1000);
+    else
+        m_autosaveTimer->stop();
+}
+
+void MainWindow::editAutosaveInterval()
+{
+    QSettings settings("stromx", "stromx-studio");
+    int interval = settings.value("autosaveInterval", int(DEFAULT_AUTOSAVE_INTERVAL)).toInt();
+    
+    bool ok = false;
+    interval = QInputDialog::getInt(this, tr("Autosave"),
+                                    tr("Autosave interval in minutes (0 disables autosave):"),
+                                    interval, 0, MAX_AUTOSAVE_INTERVAL, 1, &ok);
+    
+    if(! ok)
+        return;
+    
+    settings.setValue("autosaveInterval", interval);
+    setAutosaveInterval(interval);
+}
+
+void MainWindow::editUndoMemoryBudget()
+{
+    bool ok = false;
+    int budget = QInputDialog::getInt(this, tr("Undo memory"),
+                                      tr("Maximal memory of the parameter values which can be undone (MB):"),
+                                      static_cast<int>(m_undoStack->memoryBudget() / MEGABYTE), 0, 1000000, 16, &ok);
+    if(! ok)
+        return;
+    
+    QSettings settings("stromx", "stromx-studio");
+    settings.setValue("undoMemoryBudget", budget);
+    m_undoStack->setMemoryBudget(static_cast<qint64>(budget) * MEGABYTE);
+}
+
+void MainWindow::createErrorListView(bool visible)
+{
+    if(! visible || m_errorListView)
+        return;
+    
+    m_errorListView = new ErrorListView(m_errorListModel, this);
+    m_errorDockWidget->setWidget(m_errorListView);
+}
+
+void MainWindow::recover()
+{
+    QString file = abandonedRecoveryFile();
+    if(file.isEmpty())
+        return;
+    
+    QMessageBox msgBox(this);
+    msgBox.setText(tr("stromx-studio was not closed properly."));
+    msgBox.setInformativeText(tr("Do you want to recover the unsaved changes of the last session?"));
+    msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+    msgBox.setDefaultButton(QMessageBox::Yes);
+    
+    QSettings settings("stromx", "stromx-studio");
+    QString originalFile = settings.value(recoveryOriginalFileKey(file)).toString();
+    settings.remove(recoveryOriginalFileKey(file));
+    
+    if(msgBox.exec() == QMessageBox::Yes)
+    {
+        // the recovered stream is autosaved by this instance from now on
+        QFile::remove(recoveryFile());
+        if(QFile::rename(file, recoveryFile()))
+        {
+            settings.setValue(recoveryOriginalFileKey(recoveryFile()), originalFile);
+            readFile(recoveryFile());
+        }
+    }
+    else
+    {
+        QFile::remove(file);
+    }
+}
+
 void MainWindow::readSettings()
 {
     QSettings settings("stromx", "stromx-studio");
@@ -845,20 +1226,10 @@ void MainWindow::loadPackages()
                             tr("Package (*.dll)")); 
 #endif // WIN32
     
-    // load each library
-    // Qt documentation recommends to iterate over a copy of the file list
-    QStringList fileList = files;
-    foreach(QString file, fileList)
-    {
-        try
-        {
-            m_operatorLibraryView->operatorLibraryModel()->loadPackage(file);
-        }
-        catch(LoadPackageFailed&)
-        {
-            std::cout << "Failed to load '" << file.toStdString() << "'" << std::endl;
-        }
-    }
+    // load all libraries at once
+    QStringList failedFiles = m_operatorLibraryView->operatorLibraryModel()->loadPackages(files);
+    foreach(QString file, failedFiles)
+        std::cout << "Failed to load '" << file.toStdString() << "'" << std::endl;
     
     // remember the last library
     if(files.size())
@@ -885,6 +1256,15 @@ QString MainWindow::strippedName(const QString &fullFileName)
     return QFileInfo(fullFileName).fileName();
 }
 
+QString MainWindow::streamBasename(const QString& filepath)
+{
+    // zip files always contain the stream as 'stream.xml'
+    if(QFileInfo(filepath).suffix() == "xml")
+        return QFileInfo(filepath).baseName();
+    else
+        return "stream";
+}
+
 void MainWindow::closeEvent(QCloseEvent* event)
 { 
     if(closeStream())
@@ -904,6 +1284,15 @@ void MainWindow::setSlowProcessing(bool isSlow)
     m_model->setDelayActive(isSlow);
 }
 
+void MainWindow::setWatchdogEnabled(bool enabled)
+{
+    QSettings settings("stromx", "stromx-studio");
+    settings.setValue("watchdogEnabled", enabled);
+    
+    if(m_model)
+        m_model->watchdog()->setEnabled(enabled);
+}
+
 void MainWindow::emptyRecentFiles()
 {
     QSettings settings("stromx", "stromx-studio");
@@ -951,35 +1340,76 @@ void MainWindow::resetObserverWindows(StreamModel* model)
         createObserverWindow(observer);
 }
 
-void MainWindow::readWindowStates(stromx::runtime::FileInput& input, const QString& basename)
+void MainWindow::readWindowStates(const QByteArray& windowStates)
 {
-    QByteArray data;
+    QBuffer buffer;
+    buffer.setData(windowStates);
+    buffer.open(QIODevice::ReadOnly);
     
-    try
+    QDataStream dataStream(&buffer);
+    quint32 magicNumber = 0;
+    quint32 version = 0;
+    dataStream >> magicNumber;
+    dataStream >> version;
+    
+    if(magicNumber != WINDOW_STATES_MAGIC_NUMBER)
     {
-        input.initialize("", (basename + ".studio.geometry").toStdString());
-        input.openFile(stromx::runtime::InputProvider::BINARY);
+        readWindowStatesVersion0(windowStates);
+        return;
+    }
+    
+    // the observer window sections are stored in the order of the windows
+    int observerWindow = 0;
+    SectionReader reader(&buffer);
+    while(reader.nextSection())
+    {
+        QDataStream & stream = reader.stream();
+        QByteArray geometry;
+        QByteArray state;
+        bool visible = false;
+        QTransform viewTransform;
         
-        // read all data from the input stream
-        int dataSize = 0;
-        const int CHUNK_SIZE = 10;
-        while(! input.file().eof())
+        switch(reader.tag())
         {
-            data.resize(data.size() + CHUNK_SIZE);
-            char* dataPtr = data.data() + dataSize;
-            input.file().read(dataPtr, CHUNK_SIZE);
-            dataSize += (int)(input.file().gcount());
+        case STREAM_VIEW_SECTION:
+            stream >> viewTransform;
+            if(reader.sectionIsValid())
+                m_streamEditor->setTransform(viewTransform);
+            break;
+        case DOCUMENTATION_WINDOW_SECTION:
+            stream >> geometry >> state >> visible;
+            if(reader.sectionIsValid())
+            {
+                m_docWindow->restoreGeometry(geometry);
+                m_docWindow->restoreState(state);
+                m_docWindow->setVisible(visible);
+            }
+            break;
+        case OBSERVER_WINDOW_SECTION:
+            stream >> geometry >> state >> visible >> viewTransform;
+            if(reader.sectionIsValid() && observerWindow < m_observerWindows.count())
+            {
+                ObserverWindow* window = m_observerWindows[observerWindow];
+                window->restoreGeometry(geometry);
+                window->restoreState(state);
+                window->setVisible(visible);
+                window->visualizer()->setTransform(viewTransform);
+            }
+            observerWindow++;
+            break;
+        default:
+            // sections added by newer versions are skipped
+            ;
         }
-        data.resize(dataSize);
-    }
-    catch(stromx::runtime::FileAccessFailed& e)
-    {
-        // simply ignore errors and do not update the window geometry
-        qWarning() << e.what();
     }
+}
+
+void MainWindow::readWindowStatesVersion0(const QByteArray& windowStates)
+{
+    QByteArray data;
     
     // construct a input stream from the data
-    QDataStream dataStream(data);
+    QDataStream dataStream(windowStates);
     
     // read the state of the stream view
     QTransform viewTransform;
@@ -1012,25 +1442,37 @@ void MainWindow::readWindowStates(stromx::runtime::FileInput& input, const QStri
 
 void MainWindow::writeWindowStates(stromx::runtime::FileOutput& output, const QString& basename) const
 {
-    // construct an output stream
     QByteArray data;
-    QDataStream dataStream(&data, QIODevice::WriteOnly | QIODevice::Truncate);
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    
+    QDataStream dataStream(&buffer);
+    dataStream << WINDOW_STATES_MAGIC_NUMBER;
+    dataStream << WINDOW_STATES_VERSION;
+    
+    SectionWriter writer(&buffer);
     
     // write the view transform of the stream view
-    dataStream << m_streamEditor->transform();
+    writer.beginSection(STREAM_VIEW_SECTION);
+    writer.stream() << m_streamEditor->transform();
+    writer.endSection();
     
     // write the state and geometry of the documentation window
-    dataStream << m_docWindow->saveGeometry();
-    dataStream << m_docWindow->saveState();
-    dataStream << m_docWindow->isVisible();
+    writer.beginSection(DOCUMENTATION_WINDOW_SECTION);
+    writer.stream() << m_docWindow->saveGeometry();
+    writer.stream() << m_docWindow->saveState();
+    writer.stream() << m_docWindow->isVisible();
+    writer.endSection();
     
     // write the state and geometry of each observer window
     foreach(ObserverWindow* window, m_observerWindows)
     {
-        dataStream << window->saveGeometry();
-        dataStream << window->saveState();
-        dataStream << window->isVisible();
-        dataStream << window->visualizer()->transform();
+        writer.beginSection(OBSERVER_WINDOW_SECTION);
+        writer.stream() << window->saveGeometry();
+        writer.stream() << window->saveState();
+        writer.stream() << window->isVisible();
+        writer.stream() << window->visualizer()->transform();
+        writer.endSection();
     }
     
     try
@@ -1098,20 +1540,149 @@ void MainWindow::findPackages()
     m_findPackagesDialog->setShowOnStartup(showOnStartup);
     if (m_findPackagesDialog->exec() == QDialog::Accepted)
     {
+        QStringList files;
         foreach (const QFileInfo & info, m_findPackagesDialog->selectedPackages())
-        {
-            QString file = info.absoluteFilePath();
-            try
-            {
-                m_operatorLibraryView->operatorLibraryModel()->loadPackage(file);
-            }
-            catch(LoadPackageFailed&)
-            {
-                std::cout << "Failed to load '" << file.toStdString() << "'" << std::endl;
-            }
-        }
+            files.append(info.absoluteFilePath());
+        
+        // the library is updated once after all packages have been loaded
+        QStringList failedFiles = m_operatorLibraryView->operatorLibraryModel()->loadPackages(files);
+        foreach(QString file, failedFiles)
+            std::cout << "Failed to load '" << file.toStdString() << "'" << std::endl;
     }
     settings.setValue("showFindPackagesOnStartup", m_findPackagesDialog->showOnStartup());
 }
 
 
+
+void MainWindow::startCapture()
+{
+    QSettings settings("stromx", "stromx-studio");
+    QString lastDir = settings.value("lastCaptureDir", QDir::home().absolutePath()).toString();
+    
+    QString file = QFileDialog::getSaveFileName(this, tr("Select a capture file"),
+                                                lastDir, tr("Capture (*.capture)"));
+    
+    if(file.isNull())
+        return;
+    
+    try
+    {
+        m_model->startCapture(file);
+    }
+    catch(WriteCaptureFailed& e)
+    {
+        QMessageBox::critical(this, tr("Failed to start capture"), e.what(),
+                              QMessageBox::Ok, QMessageBox::Ok);
+        return;
+    }
+    
+    settings.setValue("lastCaptureDir", QFileInfo(file).absoluteDir().absolutePath());
+    
+    m_startCaptureAct->setEnabled(false);
+    m_stopCaptureAct->setEnabled(true);
+    statusBar()->showMessage(tr("Capturing to %1").arg(file));
+}
+
+void MainWindow::stopCapture()
+{
+    if(m_model->isCapturing())
+    {
+        QString error = m_model->captureWriter()->errorString();
+        quint64 numDroppedFrames = m_model->captureWriter()->numDroppedFrames();
+        m_model->stopCapture();
+        
+        if(! error.isEmpty())
+            statusBar()->showMessage(tr("Capture failed: %1").arg(error));
+        else if(numDroppedFrames > 0)
+            statusBar()->showMessage(tr("Capture stopped, %1 frames were dropped").arg(numDroppedFrames));
+        else
+            statusBar()->showMessage(tr("Capture stopped"));
+    }
+    
+    m_startCaptureAct->setEnabled(true);
+    m_stopCaptureAct->setEnabled(false);
+}
+
+void MainWindow::replayCapture()
+{
+    QSettings settings("stromx", "stromx-studio");
+    QString lastDir = settings.value("lastCaptureDir", QDir::home().absolutePath()).toString();
+    
+    QString file = QFileDialog::getOpenFileName(this, tr("Select a capture file to replay"),
+                                                lastDir, tr("Capture (*.capture)"));
+    
+    if(file.isNull())
+        return;
+    
+    QStringList modes;
+    modes << tr("Observers at original rate") << tr("Observers at maximal rate")
+          << tr("Operator inputs at original rate") << tr("Operator inputs at maximal rate");
+    bool ok = false;
+    QString mode = QInputDialog::getItem(this, tr("Replay capture"), tr("Replay the captured data to:"),
+                                         modes, 0, false, &ok);
+    if(! ok)
+        return;
+    
+    stopReplay();
+    
+    try
+    {
+        m_capturePlayer = new CapturePlayer(file, m_model, this);
+    }
+    catch(ReadCaptureFailed& e)
+    {
+        QMessageBox::critical(this, tr("Failed to replay capture"), e.what(),
+                              QMessageBox::Ok, QMessageBox::Ok);
+        return;
+    }
+    
+    settings.setValue("lastCaptureDir", QFileInfo(file).absoluteDir().absolutePath());
+    
+    int modeIndex = modes.indexOf(mode);
+    m_capturePlayer->setTarget(modeIndex < 2 ? CapturePlayer::OBSERVERS : CapturePlayer::OPERATORS);
+    m_capturePlayer->setMaximalRate(modeIndex % 2 == 1);
+    connect(m_capturePlayer, SIGNAL(finished()), this, SLOT(finishReplay()));
+    connect(m_capturePlayer, SIGNAL(replayFailed(QString)), this, SLOT(handleReplayFailure(QString)));
+    
+    if(m_capturePlayer->numMissingChannels() > 0)
+    {
+        statusBar()->showMessage(tr("%1 captured inputs are not part of the current stream")
+                                 .arg(m_capturePlayer->numMissingChannels()));
+    }
+    
+    m_replayCaptureAct->setEnabled(false);
+    m_stopReplayAct->setEnabled(true);
+    m_capturePlayer->start();
+}
+
+void MainWindow::stopReplay()
+{
+    if(m_capturePlayer)
+    {
+        // deleting the player waits for the player thread
+        m_capturePlayer->disconnect(this);
+        delete m_capturePlayer;
+        m_capturePlayer = 0;
+    }
+    
+    m_replayCaptureAct->setEnabled(true);
+    m_stopReplayAct->setEnabled(false);
+}
+
+void MainWindow::finishReplay()
+{
+    if(m_capturePlayer)
+    {
+        m_capturePlayer->deleteLater();
+        m_capturePlayer = 0;
+    }
+    
+    statusBar()->showMessage(tr("Replay finished"));
+    m_replayCaptureAct->setEnabled(true);
+    m_stopReplayAct->setEnabled(false);
+}
+
+void MainWindow::handleReplayFailure(const QString& message)
+{
+    QMessageBox::warning(this, tr("Replay failed"), message, QMessageBox::Ok, QMessageBox::Ok);
+}
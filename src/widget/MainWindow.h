@@ -34,22 +34,29 @@ namespace stromx
 {
     namespace runtime
     { 
-        class FileInput;
         class FileOutput;
     }
 }
 
 class QAction;
+class QLockFile;
 class QMenu;
+class QProgressDialog;
+class QTimer;
+class CapturePlayer;
 class DocumentationWindow;
+class ErrorListModel;
 class ErrorListView;
 class FindPackagesDialog;
 class LimitUndoStack;
+class MemoryFileOutput;
 class ObserverTreeView;
 class ObserverModel;
 class ObserverWindow;
 class OperatorLibraryView;
 class PropertyView;
+class ReadStreamTask;
+class WriteStreamTask;
 class SettingsDialog;
 class StreamEditor;
 class StreamModel;
@@ -72,6 +79,13 @@ public slots:
     /** Displays a window with packages found on the system. */
     void findPackages();
     
+    /** 
+     * Offers to recover the stream of a previous session if stromx-studio was
+     * not closed properly. Recovery files of instances which are still running
+     * are ignored.
+     */
+    void recover();
+    
 protected:
     virtual void closeEvent(QCloseEvent* event);
     virtual void customEvent(QEvent* event);
@@ -123,6 +137,9 @@ private slots:
     /** Sets all actions to active and/or inactive to reflect the fact that the stream has stopped */
     void join();
     
+    /** Enables the pause action when the stream has been started in the background. */
+    void finishStart();
+    
     /** 
      * Update the window title such that it shows the current file name and reflects the current
      * state of the undo stack.
@@ -135,6 +152,12 @@ private slots:
      */ 
     void setSlowProcessing(bool isSlow);
     
+    /** 
+     * Enables or disables the detection of hung operators. If the detection
+     * is disabled the operators do not record their connector activity.
+     */
+    void setWatchdogEnabled(bool enabled);
+    
     /** Clears the list of recently opened files. */
     void emptyRecentFiles();
     
@@ -155,17 +178,119 @@ private slots:
      * whether the stream should be stopped.
      */
     void handleAccessTimeout();
+    
+    /** 
+     * Displays a save file dialog and starts capturing the data at all observed
+     * inputs to the selected file.
+     */
+    void startCapture();
+    
+    /** Stops the current capture. */
+    void stopCapture();
+    
+    /** 
+     * Displays an open file dialog and replays the selected capture file either
+     * to the observers or the operators of the current stream.
+     */
+    void replayCapture();
+    
+    /** Stops the current replay. */
+    void stopReplay();
+    
+    /** Deletes the capture player and updates the capture actions. */
+    void finishReplay();
+    
+    /** Informs the user that the replay failed because of \c message. */
+    void handleReplayFailure(const QString & message);
+    
+    /** Displays the current \c stage of the file which is being read. */
+    void updateReadProgress(int stage);
+    
+    /** 
+     * Replaces the current stream by the one read by the current read stream
+     * task. If the stream could not be read an error message is displayed.
+     */
+    void finishReadFile();
+    
+    /** 
+     * Marks the stream as saved if the current write stream task was successful.
+     * Otherwise an error message is displayed.
+     */
+    void finishWriteFile();
+    
+    /** Remembers that the stream must be saved at the next autosave. */
+    void requestAutosave();
+    
+    /** 
+     * Writes a snapshot of the current stream to the recovery file in the 
+     * background. Does nothing if the stream did not change since the last
+     * autosave.
+     */
+    void autosave();
+    
+    /** Displays an error message if the current autosave failed. */
+    void finishAutosave();
+    
+    /** Asks the user for the autosave interval and applies it. */
+    void editAutosaveInterval();
+    
+    /** Asks the user for the memory budget of the undo stack and applies it. */
+    void editUndoMemoryBudget();
+    
+    /** 
+     * Constructs the error list view when the error dock widget becomes
+     * \c visible for the first time.
+     */
+    void createErrorListView(bool visible);
 
 private:
     enum
     { 
         /** The maximal number of recently opened files remembered. */
-        MAX_RECENT_FILES = 10
+        MAX_RECENT_FILES = 10,
+        
+        /** The time in milliseconds before the progress of reading a file is displayed. */
+        READ_PROGRESS_DELAY = 500,
+        
+        /** The time in milliseconds before the progress of starting the stream is displayed. */
+        START_PROGRESS_DELAY = 500,
+        
+        /** The time in milliseconds the message about a saved file is displayed. */
+        SAVED_MESSAGE_TIMEOUT = 5000,
+        
+        /** The default autosave interval in minutes. */
+        DEFAULT_AUTOSAVE_INTERVAL = 2,
+        
+        /** The maximal autosave interval in minutes. */
+        MAX_AUTOSAVE_INTERVAL = 1440,
+        
+        /** The number of bytes in a megabyte. */
+        MEGABYTE = 1024 * 1024
     };
     
+    /** The sections of window state files. */
+    enum WindowStatesSection
+    {
+        STREAM_VIEW_SECTION = 1,
+        DOCUMENTATION_WINDOW_SECTION = 2,
+        OBSERVER_WINDOW_SECTION = 3
+    };
+    
+    /** 
+     * Magic number which identifies the first 4 bytes of window state files.
+     * Files written by earlier versions do not start with a magic number.
+     */
+    static const quint32 WINDOW_STATES_MAGIC_NUMBER;
+    
+    /** The version of the window state file format. */
+    static const quint32 WINDOW_STATES_VERSION;
+    
     /** Strips the path from the input file path. */
     static QString strippedName(const QString &fullFileName);
     
+    /** Returns the basename of the stream description in the file at \c filepath. */
+    static QString streamBasename(const QString & filepath);
+    
     /** Creates the actions of the main window. */
     void createActions();
     
@@ -193,15 +318,58 @@ private:
     void writeSettings();
     
     /** 
-     * Writes the currently opened file to file at \c filepath.
-     * Returns true if the file was successfully written and false otherwise.
+     * Takes a snapshot of the currently opened stream and starts writing it to
+     * the file at \c filepath in the background. Returns true if the snapshot
+     * was successfully taken and false otherwise. The stream is marked as saved
+     * by finishWriteFile().
      */
     bool writeFile(const QString & filepath);
     
+    /** Blocks until the current write stream tasks (including autosaves) have finished. */
+    void waitForWriteFile();
+    
+    /** 
+     * Writes the current stream and the window states to a new memory file output.
+     * This happens on the GUI thread because the stream must not change while it
+     * is serialized. Only the compression, the copying of deferred parameters and
+     * the disk access are left to the write stream task.
+     * 
+     * \throws WriteStreamFailed
+     */
+    MemoryFileOutput* takeSnapshot(const QString & basename) const;
+    
     /** 
-     * Opens the file at \c filepath and reads a stream from it. If successful 
-     * it replaces the currently displayed stream by the new one and returns true.
-     * Returns false if the stream could not be read.
+     * Returns the path of the file which is written by autosave(). Each running
+     * instance of stromx-studio writes its own recovery file.
+     */
+    static QString recoveryFile();
+    
+    /** 
+     * Returns the recovery file of an instance of stromx-studio which is not
+     * running anymore. Returns an empty string if there is no such file.
+     */
+    static QString abandonedRecoveryFile();
+    
+    /** Returns the settings key of the original file of \c recoveryFile. */
+    static QString recoveryOriginalFileKey(const QString & recoveryFile);
+    
+    /** 
+     * Returns true if the current stream contains changes which have not 
+     * been saved.
+     */
+    bool isModified() const;
+    
+    /** Removes the recovery file. */
+    void discardRecovery();
+    
+    /** Starts autosaving every \c minutes. Autosave is disabled if \c minutes is 0. */
+    void setAutosaveInterval(int minutes);
+    
+    /** 
+     * Starts reading a stream from the file at \c filepath on a worker thread
+     * and displays the progress. Returns false if the file type is unknown or 
+     * if another file is being read. Otherwise returns true and replaces the 
+     * currently displayed stream by the new one as soon as the file was read.
      */
     bool readFile(const QString & filepath);
     
@@ -220,18 +388,26 @@ private:
     /** Saves the geometry and view properties of the stream scene and the observer windows. */
     void writeWindowStates(stromx::runtime::FileOutput & output, const QString & basename) const;
     
-    /** Reads and geometry and view properties of the stream scene and the observer windows. */
-    void readWindowStates(stromx::runtime::FileInput & input, const QString & basename);
+    /** 
+     * Reads and geometry and view properties of the stream scene and the observer windows
+     * from the content of a \c *.studio.geometry file.
+     */
+    void readWindowStates(const QByteArray & windowStates);
+    
+    /** Reads window states which were written by earlier versions without magic number. */
+    void readWindowStatesVersion0(const QByteArray & windowStates);
     
     QAction* m_openAct;
     QAction* m_saveAct;
     QAction* m_saveAsAct;
     QAction* m_closeAct;
+    QAction* m_autosaveIntervalAct;
     QAction* m_loadPackagesAct;
     QAction* m_resetPackagesAct;
     QAction* m_findPackagesAct;
     QAction* m_undoAct;
     QAction* m_redoAct;
+    QAction* m_undoMemoryBudgetAct;
     QAction* m_quitAct;
     QAction* m_aboutAct;
     QAction* m_aboutQtAct;
@@ -250,6 +426,7 @@ private:
     QAction* m_removeInputAct;
     QAction* m_observerSeparatorAct;
     QAction* m_slowAction;
+    QAction* m_watchdogAct;
     QAction* m_emptyRecentFilesAct;
     QAction* m_viewMenuSeparatorAct;
     QAction* m_showOperatorLibraryAct;
@@ -258,6 +435,10 @@ private:
     QAction* m_showErrorListViewAct;
     QAction* m_resetZoomAct;
     QAction* m_showSettingsAct;
+    QAction* m_startCaptureAct;
+    QAction* m_stopCaptureAct;
+    QAction* m_replayCaptureAct;
+    QAction* m_stopReplayAct;
     
     LimitUndoStack* m_undoStack;
     
@@ -280,6 +461,7 @@ private:
     OperatorLibraryView* m_operatorLibraryView;
     PropertyView* m_propertyView;
     ErrorListView* m_errorListView;
+    ErrorListModel* m_errorListModel;
     
     StreamModel* m_model;
      
@@ -289,6 +471,18 @@ private:
     DocumentationWindow* m_docWindow;
     SettingsDialog* m_settingsDialog;
     FindPackagesDialog* m_findPackagesDialog;
+    CapturePlayer* m_capturePlayer;
+    ReadStreamTask* m_readStreamTask;
+    QProgressDialog* m_readProgressDialog;
+    QProgressDialog* m_startProgressDialog;
+    WriteStreamTask* m_writeStreamTask;
+    WriteStreamTask* m_autosaveTask;
+    QTimer* m_autosaveTimer;
+    bool m_autosaveRequired;
+    bool m_unsavedRecovery;
+#ifndef STROMX_STUDIO_QT4
+    QLockFile* m_recoveryLock;
+#endif
 };
 
 #endif // MAINWINDOW_H
@@ -1,87 +1,31 @@
 #include "widget/MatrixEditor.h"
 
-#include <QTableWidget>
-#include <QPushButton>
-#include <QHBoxLayout>
-#include <QVBoxLayout>
+#include <QApplication>
+#include <QClipboard>
 #include <QFormLayout>
+#include <QHBoxLayout>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QPushButton>
 #include <QSpinBox>
-
-namespace
-{
-    template <class T>
-    T valueAt(const stromx::runtime::Matrix & matrix, const int i, const int j)
-    {
-        switch(matrix.valueType())
-        {
-        case stromx::runtime::Matrix::INT_8:
-            return matrix.at<int8_t>(i, j);
-        case stromx::runtime::Matrix::UINT_8:
-            return matrix.at<uint8_t>(i, j);
-        case stromx::runtime::Matrix::INT_16:
-            return matrix.at<int16_t>(i, j);
-        case stromx::runtime::Matrix::UINT_16:
-            return matrix.at<uint16_t>(i, j);
-        case stromx::runtime::Matrix::INT_32:
-            return matrix.at<int32_t>(i, j);
-        case stromx::runtime::Matrix::UINT_32:
-            return matrix.at<uint32_t>(i, j);
-        case stromx::runtime::Matrix::FLOAT_32:
-            return matrix.at<float>(i, j);
-        case stromx::runtime::Matrix::FLOAT_64:
-            return matrix.at<double>(i, j);
-        case stromx::runtime::Matrix::NONE:
-            return 0.0;
-        }
-        
-        return 0.0;
-    }
-    
-    template <class T>
-    void setValueAt(stromx::runtime::Matrix & matrix,
-                    const int i, const int j, const T value)
-    {
-        switch(matrix.valueType())
-        {
-        case stromx::runtime::Matrix::INT_8:
-            matrix.at<int8_t>(i, j) = value;
-            break;
-        case stromx::runtime::Matrix::UINT_8:
-            matrix.at<uint8_t>(i, j) = value;
-            break;
-        case stromx::runtime::Matrix::INT_16:
-            matrix.at<int16_t>(i, j) = value;
-            break;
-        case stromx::runtime::Matrix::UINT_16:
-            matrix.at<uint16_t>(i, j) = value;
-            break;
-        case stromx::runtime::Matrix::INT_32:
-            matrix.at<int32_t>(i, j) = value;
-            break;
-        case stromx::runtime::Matrix::UINT_32:
-            matrix.at<uint32_t>(i, j) = value;
-            break;
-        case stromx::runtime::Matrix::FLOAT_32:
-            matrix.at<float>(i, j) = value;
-            break;
-        case stromx::runtime::Matrix::FLOAT_64:
-            matrix.at<double>(i, j) = value;
-            break;
-        default:
-            ;
-        }
-    }
-}
+#include <QTableView>
+#include <QVBoxLayout>
+#include <cfloat>
+#include <climits>
+#include "model/MatrixModel.h"
 
 MatrixEditor::MatrixEditor(const Matrix& matrix, const int rows, const int cols, QWidget* parent)
   : QDialog(parent),
-    m_matrix(matrix),
+    m_model(0),
     m_table(0)
 {
+    m_model = new MatrixModel(matrix, this);
+    
     QFormLayout* dimensions = new QFormLayout();
     
     QSpinBox* rowsSpinBox = new QSpinBox();
     rowsSpinBox->setMinimum(0);
+    rowsSpinBox->setMaximum(INT_MAX);
     rowsSpinBox->setValue(matrix.rows());
     rowsSpinBox->setEnabled(rows == 0);
     rowsSpinBox->setSingleStep(1);
@@ -90,16 +34,28 @@ MatrixEditor::MatrixEditor(const Matrix& matrix, const int rows, const int cols,
     
     QSpinBox* colsSpinBox = new QSpinBox();
     colsSpinBox->setMinimum(0);
+    colsSpinBox->setMaximum(INT_MAX);
     colsSpinBox->setValue(matrix.cols());
     colsSpinBox->setEnabled(cols == 0);
     colsSpinBox->setSingleStep(1);
     connect(colsSpinBox, SIGNAL(valueChanged(int)), SLOT(handleColsChanged(int)));
     dimensions->addRow(tr("Columns:"), colsSpinBox);
     
-    m_table = new QTableWidget(this);
-    fillTable();
-    connect(m_table, SIGNAL(itemChanged(QTableWidgetItem*)),
-            this, SLOT(checkItemContent(QTableWidgetItem*)));
+    m_table = new QTableView(this);
+    m_table->setModel(m_model);
+    
+    QPushButton* fillButton = new QPushButton(tr("Fill..."), this);
+    QPushButton* scaleButton = new QPushButton(tr("Scale..."), this);
+    QPushButton* pasteButton = new QPushButton(tr("Paste"), this);
+    connect(fillButton, SIGNAL(clicked(bool)), this, SLOT(fill()));
+    connect(scaleButton, SIGNAL(clicked(bool)), this, SLOT(scale()));
+    connect(pasteButton, SIGNAL(clicked(bool)), this, SLOT(paste()));
+    
+    QHBoxLayout* operations = new QHBoxLayout();
+    operations->addWidget(fillButton);
+    operations->addWidget(scaleButton);
+    operations->addWidget(pasteButton);
+    operations->addStretch();
     
     QPushButton* okButton = new QPushButton(tr("Ok"), this);
     QPushButton* cancelButton = new QPushButton(tr("Cancel"), this);
@@ -110,6 +66,7 @@ MatrixEditor::MatrixEditor(const Matrix& matrix, const int rows, const int cols,
     
     QVBoxLayout* main = new QVBoxLayout();
     main->addLayout(dimensions);
+    main->addLayout(operations);
     main->addWidget(m_table);
     
     QHBoxLayout* buttons = new QHBoxLayout();
@@ -118,76 +75,59 @@ MatrixEditor::MatrixEditor(const Matrix& matrix, const int rows, const int cols,
     main->addLayout(buttons);
     
     setLayout(main);
-    
-    connect(this, SIGNAL(accepted()), this, SLOT(readTable()));
 }
 
-void MatrixEditor::fillTable()
+const Matrix& MatrixEditor::matrix() const
 {
-    m_table->setRowCount(m_matrix.rows());
-    m_table->setColumnCount(m_matrix.cols());
-    
-    for (unsigned int i = 0; i < m_matrix.rows(); ++i)
-    {
-        for (unsigned int j = 0; j < m_matrix.cols(); ++j)
-        {
-            double value = valueAt<double>(m_matrix, i, j);
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(value));
-            m_table->setItem(i, j, item);
-        }
-    }   
-}
-
-void MatrixEditor::readTable()
-{
-    m_matrix.resize(m_table->rowCount(), m_table->columnCount(), m_matrix.valueType());
-    
-    for (unsigned int i = 0; i < m_matrix.rows(); ++i)
-    {
-        for (unsigned int j = 0; j < m_matrix.cols(); ++j)
-        {
-            QVariant data = m_table->item(i, j)->data(Qt::EditRole);
-            setValueAt(m_matrix, i, j, data.toDouble());
-        }
-    }  
+    return m_model->matrix();
 }
 
 void MatrixEditor::handleRowsChanged(const int rows)
 {
-    int prevRows = m_table->rowCount();
-    m_table->setRowCount(rows);
-    
-    for (int i = prevRows; i < rows; ++i)
+    // restore the current number of rows if the matrix would be too large
+    if(! m_model->resize(rows, m_model->columnCount()))
     {
-        for (int j = 0; j < m_table->columnCount(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("0"));
-            m_table->setItem(i, j, item);
-        }
+        QSpinBox* spinBox = qobject_cast<QSpinBox*>(sender());
+        if(spinBox)
+            spinBox->setValue(m_model->rowCount());
     }
 }
 
 void MatrixEditor::handleColsChanged(const int cols)
 {
-    int prevCols = m_table->columnCount();
-    m_table->setColumnCount(cols);
-    
-    for (int i = 0; i < m_table->rowCount(); ++i)
+    // restore the current number of columns if the matrix would be too large
+    if(! m_model->resize(m_model->rowCount(), cols))
     {
-        for (int j = prevCols; j < cols; ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("0"));
-            m_table->setItem(i, j, item);
-        }
+        QSpinBox* spinBox = qobject_cast<QSpinBox*>(sender());
+        if(spinBox)
+            spinBox->setValue(m_model->columnCount());
     }
 }
 
-void MatrixEditor::checkItemContent(QTableWidgetItem* item)
+void MatrixEditor::fill()
 {
-    QVariant data = item->data(Qt::EditRole);
-    
-    item->setData(Qt::EditRole, data.toDouble());
-    item->setData(Qt::DisplayRole, data.toDouble());
+    bool ok = false;
+    double value = QInputDialog::getDouble(this, tr("Fill matrix"), tr("Value:"), 0.0,
+                                           -DBL_MAX, DBL_MAX, 6, &ok);
+    if(ok)
+        m_model->fill(value);
 }
 
+void MatrixEditor::scale()
+{
+    bool ok = false;
+    double factor = QInputDialog::getDouble(this, tr("Scale matrix"), tr("Factor:"), 1.0,
+                                            -DBL_MAX, DBL_MAX, 6, &ok);
+    if(ok)
+        m_model->scale(factor);
+}
 
+void MatrixEditor::paste()
+{
+    QString text = QApplication::clipboard()->text();
+    if(! m_model->paste(text, m_table->currentIndex()))
+    {
+        QMessageBox::warning(this, tr("Paste values"),
+                             tr("The clipboard does not contain a table of numbers."));
+    }
+}
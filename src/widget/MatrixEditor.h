@@ -24,9 +24,17 @@
 
 #include "Matrix.h"
 
-class QTableWidget;
-class QTableWidgetItem;
+class QTableView;
+class MatrixModel;
 
+/** 
+ * \brief Dialog to edit the values of a matrix.
+ *
+ * The values are displayed in a table view of a matrix model, i.e. only the
+ * visible values are formatted. In addition to editing single values the
+ * dialog provides operations which fill, scale or paste the values of the
+ * whole matrix.
+ */
 class MatrixEditor : public QDialog
 {   
     Q_OBJECT
@@ -35,18 +43,18 @@ public:
     explicit MatrixEditor(const Matrix& matrix, const int rows,
                           const int cols, QWidget* parent = 0);
     
-    const Matrix & matrix() const { return m_matrix; }
+    const Matrix & matrix() const;
     
 private slots:
     void handleRowsChanged(const int rows);
     void handleColsChanged(const int cols);
-    void fillTable();
-    void readTable();
-    void checkItemContent(QTableWidgetItem* item);
+    void fill();
+    void scale();
+    void paste();
     
 private:
-    Matrix m_matrix;
-    QTableWidget* m_table;
+    MatrixModel* m_model;
+    QTableView* m_table;
 };
 
 #endif // MATRIXEDITOR_H
\ No newline at end of file
@@ -2,26 +2,42 @@
 
 #include <QAction>
 #include <QDockWidget>
+#include <QInputDialog>
 #include <QMenuBar>
+#include <QSlider>
+#include <QToolBar>
 #include "DataManager.h"
+#include "DataRouter.h"
+#include "FrameHistory.h"
 #include "LimitUndoStack.h"
 #include "model/ObserverModel.h"
 #include "model/ObserverTreeModel.h"
+#include "model/StreamModel.h"
 #include "widget/DataVisualizer.h"
 #include "widget/ObserverView.h"
 
 ObserverWindow::ObserverWindow(ObserverModel* observer, LimitUndoStack* undoStack, QWidget* parent) 
   : QMainWindow(parent, Qt::Window),
+    m_observer(observer),
     m_observerView(0),
     m_showAct(0),
     m_visualizer(0),
     m_undoAct(0),
     m_redoAct(0),
     m_resetZoomAct(0),
+    m_synchronizeAct(0),
+    m_maxLatencyAct(0),
+    m_liveAct(0),
+    m_recordHistoryAct(0),
+    m_clearHistoryAct(0),
+    m_historySizeAct(0),
+    m_historySlider(0),
+    m_dataManager(0),
     m_undoStack(undoStack)
 {
     // place the visualizer in the window center
     m_visualizer = new DataVisualizer();
+    m_visualizer->setRenderCache(observer->parentModel()->streamModel()->dataRouter()->renderCache());
     setCentralWidget(m_visualizer);
     
     // create the list of observers as dock widget
@@ -32,9 +48,14 @@ ObserverWindow::ObserverWindow(ObserverModel* observer, LimitUndoStack* undoStac
     inputWidget->setFeatures(QDockWidget::NoDockWidgetFeatures);
     addDockWidget(Qt::BottomDockWidgetArea, inputWidget);
     
-    // create the actions and the menus
+    // allocate the data manager
+    m_dataManager = new DataManager(observer, m_visualizer, this);
+    connect(m_dataManager, SIGNAL(dataAccessTimedOut()), observer->parentModel()->streamModel(), SIGNAL(accessTimedOut()));
+    
+    // create the actions, the menus and the history slider
     createActions();
     createMenus();
+    createHistoryToolBar();
     
     m_showAct = new QAction(observer->name(), this);
     m_showAct->setStatusTip(tr("Open the observer window"));
@@ -45,10 +66,6 @@ ObserverWindow::ObserverWindow(ObserverModel* observer, LimitUndoStack* undoStac
     connect(observer, SIGNAL(nameChanged(QString)), this, SLOT(updateWindowTitle(QString)));
     
     setWindowTitle(observer->name());
-    
-    // allocate the data manager
-    DataManager* dataManager = new DataManager(observer, m_visualizer, this);
-    connect(dataManager, SIGNAL(dataAccessTimedOut()), observer->parentModel()->streamModel(), SIGNAL(accessTimedOut()));
 }
 
 void ObserverWindow::createActions()
@@ -59,6 +76,37 @@ void ObserverWindow::createActions()
     m_redoAct->setShortcuts(QKeySequence::Redo);
 
     m_resetZoomAct = m_visualizer->createResetZoomAction(this);
+    
+    m_synchronizeAct = new QAction(tr("Synchronize layers"), this);
+    m_synchronizeAct->setStatusTip(tr("Display only data of the same stream iteration together"));
+    m_synchronizeAct->setCheckable(true);
+    m_synchronizeAct->setChecked(m_observer->isSynchronized());
+    connect(m_synchronizeAct, SIGNAL(toggled(bool)), m_observer, SLOT(setSynchronized(bool)));
+    connect(m_observer, SIGNAL(synchronizedChanged(bool)), m_synchronizeAct, SLOT(setChecked(bool)));
+    
+    m_maxLatencyAct = new QAction(tr("Maximal latency..."), this);
+    m_maxLatencyAct->setStatusTip(tr("Set the maximal time synchronized layers wait for each other"));
+    connect(m_maxLatencyAct, SIGNAL(triggered()), this, SLOT(editMaxLatency()));
+    
+    m_liveAct = new QAction(tr("Live"), this);
+    m_liveAct->setStatusTip(tr("Display the observed data as it arrives"));
+    m_liveAct->setCheckable(true);
+    m_liveAct->setChecked(true);
+    connect(m_liveAct, SIGNAL(toggled(bool)), this, SLOT(setLive(bool)));
+    
+    m_recordHistoryAct = new QAction(tr("Record history"), this);
+    m_recordHistoryAct->setStatusTip(tr("Keep the most recent observed data in a history"));
+    m_recordHistoryAct->setCheckable(true);
+    m_recordHistoryAct->setChecked(m_observer->history()->isRecording());
+    connect(m_recordHistoryAct, SIGNAL(toggled(bool)), m_observer->history(), SLOT(setRecording(bool)));
+    
+    m_clearHistoryAct = new QAction(tr("Clear history"), this);
+    m_clearHistoryAct->setStatusTip(tr("Remove all data from the history"));
+    connect(m_clearHistoryAct, SIGNAL(triggered()), m_observer->history(), SLOT(clear()));
+    
+    m_historySizeAct = new QAction(tr("History size..."), this);
+    m_historySizeAct->setStatusTip(tr("Set the number of frames and the memory used by the history"));
+    connect(m_historySizeAct, SIGNAL(triggered()), this, SLOT(editHistorySize()));
 }
 
 void ObserverWindow::createMenus()
@@ -69,6 +117,85 @@ void ObserverWindow::createMenus()
 
     QMenu* viewMenu = menuBar()->addMenu(tr("&View"));
     viewMenu->addAction(m_resetZoomAct);
+    viewMenu->addSeparator();
+    viewMenu->addAction(m_synchronizeAct);
+    viewMenu->addAction(m_maxLatencyAct);
+    viewMenu->addSeparator();
+    viewMenu->addAction(m_liveAct);
+    viewMenu->addAction(m_recordHistoryAct);
+    viewMenu->addAction(m_clearHistoryAct);
+    viewMenu->addAction(m_historySizeAct);
+}
+
+void ObserverWindow::createHistoryToolBar()
+{
+    m_historySlider = new QSlider(Qt::Horizontal);
+    m_historySlider->setStatusTip(tr("Step back through the history of the observed data"));
+    connect(m_historySlider, SIGNAL(valueChanged(int)), this, SLOT(scrubHistory(int)));
+    
+    QToolBar* historyBar = new QToolBar(tr("History"));
+    historyBar->setObjectName("HistoryToolBar");
+    historyBar->addAction(m_liveAct);
+    historyBar->addWidget(m_historySlider);
+    addToolBar(Qt::BottomToolBarArea, historyBar);
+    
+    connect(m_observer->history(), SIGNAL(numFramesChanged(int)), this, SLOT(updateHistoryRange(int)));
+    updateHistoryRange(m_observer->history()->numFrames());
+}
+
+void ObserverWindow::scrubHistory(int position)
+{
+    m_liveAct->setChecked(false);
+    m_dataManager->showHistory(position);
+}
+
+void ObserverWindow::setLive(bool live)
+{
+    m_dataManager->setLive(live);
+    
+    if(live)
+        updateHistoryRange(m_observer->history()->numFrames());
+}
+
+void ObserverWindow::updateHistoryRange(int numFrames)
+{
+    // changing the slider programmatically must not display the history
+    m_historySlider->blockSignals(true);
+    m_historySlider->setRange(0, numFrames > 0 ? numFrames - 1 : 0);
+    if(m_dataManager->isLive())
+        m_historySlider->setValue(m_historySlider->maximum());
+    m_historySlider->blockSignals(false);
+}
+
+void ObserverWindow::editHistorySize()
+{
+    FrameHistory* history = m_observer->history();
+    
+    bool ok = false;
+    int frames = QInputDialog::getInt(this, tr("History size"),
+                                      tr("Maximal number of frames per input:"),
+                                      history->maxFramesPerInput(), 0, 100000, 1, &ok);
+    if(! ok)
+        return;
+    
+    const int MEGABYTE = 1024 * 1024;
+    int budget = QInputDialog::getInt(this, tr("History size"),
+                                      tr("Maximal memory of the history (MB):"),
+                                      static_cast<int>(history->memoryBudget() / MEGABYTE), 0, 1000000, 16, &ok);
+    if(! ok)
+        return;
+    
+    m_observer->setHistorySize(frames, static_cast<qint64>(budget) * MEGABYTE);
+}
+
+void ObserverWindow::editMaxLatency()
+{
+    bool ok = false;
+    int latency = QInputDialog::getInt(this, tr("Maximal latency"),
+                                       tr("Maximal latency of synchronized layers (ms):"),
+                                       m_observer->maxLatency(), 0, 60000, 10, &ok);
+    if(ok)
+        m_observer->setMaxLatency(latency);
 }
 
 void ObserverWindow::updateWindowTitle(const QString& name)
@@ -22,6 +22,8 @@
 
 #include <QMainWindow>
 
+class QSlider;
+class DataManager;
 class LimitUndoStack;
 class DataVisualizer;
 class ObserverModel;
@@ -64,13 +66,47 @@ private slots:
     /** Creates and populates the menus of the observer window. */
     void createMenus();
     
+    /** Opens a dialog to edit the maximal latency of synchronized layers. */
+    void editMaxLatency();
+    
+    /** Opens dialogs to edit the size of the frame history. */
+    void editHistorySize();
+    
+    /** 
+     * Displays the frames at \c position of the history and stops displaying
+     * new data.
+     */
+    void scrubHistory(int position);
+    
+    /** 
+     * Starts or stops displaying new data. When going live the history slider
+     * is moved to the newest frame.
+     */
+    void setLive(bool live);
+    
+    /** Adapts the range of the history slider to the \c numFrames in the history. */
+    void updateHistoryRange(int numFrames);
+    
+private:
+    /** Creates the tool bar with the history slider. */
+    void createHistoryToolBar();
+    
 private:
+    ObserverModel* m_observer;
     ObserverView* m_observerView;
     QAction* m_showAct;
     DataVisualizer* m_visualizer;
     QAction* m_undoAct;
     QAction* m_redoAct;
     QAction* m_resetZoomAct;
+    QAction* m_synchronizeAct;
+    QAction* m_maxLatencyAct;
+    QAction* m_liveAct;
+    QAction* m_recordHistoryAct;
+    QAction* m_clearHistoryAct;
+    QAction* m_historySizeAct;
+    QSlider* m_historySlider;
+    DataManager* m_dataManager;
     LimitUndoStack* m_undoStack;
 };
 
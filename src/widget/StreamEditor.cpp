@@ -27,6 +27,11 @@ StreamEditor::StreamEditor(QWidget* parent)
     setAcceptDrops(true);
     setDragMode(QGraphicsView::RubberBandDrag);
     setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+    
+    // repaint the bounding rectangle of the changed items instead of each
+    // item separately, i.e. only visible items are drawn
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+    connect(this, SIGNAL(scaleChanged(qreal)), m_scene, SLOT(setScale(qreal)));
 }
 
 void StreamEditor::mouseMoveEvent(QMouseEvent* event)
@@ -40,6 +40,7 @@ void ThreadListView::setStreamModel(StreamModel* model)
     
     connect(selectionModel(), SIGNAL(currentRowChanged(QModelIndex,QModelIndex)), 
             this, SLOT(updateThreadSelected(QModelIndex,QModelIndex)));
+    connect(m_model, SIGNAL(streamStarting()), this, SLOT(updateStreamActive()));
     connect(m_model, SIGNAL(streamStarted()), this, SLOT(updateStreamActive()));
     connect(m_model, SIGNAL(streamJoined()), this, SLOT(updateStreamActive()));
 }